@@ -0,0 +1,65 @@
+#pragma once
+
+#include <sys/resource.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <utils/timer.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Base fixture for benchmarks. Benchmarks are regular gtest cases that time a body of work and
+ * print their results through `report`, so they can be filtered and run like tests.
+ */
+class Benchmark : public ::testing::Test {
+ protected:
+  /**
+   * @brief Runs `body` `iterations` times and returns the mean time per iteration in nanoseconds.
+   */
+  template<typename Body>
+  static double nanosPerIteration(const uint64_t iterations, Body body)
+  {
+    utils::Timer timer;
+    timer.start();
+    for (uint64_t i = 0; i < iterations; ++i) {
+      body(i);
+    }
+    timer.stop();
+    return static_cast<double>(timer.getMicros()) * 1000.0 / static_cast<double>(iterations);
+  }
+
+  /**
+   * @brief Returns the CPU time (user and system) consumed by all threads of this process so far.
+   */
+  static double processCpuMillis()
+  {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3
+           + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-3;
+  }
+
+  /**
+   * @brief Prevents the compiler from discarding a value that is computed only to be timed.
+   */
+  template<typename T>
+  static void doNotOptimise(const T &value)
+  {
+    asm volatile("" : : "r"(&value) : "memory");
+  }
+
+  /**
+   * @brief Prints a single result line in a fixed format so outputs can be diffed between runs.
+   */
+  static void report(const std::string &name, const double value, const char *unit)
+  {
+    std::printf("[ BENCH    ] %-56s %14.2f %s\n", name.c_str(), value, unit);
+  }
+};
+
+}  // namespace hyped::benchmarking
@@ -0,0 +1,130 @@
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <data/data.hpp>
+#include <utils/concurrent/lock.hpp>
+#include <utils/concurrent/seqlock.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Reproduces the previous `data::Data` behaviour: every access takes a mutex and copies the whole
+ * substructure.
+ */
+template<typename T>
+class MutexGuarded {
+ public:
+  T load() const
+  {
+    utils::concurrent::ScopedLock L(&lock_);
+    return value_;
+  }
+
+  void store(const T &value)
+  {
+    utils::concurrent::ScopedLock L(&lock_);
+    value_ = value;
+  }
+
+ private:
+  T value_;
+  mutable utils::concurrent::Lock lock_;
+};
+
+class DataBenchmark : public Benchmark {
+ protected:
+  static constexpr size_t kNumReaders       = 3;
+  static constexpr uint64_t kReadsPerReader = 200000;
+
+  /**
+   * @brief One writer stores continuously while `kNumReaders` readers each load
+   *        `kReadsPerReader` times. Reports mean read latency and the rate at which the writer made
+   *        progress while being contended.
+   */
+  template<typename Guard, typename T>
+  static void contend(const std::string &name, const T &initial)
+  {
+    Guard guard;
+    guard.store(initial);
+    std::atomic<bool> reading        = true;
+    std::atomic<uint64_t> num_writes = 0;
+    std::thread writer([&]() {
+      T value = initial;
+      while (reading) {
+        guard.store(value);
+        ++num_writes;
+      }
+    });
+    std::vector<double> nanos(kNumReaders);
+    std::vector<std::thread> readers;
+    utils::Timer timer;
+    timer.start();
+    for (size_t i = 0; i < kNumReaders; ++i) {
+      readers.emplace_back([&, i]() {
+        nanos.at(i) = nanosPerIteration(kReadsPerReader,
+                                        [&](uint64_t) { doNotOptimise(guard.load()); });
+      });
+    }
+    for (auto &reader : readers) {
+      reader.join();
+    }
+    timer.stop();
+    reading = false;
+    writer.join();
+    double total = 0;
+    for (const auto n : nanos) {
+      total += n;
+    }
+    report(name + " read", total / kNumReaders, "ns");
+    report(name + " write rate", static_cast<double>(num_writes) / timer.getMillis(), "writes/ms");
+  }
+
+  template<typename T>
+  static void compare(const std::string &name)
+  {
+    const T initial{};
+    contend<MutexGuarded<T>>(name + " mutex", initial);
+    contend<utils::concurrent::SeqLock<T>>(name + " seqlock", initial);
+  }
+};
+
+TEST_F(DataBenchmark, stateMachine)
+{
+  compare<data::StateMachine>("StateMachine");
+}
+
+TEST_F(DataBenchmark, navigation)
+{
+  compare<data::Navigation>("Navigation");
+}
+
+TEST_F(DataBenchmark, sensors)
+{
+  compare<data::Sensors>("Sensors");
+}
+
+TEST_F(DataBenchmark, motors)
+{
+  compare<data::Motors>("Motors");
+}
+
+TEST_F(DataBenchmark, batteries)
+{
+  compare<data::FullBatteryData>("FullBatteryData");
+}
+
+TEST_F(DataBenchmark, telemetry)
+{
+  compare<data::Telemetry>("Telemetry");
+}
+
+TEST_F(DataBenchmark, brakes)
+{
+  compare<data::Brakes>("Brakes");
+}
+
+}  // namespace hyped::benchmarking
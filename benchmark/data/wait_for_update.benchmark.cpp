@@ -0,0 +1,113 @@
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <brakes/main.hpp>
+#include <data/data.hpp>
+#include <navigation/main.hpp>
+#include <sensors/gpio_manager.hpp>
+#include <state_machine/main.hpp>
+#include <utils/concurrent/thread.hpp>
+#include <utils/system.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Measures how much CPU each loop that sleeps on Data::waitForUpdate burns while nothing in the
+ * central data structure changes. Every loop is the production thread, idling in kIdle.
+ */
+class WaitForUpdateBenchmark : public Benchmark {
+ protected:
+  inline static const std::string kDefaultConfigPath = "configurations/test/default_config.json";
+  inline static const char *kDefaultArgs[2]          = {"mock_binary", kDefaultConfigPath.c_str()};
+  static constexpr uint32_t kMeasurementMillis       = 500;
+
+  void SetUp() { utils::System::parseArgs(2, kDefaultArgs); }
+
+  // stopping a thread stops the whole system, so benchmarks that run after this one would find
+  // every loop exiting straight away; re-parsing constructs a running system again
+  void TearDown() { utils::System::parseArgs(2, kDefaultArgs); }
+
+  static void measureIdle(const std::string &name, utils::concurrent::Thread &thread)
+  {
+    // modules stop the system when they fail to initialise, which would leave nothing to measure
+    ASSERT_TRUE(utils::System::getSystem().isRunning());
+    thread.start();
+    // give the thread time to settle into its steady state
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto cpu_before = processCpuMillis();
+    utils::Timer timer;
+    timer.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(kMeasurementMillis));
+    timer.stop();
+    const auto cpu_after = processCpuMillis();
+    utils::System::getSystem().stop();
+    thread.join();
+    report(name + " idle cpu utilisation", 100.0 * (cpu_after - cpu_before) / timer.getMillis(),
+           "%");
+  }
+};
+
+TEST_F(WaitForUpdateBenchmark, stateMachine)
+{
+  state_machine::Main main;
+  measureIdle("StateMachine", main);
+}
+
+TEST_F(WaitForUpdateBenchmark, navigation)
+{
+  navigation::Main main;
+  measureIdle("Navigation", main);
+}
+
+TEST_F(WaitForUpdateBenchmark, brakes)
+{
+  brakes::Main main;
+  measureIdle("Brakes", main);
+}
+
+TEST_F(WaitForUpdateBenchmark, gpioManager)
+{
+  sensors::GpioManager::Config config;
+  config.master_switch_pin      = 45;
+  config.high_power_ssr_pins[0] = 44;
+  sensors::GpioManager manager(utils::Logger("GPIO-MANAGER", utils::Logger::Level::kNone), config);
+  measureIdle("GpioManager", manager);
+}
+
+// the IMUs are written far more often than anything else, so their setter must stay cheap while
+// the other loops sleep on the substructures they care about
+TEST_F(WaitForUpdateBenchmark, imuWriteWhileOthersWait)
+{
+  static constexpr std::size_t kNumWaiters = 3;
+  static constexpr uint64_t kIterations    = 1000000;
+  auto &data                               = data::Data::getInstance();
+  const auto imu_data                      = data.getSensorsImuData();
+
+  const auto write = [&](const uint64_t) { data.setSensorsImuData(imu_data); };
+  report("setSensorsImuData without waiters", nanosPerIteration(kIterations, write), "ns");
+
+  std::atomic<bool> waiting = true;
+  std::vector<std::thread> waiters;
+  for (std::size_t i = 0; i < kNumWaiters; ++i) {
+    waiters.emplace_back([&]() {
+      uint64_t version = data.getVersion(data::Substructure::kStateMachine);
+      while (waiting) {
+        version = data.waitForUpdate(data::Substructure::kStateMachine, version, 10);
+      }
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  report("setSensorsImuData while state machine waiters sleep",
+         nanosPerIteration(kIterations, write), "ns");
+  waiting = false;
+  for (auto &waiter : waiters) {
+    waiter.join();
+  }
+}
+
+}  // namespace hyped::benchmarking
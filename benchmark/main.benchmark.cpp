@@ -0,0 +1,11 @@
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+int main(int argc, char **argv)
+{
+  std::cout << "benchmarking\n";
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return (RUN_ALL_TESTS());
+}
@@ -0,0 +1,77 @@
+#include "benchmark.hpp"
+
+#include <string>
+
+#include <navigation/navigation.hpp>
+#include <utils/logger.hpp>
+#include <utils/system.hpp>
+
+namespace hyped::benchmarking {
+
+namespace {
+
+// the same debug statement compiled with and without debug messages, regardless of the level this
+// benchmark is built with
+#undef HYPED_MAX_LOG_LEVEL
+#define HYPED_MAX_LOG_LEVEL 3
+void logCompiledIn(const utils::Logger &log, const uint32_t counter, const data::nav_t value)
+{
+  LOG_DEBUG(log, "%d: Data Update: a=%.3f, v=%.3f, d=%.3f", counter, value * 2, value * 3,
+            value * 4);
+}
+
+#undef HYPED_MAX_LOG_LEVEL
+#define HYPED_MAX_LOG_LEVEL 2
+void logCompiledOut(const utils::Logger &log, const uint32_t counter, const data::nav_t value)
+{
+  LOG_DEBUG(log, "%d: Data Update: a=%.3f, v=%.3f, d=%.3f", counter, value * 2, value * 3,
+            value * 4);
+}
+
+}  // namespace
+
+/**
+ * Cost of debug logging that is disabled at runtime: calling Logger::debug directly, going through
+ * LOG_DEBUG with debug messages compiled in and with them compiled out. Then the cost of a whole
+ * navigation iteration with the navigation library built at MAX_LOG_LEVEL_NAVIGATION.
+ */
+class LoggingBenchmark : public Benchmark {
+ protected:
+  inline static const std::string kDefaultConfigPath = "configurations/test/default_config.json";
+  inline static const char *kDefaultArgs[2]          = {"mock_binary", kDefaultConfigPath.c_str()};
+  static constexpr uint64_t kNumStatements           = 10000000;
+  static constexpr uint64_t kNumIterations           = 200000;
+
+  void SetUp() { utils::System::parseArgs(2, kDefaultArgs); }
+
+  template<typename Statement>
+  static void statement(const std::string &name, Statement log_statement)
+  {
+    const utils::Logger log("BENCHMARK", utils::Logger::Level::kInfo);
+    const auto nanos = nanosPerIteration(kNumStatements, [&](uint64_t i) {
+      log_statement(log, static_cast<uint32_t>(i), static_cast<data::nav_t>(i));
+    });
+    report(name, nanos, "ns/statement");
+  }
+};
+
+TEST_F(LoggingBenchmark, disabledDebugStatement)
+{
+  statement("Logger::debug disabled at runtime",
+            [](const utils::Logger &log, const uint32_t counter, const data::nav_t value) {
+              log.debug("%d: Data Update: a=%.3f, v=%.3f, d=%.3f", counter, value * 2, value * 3,
+                        value * 4);
+            });
+  statement("LOG_DEBUG disabled at runtime", logCompiledIn);
+  statement("LOG_DEBUG compiled out", logCompiledOut);
+}
+
+TEST_F(LoggingBenchmark, navigationIteration)
+{
+  navigation::Navigation navigation;
+  navigation.initialiseTimestamps();
+  const auto nanos = nanosPerIteration(kNumIterations, [&](uint64_t) { navigation.navigate(); });
+  report("Navigation::navigate", nanos, "ns/iteration");
+}
+
+}  // namespace hyped::benchmarking
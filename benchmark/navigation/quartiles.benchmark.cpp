@@ -0,0 +1,72 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include <navigation/navigation.hpp>
+#include <utils/system.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Cost of computing the quartiles used for outlier detection: the previous implementation, which
+ * copied the reliable readings into a vector and sorted it, against the sorting network in
+ * `Navigation`.
+ */
+class QuartilesBenchmark : public Benchmark {
+ protected:
+  inline static const std::string kDefaultConfigPath = "configurations/test/default_config.json";
+  inline static const char *kDefaultArgs[2]          = {"mock_binary", kDefaultConfigPath.c_str()};
+  static constexpr uint64_t kNumQuartiles            = 1000000;
+
+  using QuartileBounds  = navigation::Navigation::QuartileBounds;
+  using NavigationArray = navigation::Navigation::NavigationArray;
+  using ImuMask         = std::array<bool, data::Sensors::kNumImus>;
+
+  void SetUp() { utils::System::parseArgs(2, kDefaultArgs); }
+
+  static QuartileBounds sortedVectorQuartiles(const NavigationArray &data_array,
+                                              const ImuMask &is_reliable)
+  {
+    std::vector<data::nav_t> data_vector;
+    for (std::size_t i = 0; i < data::Sensors::kNumImus; ++i) {
+      if (is_reliable.at(i)) { data_vector.push_back(data_array.at(i)); }
+    }
+    std::sort(data_vector.begin(), data_vector.end());
+    QuartileBounds quartile_bounds;
+    quartile_bounds.at(0) = (data_vector.at(0) + data_vector.at(1)) / 2.;
+    quartile_bounds.at(2)
+      = (data_vector.at(data_vector.size() - 2) + data_vector.at(data_vector.size() - 1)) / 2.;
+    quartile_bounds.at(1) = (data_vector.at(1) + data_vector.at(2)) / 2.;
+    return quartile_bounds;
+  }
+
+  template<typename Quartiles>
+  static void quartiles(const std::string &name, Quartiles calculate)
+  {
+    NavigationArray accelerations;
+    const auto nanos = nanosPerIteration(kNumQuartiles, [&](uint64_t i) {
+      for (std::size_t imu = 0; imu < data::Sensors::kNumImus; ++imu) {
+        accelerations[imu] = static_cast<data::nav_t>((i * 7 + imu * 13) % 101) / 100;
+      }
+      doNotOptimise(calculate(accelerations)[1]);
+    });
+    report(name, nanos, "ns/quartiles");
+  }
+};
+
+TEST_F(QuartilesBenchmark, imu)
+{
+  const ImuMask is_reliable = {true, true, true, true};
+  quartiles("Quartiles vector + std::sort", [&](const NavigationArray &values) {
+    return sortedVectorQuartiles(values, is_reliable);
+  });
+  navigation::Navigation navigation;
+  quartiles("Quartiles sorting network", [&](const NavigationArray &values) {
+    return navigation.calculateImuQuartiles(values);
+  });
+}
+
+}  // namespace hyped::benchmarking
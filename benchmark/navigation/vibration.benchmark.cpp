@@ -0,0 +1,90 @@
+#include "benchmark.hpp"
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include <navigation/vibration_statistics.hpp>
+#include <utils/math/statistics.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Reproduces the previous `Navigation::checkVibration` behaviour: the readings are kept in a ring
+ * buffer and the variance of every axis is recomputed over the whole buffer on each tick.
+ */
+template<std::size_t kWindowSize>
+class RecomputedVibrationStatistics {
+ public:
+  using ImuAxisData = typename navigation::VibrationStatistics<kWindowSize>::ImuAxisData;
+
+  void update(const ImuAxisData &raw_acceleration)
+  {
+    window_[next_] = raw_acceleration;
+    next_          = (next_ + 1) % kWindowSize;
+    std::array<utils::math::OnlineStatistics<data::nav_t>, 3> online_array_axis;
+    for (std::size_t i = 0; i < kWindowSize; ++i) {
+      const auto &raw_data = window_[(next_ + i) % kWindowSize];
+      // axis 0 is the movement axis and was skipped
+      for (std::size_t axis = 1; axis < 3; ++axis) {
+        for (const auto raw_data_for_imu : raw_data[axis]) {
+          online_array_axis[axis].update(raw_data_for_imu);
+        }
+      }
+    }
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      variance_[axis] = online_array_axis[axis].getVariance();
+    }
+  }
+
+  data::nav_t getVariance(const std::size_t axis) const { return variance_[axis]; }
+
+ private:
+  std::array<ImuAxisData, kWindowSize> window_{};
+  std::size_t next_ = 0;
+  std::array<data::nav_t, 3> variance_{};
+};
+
+/**
+ * Per-tick cost of the vibration check for several window sizes. The incremental statistics should
+ * cost the same for every size while recomputing grows linearly with it.
+ */
+class VibrationBenchmark : public Benchmark {
+ protected:
+  static constexpr uint64_t kNumTicks = 5000;
+
+  template<std::size_t kWindowSize>
+  static void compare()
+  {
+    const std::string window = " (window " + std::to_string(kWindowSize) + ")";
+    tick<RecomputedVibrationStatistics<kWindowSize>>("Vibration recomputed" + window);
+    tick<navigation::VibrationStatistics<kWindowSize>>("Vibration incremental" + window);
+  }
+
+  template<typename Statistics>
+  static void tick(const std::string &name)
+  {
+    // windows are too large for the stack
+    auto statistics = std::make_unique<Statistics>();
+    typename Statistics::ImuAxisData reading;
+    const auto nanos = nanosPerIteration(kNumTicks, [&](uint64_t i) {
+      for (std::size_t axis = 0; axis < 3; ++axis) {
+        for (std::size_t imu = 0; imu < data::Sensors::kNumImus; ++imu) {
+          reading[axis][imu] = static_cast<data::nav_t>((i * 7 + imu * 13 + axis) % 101) / 100;
+        }
+      }
+      statistics->update(reading);
+      doNotOptimise(statistics->getVariance(1));
+    });
+    report(name, nanos, "ns/tick");
+  }
+};
+
+TEST_F(VibrationBenchmark, windowSizes)
+{
+  compare<100>();
+  compare<1000>();
+  compare<10000>();
+}
+
+}  // namespace hyped::benchmarking
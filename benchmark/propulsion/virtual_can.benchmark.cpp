@@ -0,0 +1,189 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <propulsion/can/sdo_client.hpp>
+#include <propulsion/can/sender_interface.hpp>
+#include <utils/io/can.hpp>
+#include <utils/io/virtual_can_bus.hpp>
+#include <utils/system.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * End-to-end SDO latency on a `can::VirtualBus`: the pod side sends one SDO request to each of four
+ * simulated motor controllers at once and waits for all responses through `propulsion::SdoClient`,
+ * while simulated BMS units flood the bus with their own traffic. Every node runs the regular `Can`
+ * receive thread and dispatch table.
+ */
+class VirtualCanBenchmark : public Benchmark {
+ protected:
+  inline static const std::string kDefaultConfigPath = "configurations/test/default_config.json";
+  inline static const char *kDefaultArgs[2]          = {"mock_binary", kDefaultConfigPath.c_str()};
+  static constexpr std::size_t kNumControllers       = 4;
+  static constexpr std::size_t kNumRounds            = 20000;
+  static constexpr uint32_t kBmsIdBase               = 300;
+  static constexpr uint32_t kBmsIdSize               = 5;
+
+  /**
+   * @brief Answers every SDO request of its node with an SDO response.
+   */
+  class SimulatedController : public utils::io::ICanProcessor {
+   public:
+    SimulatedController(utils::io::can::VirtualBus &bus, const uint32_t node_id)
+        : can_(bus.attach()),
+          node_id_(node_id)
+    {
+      can_.registerProcessor(
+        this, utils::io::can::IdRange::exact(propulsion::kSdoReceive + node_id_, false));
+      can_.start();
+    }
+
+    void processNewData(utils::io::can::Frame &message) override
+    {
+      utils::io::can::Frame response = message;
+      response.id                    = propulsion::kSdoTransmit + node_id_;
+      can_.send(response);
+    }
+
+   private:
+    utils::io::Can can_;
+    uint32_t node_id_;
+  };
+
+  /**
+   * @brief Completes the pending SDO requests on the pod side and counts the BMS frames.
+   */
+  class PodProcessor : public utils::io::ICanProcessor {
+   public:
+    explicit PodProcessor(propulsion::SdoClient &sdo_client) : sdo_client_(sdo_client) {}
+
+    void processNewData(utils::io::can::Frame &message) override
+    {
+      if (message.extended) {
+        ++num_bms_frames;
+      } else {
+        sdo_client_.processResponse(message);
+      }
+    }
+
+    std::atomic<uint64_t> num_bms_frames = 0;
+
+   private:
+    propulsion::SdoClient &sdo_client_;
+  };
+
+  void SetUp() { utils::System::parseArgs(2, kDefaultArgs); }
+
+  static double percentile(std::vector<double> values, const double fraction)
+  {
+    const std::size_t index = static_cast<std::size_t>(fraction * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+  }
+
+  static void sdoRounds(const std::string &name, const uint32_t num_bms_units)
+  {
+    utils::io::can::VirtualBus bus;
+    propulsion::SdoClient sdo_client;
+    PodProcessor pod_processor(sdo_client);
+    utils::io::Can pod(bus.attach());
+    for (uint32_t node_id = 1; node_id <= kNumControllers; ++node_id) {
+      pod.registerProcessor(&pod_processor, utils::io::can::IdRange::exact(
+                                              propulsion::kSdoTransmit + node_id, false));
+    }
+    if (num_bms_units > 0) {
+      pod.registerProcessor(&pod_processor,
+                            {kBmsIdBase, kBmsIdBase + kBmsIdSize * num_bms_units - 1, true});
+    }
+    pod.start();
+    std::vector<std::unique_ptr<SimulatedController>> controllers;
+    for (uint32_t node_id = 1; node_id <= kNumControllers; ++node_id) {
+      controllers.push_back(std::make_unique<SimulatedController>(bus, node_id));
+    }
+
+    // every BMS unit answers continuously with all of its messages
+    std::atomic<bool> is_flooding = true;
+    std::vector<std::thread> bms_units;
+    for (uint32_t unit = 0; unit < num_bms_units; ++unit) {
+      bms_units.emplace_back([&bus, &is_flooding, unit]() {
+        const auto node = bus.attach();
+        node->setFilters({});
+        utils::io::can::Frame frames[kBmsIdSize];
+        for (uint32_t i = 0; i < kBmsIdSize; ++i) {
+          frames[i].id       = kBmsIdBase + kBmsIdSize * unit + i;
+          frames[i].extended = true;
+          frames[i].len      = 8;
+        }
+        while (is_flooding) {
+          node->send(frames, kBmsIdSize);
+          std::this_thread::yield();
+        }
+      });
+    }
+
+    std::vector<double> latencies;
+    latencies.reserve(kNumRounds);
+    uint64_t num_timeouts = 0;
+    const double cpu_before = processCpuMillis();
+    utils::Timer total;
+    total.start();
+    for (std::size_t round = 0; round < kNumRounds; ++round) {
+      utils::Timer timer;
+      timer.start();
+      std::future<bool> responses[kNumControllers];
+      utils::io::can::Frame requests[kNumControllers];
+      for (uint32_t i = 0; i < kNumControllers; ++i) {
+        const uint32_t node_id = i + 1;
+        responses[i]           = sdo_client.expectResponse(propulsion::kSdoTransmit + node_id);
+        requests[i].id         = propulsion::kSdoReceive + node_id;
+        requests[i].extended   = false;
+        requests[i].len        = 8;
+      }
+      pod.send(requests, kNumControllers);
+      for (uint32_t i = 0; i < kNumControllers; ++i) {
+        if (responses[i].wait_for(std::chrono::milliseconds(70)) != std::future_status::ready) {
+          ++num_timeouts;
+          sdo_client.cancel(propulsion::kSdoTransmit + i + 1);
+        }
+      }
+      timer.stop();
+      latencies.push_back(static_cast<double>(timer.getMicros()));
+    }
+    total.stop();
+    const double cpu_millis = processCpuMillis() - cpu_before;
+    is_flooding             = false;
+    for (auto &bms_unit : bms_units) {
+      bms_unit.join();
+    }
+
+    const double seconds     = static_cast<double>(total.getMicros()) * 1e-6;
+    const uint64_t sdo_count = 2 * kNumControllers * kNumRounds;
+    report(name + ": mean latency", static_cast<double>(total.getMicros()) / kNumRounds,
+           "us/round");
+    report(name + ": p99 latency", percentile(latencies, 0.99), "us/round");
+    report(name + ": SDO frames", sdo_count / seconds, "frames/s");
+    report(name + ": BMS frames received", pod_processor.num_bms_frames / seconds, "frames/s");
+    report(name + ": frames dropped", static_cast<double>(bus.getNumDropped()), "frames");
+    report(name + ": timeouts", static_cast<double>(num_timeouts), "rounds");
+    report(name + ": CPU time", cpu_millis * 1e3 / kNumRounds, "us/round");
+  }
+};
+
+TEST_F(VirtualCanBenchmark, sdoRoundTrip)
+{
+  sdoRounds("4 controllers", 0);
+}
+
+TEST_F(VirtualCanBenchmark, sdoRoundTripWithBmsTraffic)
+{
+  sdoRounds("4 controllers, 2 BMS", 2);
+}
+
+}  // namespace hyped::benchmarking
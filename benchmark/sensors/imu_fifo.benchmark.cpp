@@ -0,0 +1,50 @@
+#include "benchmark.hpp"
+
+#include <string>
+
+#include <sensors/imu.hpp>
+#include <utils/io/spi.hpp>
+#include <utils/system.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Throughput of draining an IMU FIFO through spidev. Needs an IMU on the SPI bus, so it only runs
+ * on the pod; elsewhere it is skipped.
+ */
+class ImuFifoBenchmark : public Benchmark {
+ protected:
+  inline static const std::string kDefaultConfigPath = "configurations/test/default_config.json";
+  inline static const char *kDefaultArgs[2]          = {"mock_binary", kDefaultConfigPath.c_str()};
+  static constexpr uint32_t kPin                     = 22;
+  static constexpr uint64_t kNumReads                = 10000;
+
+  void SetUp() { utils::System::parseArgs(2, kDefaultArgs); }
+};
+
+TEST_F(ImuFifoBenchmark, readFifo)
+{
+  auto &spi = utils::io::Spi::getInstance();
+  if (!spi.isOpen()) { GTEST_SKIP() << "no spidev device"; }
+  spi.setClock(utils::io::Spi::Clock::k4MHz);
+  sensors::Imu imu(kPin, true);
+
+  const auto before    = spi.getStatistics();
+  uint64_t num_samples = 0;
+  utils::Timer timer;
+  timer.start();
+  for (uint64_t i = 0; i < kNumReads; ++i) {
+    num_samples += imu.getData().fifo_size;
+  }
+  timer.stop();
+  const auto after = spi.getStatistics();
+
+  const double seconds       = static_cast<double>(timer.getMicros()) * 1e-6;
+  const double num_bytes     = static_cast<double>(after.num_bytes - before.num_bytes);
+  const double num_transfers = static_cast<double>(after.num_transfers - before.num_transfers);
+  report("bytes", num_bytes / seconds, "bytes/s");
+  report("samples", num_samples / seconds, "samples/s");
+  report("transfers", num_transfers / kNumReads, "ioctls/read");
+}
+
+}  // namespace hyped::benchmarking
@@ -0,0 +1,80 @@
+#include "benchmark.hpp"
+#include "telemetry_run.hpp"
+
+#include <string>
+
+#include <data/data.hpp>
+#include <telemetry/binary_writer.hpp>
+#include <telemetry/writer.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Cost of packing one telemetry packet from the central data structure, as JSON and as a binary
+ * frame. Both include reading the data, which is the same for either format.
+ */
+class TelemetryWriterBenchmark : public Benchmark {
+ protected:
+  static constexpr uint64_t kNumPackets = 20000;
+};
+
+TEST_F(TelemetryWriterBenchmark, pack)
+{
+  std::size_t json_size = 0;
+
+  const double json_nanos = nanosPerIteration(kNumPackets, [&](uint64_t i) {
+    telemetry::Writer writer;
+    writer.start();
+    writer.packTime();
+    writer.packId(i);
+    writer.packTelemetryData();
+    writer.packSensorsData();
+    writer.packMotorData();
+    writer.packStateMachineData();
+    writer.packNavigationData();
+    writer.end();
+    const std::string packet = writer.getString();
+    json_size                = packet.size();
+    doNotOptimise(packet);
+  });
+  telemetry::BinaryWriter binary_writer;
+  const double binary_nanos = nanosPerIteration(kNumPackets, [&](uint64_t i) {
+    binary_writer.packFull(i);
+    doNotOptimise(binary_writer.getData());
+  });
+  data::Data &data = data::Data::getInstance();
+  telemetry::binary::Values values;
+  telemetry::binary::capture(data, values);
+  const double capture_nanos = nanosPerIteration(kNumPackets, [&](uint64_t) {
+    telemetry::binary::capture(data, values);
+    doNotOptimise(values);
+  });
+  report("json", json_nanos, "ns/packet");
+  report("binary", binary_nanos, "ns/packet");
+  report("binary excluding data reads", binary_nanos - capture_nanos, "ns/packet");
+  report("json size", static_cast<double>(json_size), "bytes");
+  report("binary size", static_cast<double>(binary_writer.getSize()), "bytes");
+}
+
+TEST_F(TelemetryWriterBenchmark, replay)
+{
+  for (const uint32_t keyframe_interval : {1, 10, 100}) {
+    testing::TelemetryRun run(100);
+    telemetry::BinaryWriter writer;
+    std::size_t num_bytes = 0;
+    uint32_t id           = 0;
+    for (; !run.isFinished(); run.step(), ++id) {
+      if (id % keyframe_interval == 0) {
+        writer.packFull(id, run.getTimeMillis(), run.getValues());
+      } else {
+        writer.packDelta(id, run.getTimeMillis(), run.getValues());
+      }
+      num_bytes += writer.getSize();
+    }
+    const double seconds = run.getTimeMillis() / 1000.0;
+    report("100 Hz, keyframe every " + std::to_string(keyframe_interval), num_bytes / seconds,
+           "bytes/s");
+  }
+}
+
+}  // namespace hyped::benchmarking
@@ -0,0 +1,71 @@
+#include "benchmark.hpp"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <utils/io/adc.hpp>
+#include <utils/system.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Cost of sampling an ADC channel. On the pod the real sysfs file is read; elsewhere a file in a
+ * temporary directory stands in for it, which still shows the system calls saved per sample.
+ */
+class AdcBenchmark : public Benchmark {
+ protected:
+  inline static const std::string kDefaultConfigPath = "configurations/test/default_config.json";
+  inline static const char *kDefaultArgs[2]          = {"mock_binary", kDefaultConfigPath.c_str()};
+  inline static const std::string kRawPath = "sys/bus/iio/devices/iio:device0/in_voltage0_raw";
+  static constexpr uint64_t kNumReads      = 100000;
+
+  void SetUp()
+  {
+    utils::System::parseArgs(2, kDefaultArgs);
+    if (std::filesystem::exists("/" + kRawPath)) {
+      root_ = "/";
+      return;
+    }
+    char path[] = "/tmp/hyped-adc-benchmark-XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(path));
+    root_           = path;
+    is_fake_        = true;
+    const auto file = std::filesystem::path(root_) / kRawPath;
+    std::filesystem::create_directories(file.parent_path());
+    std::ofstream(file) << "2048\n";
+  }
+
+  void TearDown()
+  {
+    if (is_fake_) { std::filesystem::remove_all(root_); }
+  }
+
+  std::string root_;
+  bool is_fake_ = false;
+};
+
+TEST_F(AdcBenchmark, read)
+{
+  const std::string path = (std::filesystem::path(root_) / kRawPath).string();
+  // what every sample used to cost: open, seek, read and close the sysfs file
+  const double reopen_nanos = nanosPerIteration(kNumReads, [&](uint64_t) {
+    char buffer[8] = {};
+    const int fd   = open(path.c_str(), O_RDONLY);
+    lseek(fd, 0, SEEK_SET);
+    doNotOptimise(read(fd, buffer, sizeof(buffer) - 1));
+    close(fd);
+    doNotOptimise(std::atoi(buffer));
+  });
+  utils::io::Adc adc(0, root_);
+  const double pread_nanos
+    = nanosPerIteration(kNumReads, [&](uint64_t) { doNotOptimise(adc.read()); });
+  report("reopen", reopen_nanos, "ns/read");
+  report("pread", pread_nanos, "ns/read");
+}
+
+}  // namespace hyped::benchmarking
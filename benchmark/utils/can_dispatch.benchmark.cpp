@@ -0,0 +1,95 @@
+#include "benchmark.hpp"
+
+#include <string>
+#include <vector>
+
+#include <utils/io/can.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Cost of handing a received frame to its processor: the previous linear scan, which asked every
+ * processor whether it owned the id, against `can::DispatchTable`, for a growing number of
+ * processors shaped like the motor controllers, each owning the 13 CANopen COB-IDs of its node.
+ */
+class CanDispatchBenchmark : public Benchmark {
+ protected:
+  static constexpr uint64_t kNumFrames = 1000000;
+  static constexpr uint32_t kCobIds[13]{0x80,  0x600, 0x580, 0x000, 0x700, 0x180, 0x200,
+                                        0x280, 0x300, 0x380, 0x400, 0x480, 0x500};
+
+  class CountingProcessor : public utils::io::ICanProcessor {
+   public:
+    explicit CountingProcessor(const uint32_t node_id) : node_id_(node_id) {}
+
+    void processNewData(utils::io::can::Frame &message) override { doNotOptimise(message.id); }
+
+    // previous way of finding the owner of a frame
+    bool hasId(const uint32_t id, const bool)
+    {
+      for (const uint32_t cob_id : kCobIds) {
+        if (cob_id + node_id_ == id) { return true; }
+      }
+      return false;
+    }
+
+    uint32_t getNodeId() const { return node_id_; }
+
+   private:
+    uint32_t node_id_;
+  };
+
+  template<typename Dispatch>
+  static void dispatch(const std::string &name, const std::vector<CountingProcessor> &processors,
+                       Dispatch dispatch_frame)
+  {
+    utils::io::can::Frame frame;
+    frame.extended = false;
+    frame.len      = 0;
+    const auto nanos = nanosPerIteration(kNumFrames, [&](uint64_t i) {
+      // SDO responses of every node in turn, the most common frames on the bus
+      frame.id = 0x580 + processors[i % processors.size()].getNodeId();
+      dispatch_frame(frame);
+    });
+    report(name + " (" + std::to_string(processors.size()) + " processors)", nanos, "ns/frame");
+  }
+
+  static std::vector<CountingProcessor> makeProcessors(const uint32_t num_processors)
+  {
+    std::vector<CountingProcessor> processors;
+    for (uint32_t node_id = 1; node_id <= num_processors; ++node_id) {
+      processors.emplace_back(node_id);
+    }
+    return processors;
+  }
+};
+
+TEST_F(CanDispatchBenchmark, linearScan)
+{
+  for (const uint32_t num_processors : {1, 4, 16, 64}) {
+    auto processors = makeProcessors(num_processors);
+    dispatch("linear scan", processors, [&](utils::io::can::Frame &frame) {
+      for (auto &processor : processors) {
+        if (processor.hasId(frame.id, frame.extended)) { processor.processNewData(frame); }
+      }
+    });
+  }
+}
+
+TEST_F(CanDispatchBenchmark, dispatchTable)
+{
+  for (const uint32_t num_processors : {1, 4, 16, 64}) {
+    auto processors = makeProcessors(num_processors);
+    utils::io::can::DispatchTable table;
+    for (auto &processor : processors) {
+      for (const uint32_t cob_id : kCobIds) {
+        table.add(&processor,
+                  utils::io::can::IdRange::exact(cob_id + processor.getNodeId(), false));
+      }
+    }
+    dispatch("dispatch table", processors,
+             [&](utils::io::can::Frame &frame) { table.dispatch(frame); });
+  }
+}
+
+}  // namespace hyped::benchmarking
@@ -0,0 +1,89 @@
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <utils/io/can.hpp>
+#include <utils/system.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Throughput of a virtual CAN bus with one system call per frame against batches of
+ * `Can::kBatchSize` frames per system call, on both the sending and the receiving side. Needs a
+ * virtual CAN interface, e.g.
+ *   ip link add dev vcan0 type vcan && ip link set up vcan0
+ */
+class CanIoBenchmark : public Benchmark {
+ protected:
+  inline static const std::string kDefaultConfigPath = "configurations/test/default_config.json";
+  inline static const char *kDefaultArgs[2]          = {"mock_binary", kDefaultConfigPath.c_str()};
+  static constexpr std::size_t kNumFrames            = 100000;
+
+  class CountingProcessor : public utils::io::ICanProcessor {
+   public:
+    void processNewData(utils::io::can::Frame &) override { ++num_frames; }
+    std::atomic<std::size_t> num_frames = 0;
+  };
+
+  void SetUp() { utils::System::parseArgs(2, kDefaultArgs); }
+
+  template<typename Send>
+  static void transfer(const std::string &name, Send send)
+  {
+    utils::io::Can sender("vcan0");
+    utils::io::Can receiver("vcan0");
+    if (!sender.isOpen() || !receiver.isOpen()) { GTEST_SKIP() << "vcan0 is not available"; }
+    CountingProcessor processor;
+    receiver.registerProcessor(&processor, {0x580, 0x58F, false});
+    receiver.start();
+
+    std::vector<utils::io::can::Frame> frames(kNumFrames);
+    for (std::size_t i = 0; i < kNumFrames; ++i) {
+      frames[i].id       = 0x580 + i % 16;
+      frames[i].extended = false;
+      frames[i].len      = 8;
+    }
+    utils::Timer timer;
+    timer.start();
+    send(sender, frames);
+    // the socket buffers may drop frames under load, so wait for the receiver to go quiet
+    std::size_t num_received = 0;
+    do {
+      num_received = processor.num_frames;
+      utils::concurrent::Thread::sleep(10);
+    } while (num_received != processor.num_frames);
+    timer.stop();
+
+    const auto sent     = sender.getStatistics();
+    const auto received = receiver.getStatistics();
+    report(name + ": frames sent", static_cast<double>(sent.num_frames_sent), "frames");
+    report(name + ": frames received", static_cast<double>(num_received), "frames");
+    report(name + ": throughput", num_received * 1e6 / timer.getMicros(), "frames/s");
+    report(name + ": send calls", static_cast<double>(sent.num_send_calls) / sent.num_frames_sent,
+           "syscalls/frame");
+    report(name + ": receive calls",
+           static_cast<double>(received.num_receive_calls) / received.num_frames_received,
+           "syscalls/frame");
+  }
+};
+
+TEST_F(CanIoBenchmark, singleFrames)
+{
+  transfer("single frames",
+           [](utils::io::Can &can, const std::vector<utils::io::can::Frame> &frames) {
+             for (const auto &frame : frames) {
+               can.send(frame);
+             }
+           });
+}
+
+TEST_F(CanIoBenchmark, batches)
+{
+  transfer("batches", [](utils::io::Can &can, const std::vector<utils::io::can::Frame> &frames) {
+    can.send(frames.data(), frames.size());
+  });
+}
+
+}  // namespace hyped::benchmarking
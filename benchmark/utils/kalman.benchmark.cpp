@@ -0,0 +1,55 @@
+#include "benchmark.hpp"
+
+#include <string>
+
+#include <utils/math/kalman_multivariate.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Cost of a single filter() call for runtime-sized filters, which allocate temporaries on every
+ * call, against filters with the same dimensions fixed at compile time.
+ */
+class KalmanBenchmark : public Benchmark {
+ protected:
+  static constexpr uint64_t kNumFilters = 200000;
+
+  template<typename Kalman>
+  static void filter(const std::string &name, Kalman &kalman, const uint32_t n, const uint32_t m)
+  {
+    // the model used by navigation::KalmanFilter, converted to the filter's own types
+    const Eigen::MatrixXf A = Eigen::MatrixXf::Identity(n, n);
+    const Eigen::MatrixXf Q = Eigen::MatrixXf::Constant(n, n, 0.02f);
+    const Eigen::MatrixXf H = Eigen::MatrixXf::Identity(m, n);
+    const Eigen::MatrixXf R = Eigen::MatrixXf::Constant(m, m, 0.001f);
+    const Eigen::VectorXf x = Eigen::VectorXf::Zero(n);
+    const Eigen::MatrixXf P = Eigen::MatrixXf::Constant(n, n, 0.5f);
+    kalman.setModels(A, Q, H, R);
+    kalman.setInitial(x, P);
+    typename Kalman::MeasurementVector z = Eigen::VectorXf::Zero(m);
+    const auto nanos = nanosPerIteration(kNumFilters, [&](uint64_t i) {
+      z(0) = static_cast<float>(i % 100) / 10;
+      kalman.filter(z);
+      doNotOptimise(kalman.getStateEstimate()(0));
+    });
+    report(name, nanos, "ns/filter");
+  }
+};
+
+TEST_F(KalmanBenchmark, scalar)
+{
+  utils::math::KalmanMultivariate<> dynamic_kalman(1, 1);
+  filter("KalmanMultivariate<> 1x1", dynamic_kalman, 1, 1);
+  utils::math::KalmanMultivariate<1, 1> fixed_kalman;
+  filter("KalmanMultivariate<1, 1>", fixed_kalman, 1, 1);
+}
+
+TEST_F(KalmanBenchmark, vector)
+{
+  utils::math::KalmanMultivariate<> dynamic_kalman(3, 1);
+  filter("KalmanMultivariate<> 3x1", dynamic_kalman, 3, 1);
+  utils::math::KalmanMultivariate<3, 1> fixed_kalman;
+  filter("KalmanMultivariate<3, 1>", fixed_kalman, 3, 1);
+}
+
+}  // namespace hyped::benchmarking
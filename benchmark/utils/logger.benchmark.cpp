@@ -0,0 +1,89 @@
+#include "benchmark.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <utils/async_logger.hpp>
+#include <utils/logger.hpp>
+#include <utils/timer.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Cost on the calling thread of logging one message, printing it synchronously against pushing it
+ * to the asynchronous backend. All output goes to /dev/null. Messages are logged in bursts that fit
+ * into a ring and only the logging calls are timed, not waiting for the ring to drain in between.
+ * Register dumps as logged by Spi::transfer are cheap to format, navigation estimates are not.
+ */
+class LoggerBenchmark : public Benchmark {
+ protected:
+  static constexpr uint64_t kNumBursts        = 1000;
+  static constexpr uint64_t kMessagesPerBurst = utils::AsyncLogger::kRingCapacity / 2;
+
+  static void logRegister(const utils::Logger &log, const uint64_t i, const uint64_t burst)
+  {
+    log.debug("register 0x%02x = 0x%02x", static_cast<unsigned>(i % 128),
+              static_cast<unsigned>(burst % 256));
+  }
+
+  static void logEstimate(const utils::Logger &log, const uint64_t i, const uint64_t burst)
+  {
+    log.debug("%u: Data Update: a=%.3f, v=%.3f, d=%.3f", static_cast<unsigned>(i), i * 0.01,
+              burst * 0.1, burst * 12.5);
+  }
+
+  template<typename Message, typename BetweenBursts>
+  static double log(Message message, BetweenBursts between_bursts)
+  {
+    utils::Logger log("BENCHMARK", utils::Logger::Level::kDebug);
+    uint64_t micros = 0;
+    for (uint64_t burst = 0; burst < kNumBursts; ++burst) {
+      utils::Timer timer;
+      timer.start();
+      for (uint64_t i = 0; i < kMessagesPerBurst; ++i) {
+        message(log, i, burst);
+      }
+      timer.stop();
+      micros += timer.getMicros();
+      between_bursts();
+    }
+    return static_cast<double>(micros) * 1000.0 / (kNumBursts * kMessagesPerBurst);
+  }
+
+  template<typename Message>
+  static void compare(const std::string &name, Message message)
+  {
+    // the synchronous path always prints to stdout
+    fflush(stdout);
+    const int stdout_fd  = dup(STDOUT_FILENO);
+    const int devnull_fd = open("/dev/null", O_WRONLY);
+    dup2(devnull_fd, STDOUT_FILENO);
+    const double synchronous_nanos = log(message, []() {});
+    fflush(stdout);
+    dup2(stdout_fd, STDOUT_FILENO);
+    close(stdout_fd);
+    close(devnull_fd);
+    report("Logger synchronous " + name, synchronous_nanos, "ns/message");
+
+    FILE *devnull = fopen("/dev/null", "w");
+    {
+      utils::AsyncLogger async_logger(devnull, devnull);
+      utils::Logger::setAsyncLogger(&async_logger);
+      const double asynchronous_nanos = log(message, [&async_logger]() { async_logger.flush(); });
+      utils::Logger::setAsyncLogger(nullptr);
+      report("Logger asynchronous " + name, asynchronous_nanos, "ns/message");
+      report("Logger asynchronous dropped " + name, async_logger.getNumDropped(), "messages");
+    }
+    fclose(devnull);
+  }
+};
+
+TEST_F(LoggerBenchmark, synchronousAndAsynchronous)
+{
+  compare("register", logRegister);
+  compare("estimate", logEstimate);
+}
+
+}  // namespace hyped::benchmarking
@@ -0,0 +1,112 @@
+#include "benchmark.hpp"
+
+#include <list>
+#include <memory>
+#include <queue>
+#include <string>
+
+#include <data/data.hpp>
+#include <utils/math/statistics.hpp>
+
+namespace hyped::benchmarking {
+
+/**
+ * Reproduces the previous `utils::math::RollingStatistics`: the window is a queue backed by a
+ * linked list, so every update allocates a node and frees another.
+ */
+template<typename T>
+class ListRollingStatistics : public utils::math::Statistics<T> {
+ public:
+  explicit ListRollingStatistics(std::size_t window_size) : window_size_(window_size) {}
+
+  void update(T new_value) override
+  {
+    if (window_.size() < window_size_) {
+      window_.push(new_value);
+      online_.update(new_value);
+      this->sum_      = online_.getSum();
+      this->mean_     = online_.getMean();
+      this->variance_ = online_.getVariance();
+    } else {
+      this->sum_ = this->sum_ + new_value - window_.front();
+      T new_mean = this->sum_ / window_size_;
+      this->variance_ += (new_value - window_.front())
+                         * (new_value - new_mean + window_.front() - this->mean_)
+                         / (window_size_ - 1);
+      this->mean_ = new_mean;
+      window_.pop();
+      window_.push(new_value);
+    }
+  }
+
+ private:
+  const std::size_t window_size_;
+  std::queue<T, std::list<T>> window_;
+  utils::math::OnlineStatistics<T> online_;
+};
+
+class StatisticsBenchmark : public Benchmark {
+ protected:
+  // matches Navigation::kCalibrationQueries
+  static constexpr std::size_t kWindowSize = 10000;
+  static constexpr uint64_t kNumUpdates    = 10 * kWindowSize;
+
+  static data::NavigationVector sample(const uint64_t i)
+  {
+    return data::NavigationVector({static_cast<data::nav_t>(i % 7),
+                                   static_cast<data::nav_t>(i % 11),
+                                   9.81f + static_cast<data::nav_t>(i % 13) / 100});
+  }
+
+  template<typename Stats>
+  static void update(const std::string &name, Stats &stats)
+  {
+    const auto nanos = nanosPerIteration(kNumUpdates, [&](uint64_t i) {
+      stats.update(sample(i));
+      doNotOptimise(stats.getVariance());
+    });
+    report(name, nanos, "ns/update");
+  }
+};
+
+TEST_F(StatisticsBenchmark, update)
+{
+  ListRollingStatistics<data::NavigationVector> list_stats(kWindowSize);
+  update("RollingStatistics list", list_stats);
+  utils::math::RollingStatistics<data::NavigationVector> ring_stats(kWindowSize);
+  update("RollingStatistics ring", ring_stats);
+  // too large for the stack
+  auto fixed_stats
+    = std::make_unique<utils::math::FixedRollingStatistics<data::NavigationVector, kWindowSize>>();
+  update("FixedRollingStatistics", *fixed_stats);
+}
+
+/**
+ * One calibration attempt as done by Navigation::calibrateGravity: construct one window per IMU and
+ * fill it, without the sleeps between queries.
+ */
+TEST_F(StatisticsBenchmark, calibration)
+{
+  const auto list_nanos = nanosPerIteration(10, [&](uint64_t) {
+    for (std::size_t imu = 0; imu < data::Sensors::kNumImus; ++imu) {
+      ListRollingStatistics<data::NavigationVector> stats(kWindowSize);
+      for (uint64_t i = 0; i < kWindowSize; ++i) {
+        stats.update(sample(i));
+      }
+      doNotOptimise(stats.getVariance());
+    }
+  });
+  report("Calibration list", list_nanos / 1e3, "us");
+  const auto ring_nanos = nanosPerIteration(10, [&](uint64_t) {
+    for (std::size_t imu = 0; imu < data::Sensors::kNumImus; ++imu) {
+      utils::math::RollingStatistics<data::NavigationVector> stats(kWindowSize);
+      for (uint64_t i = 0; i < kWindowSize; ++i) {
+        stats.update(sample(i));
+      }
+      doNotOptimise(stats.getVariance());
+    }
+  });
+  report("Calibration ring", ring_nanos / 1e3, "us");
+}
+
+}  // namespace hyped::benchmarking
@@ -8,11 +8,18 @@
 #include <sensors/main.hpp>
 #include <state_machine/main.hpp>
 #include <telemetry/main.hpp>
+#include <utils/async_logger.hpp>
 #include <utils/system.hpp>
 
 int main(int argc, char *argv[])
 {
   hyped::utils::System::parseArgs(argc, argv);
+  // move log output off the calling threads before any of them start
+  hyped::utils::AsyncLogger async_logger;
+  if (hyped::utils::System::getSystem().config_.use_async_logging) {
+    async_logger.start();
+    hyped::utils::Logger::setAsyncLogger(&async_logger);
+  }
   // print HYPED logo at system startup
   std::ifstream file("main_logo.txt");
   if (file.is_open()) {
@@ -45,5 +52,7 @@ int main(int argc, char *argv[])
   state_machine.join();
   telemetry.join();
 
+  hyped::utils::Logger::setAsyncLogger(nullptr);
+  async_logger.stop();
   return 0;
 }
@@ -102,6 +102,7 @@ void Main::run()
 
   log_.info("Thread started");
 
+  uint64_t state_machine_version = data_.getVersion(data::Substructure::kStateMachine);
   while (sys_.isRunning()) {
     // Get the current state of brakes, state machine and telemetry modules from data
     brakes_data_             = data_.getBrakesData();
@@ -140,6 +141,8 @@ void Main::run()
         engageAndCheck();
         break;
     }
+    state_machine_version = data_.waitForUpdate(data::Substructure::kStateMachine,
+                                                state_machine_version, kCheckPeriodMillis);
   }
   log_.info("Thread shutting down");
 }
@@ -25,6 +25,9 @@ class Main : public utils::concurrent::Thread {
    */
   Main();
 
+  // upper bound on how long we wait for a state change before polling the brakes again
+  static constexpr uint32_t kCheckPeriodMillis = 10;
+
   /*
    * @brief Checks for State kCalibrating to start retracting process
    */
@@ -1,10 +1,8 @@
 #include "data.hpp"
 
-namespace hyped {
-
-// imports
-using utils::concurrent::ScopedLock;
+#include <utils/timer.hpp>
 
+namespace hyped {
 namespace data {
 
 static const std::unordered_map<State, std::string> state_names = {
@@ -63,110 +61,179 @@ Data &Data::getInstance()
 
 StateMachine Data::getStateMachineData()
 {
-  ScopedLock L(&lock_state_machine_);
-  return state_machine_;
+  return state_machine_.load();
 }
 
 void Data::setStateMachineData(const StateMachine &sm_data)
 {
-  ScopedLock L(&lock_state_machine_);
-  state_machine_ = sm_data;
+  state_machine_.store(sm_data);
+  notifyUpdate(Substructure::kStateMachine);
 }
 
 Navigation Data::getNavigationData()
 {
-  ScopedLock L(&lock_navigation_);
-  return navigation_;
+  return navigation_.load();
 }
 
 void Data::setNavigationData(const Navigation &nav_data)
 {
-  ScopedLock L(&lock_navigation_);
-  navigation_ = nav_data;
+  navigation_.store(nav_data);
+  notifyUpdate(Substructure::kNavigation);
 }
 
 Sensors Data::getSensorsData()
 {
-  ScopedLock L(&lock_sensors_);
-  return sensors_;
+  return sensors_.load();
 }
 
 DataPoint<std::array<ImuData, Sensors::kNumImus>> Data::getSensorsImuData()
 {
-  ScopedLock L(&lock_sensors_);
-  return sensors_.imu;
+  return sensors_.read([](const Sensors &sensors) { return sensors.imu; });
 }
 
 std::array<CounterData, Sensors::kNumEncoders> Data::getSensorsWheelEncoderData()
 {
-  ScopedLock L(&lock_sensors_);
-  return sensors_.wheel_encoders;
+  return sensors_.read([](const Sensors &sensors) { return sensors.wheel_encoders; });
 }
 
 void Data::setSensorsData(const Sensors &sensors_data)
 {
-  ScopedLock L(&lock_sensors_);
-  sensors_ = sensors_data;
+  sensors_.store(sensors_data);
+  notifyUpdate(Substructure::kSensors);
 }
 
 void Data::setSensorsImuData(const DataPoint<std::array<ImuData, Sensors::kNumImus>> &imu)
 {
-  ScopedLock L(&lock_sensors_);
-  sensors_.imu = imu;
+  sensors_.write([&imu](Sensors &sensors) { sensors.imu = imu; });
+  notifyUpdate(Substructure::kSensors);
 }
 
 void Data::setSensorsWheelEncoderData(const std::array<CounterData, Sensors::kNumEncoders> &encoder)
 {
-  ScopedLock L(&lock_sensors_);
-  sensors_.wheel_encoders = encoder;
+  sensors_.write([&encoder](Sensors &sensors) { sensors.wheel_encoders = encoder; });
+  notifyUpdate(Substructure::kSensors);
 }
 
 FullBatteryData Data::getBatteriesData()
 {
-  ScopedLock L(&lock_batteries_);
-  return batteries_;
+  return batteries_.load();
 }
 
 void Data::setBatteriesData(const FullBatteryData &batteries_data)
 {
-  ScopedLock L(&lock_batteries_);
-  batteries_ = batteries_data;
+  batteries_.store(batteries_data);
+  notifyUpdate(Substructure::kBatteries);
 }
 
 Brakes Data::getBrakesData()
 {
-  ScopedLock L(&lock_brakes_);
-  return brakes_;
+  return brakes_.load();
 }
 
 void Data::setBrakesData(const Brakes &brakes_data)
 {
-  ScopedLock L(&lock_brakes_);
-  brakes_ = brakes_data;
+  brakes_.store(brakes_data);
+  notifyUpdate(Substructure::kBrakes);
 }
 
 Motors Data::getMotorData()
 {
-  ScopedLock L(&lock_motors_);
-  return motors_;
+  return motors_.load();
 }
 
 void Data::setMotorData(const Motors &motor_data)
 {
-  ScopedLock L(&lock_motors_);
-  motors_ = motor_data;
+  motors_.store(motor_data);
+  notifyUpdate(Substructure::kMotors);
 }
 
 Telemetry Data::getTelemetryData()
 {
-  ScopedLock L(&lock_telemetry_);
-  return telemetry_;
+  return telemetry_.load();
 }
 
 void Data::setTelemetryData(const Telemetry &telemetry_data)
 {
-  ScopedLock L(&lock_telemetry_);
-  telemetry_ = telemetry_data;
+  telemetry_.store(telemetry_data);
+  notifyUpdate(Substructure::kTelemetry);
+}
+
+uint64_t Data::getVersion(const Substructure substructure) const
+{
+  switch (substructure) {
+    case Substructure::kStateMachine:
+      return state_machine_.getVersion();
+    case Substructure::kNavigation:
+      return navigation_.getVersion();
+    case Substructure::kSensors:
+      return sensors_.getVersion();
+    case Substructure::kMotors:
+      return motors_.getVersion();
+    case Substructure::kBatteries:
+      return batteries_.getVersion();
+    case Substructure::kTelemetry:
+      return telemetry_.getVersion();
+    case Substructure::kBrakes:
+      return brakes_.getVersion();
+  }
+  return 0;
+}
+
+uint64_t Data::getVersion() const
+{
+  return state_machine_.getVersion() + navigation_.getVersion() + sensors_.getVersion()
+         + motors_.getVersion() + batteries_.getVersion() + telemetry_.getVersion()
+         + brakes_.getVersion();
+}
+
+template<typename GetVersion>
+uint64_t Data::waitForVersion(UpdateSignal &signal, GetVersion get_version,
+                              const uint64_t since_version, const uint32_t timeout_millis)
+{
+  const uint64_t deadline = utils::Timer::getTimeMicros() + timeout_millis * 1000ull;
+  utils::concurrent::ScopedLock L(&signal.lock);
+  ++signal.num_waiters;
+  // pairs with the fence in notifyUpdate so that either we see the new version or the writer
+  // sees us waiting
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  uint64_t version = get_version();
+  while (version <= since_version) {
+    const uint64_t now = utils::Timer::getTimeMicros();
+    if (now >= deadline) { break; }
+    signal.cv.waitFor(&signal.lock, deadline - now);
+    version = get_version();
+  }
+  --signal.num_waiters;
+  return version;
+}
+
+uint64_t Data::waitForUpdate(const Substructure substructure, const uint64_t since_version,
+                             const uint32_t timeout_millis)
+{
+  return waitForVersion(update_signals_[static_cast<std::size_t>(substructure)],
+                        [this, substructure]() { return getVersion(substructure); },
+                        since_version, timeout_millis);
+}
+
+uint64_t Data::waitForUpdate(const uint64_t since_version, const uint32_t timeout_millis)
+{
+  return waitForVersion(update_signals_[kNumSubstructures], [this]() { return getVersion(); },
+                        since_version, timeout_millis);
+}
+
+void Data::notifyUpdate(const Substructure substructure)
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  notify(update_signals_[static_cast<std::size_t>(substructure)]);
+  notify(update_signals_[kNumSubstructures]);
+}
+
+void Data::notify(UpdateSignal &signal)
+{
+  if (signal.num_waiters.load(std::memory_order_relaxed) == 0) { return; }
+  // taking the lock guarantees that no waiter is between checking the version and blocking
+  utils::concurrent::ScopedLock L(&signal.lock);
+  signal.cv.notifyAll();
 }
 
 }  // namespace data
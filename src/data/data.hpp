@@ -3,12 +3,16 @@
 #include "data_point.hpp"
 
 #include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
-#include <utils/concurrent/lock.hpp>
+#include <utils/concurrent/condition_variable.hpp>
+#include <utils/concurrent/seqlock.hpp>
 #include <utils/math/vector.hpp>
 
 namespace hyped::data {
@@ -55,8 +59,12 @@ struct SensorData {
 };
 
 struct ImuData : public SensorData {
+  // FIFO samples carried per read; anything beyond this stays in the IMU's hardware FIFO
+  static constexpr size_t kFifoCapacity = 16;
   NavigationVector acc;
-  std::vector<NavigationVector> fifo;
+  std::array<NavigationVector, kFifoCapacity> fifo;
+  size_t fifo_size   = 0;  // number of valid samples at the front of fifo
+  uint64_t timestamp = 0;  // micros at which this IMU was read, see ImuManager::sample
 };
 
 struct CounterData : public DataPoint<uint32_t>, public SensorData {
@@ -93,6 +101,8 @@ struct Sensors : public Module {
 
   bool high_power_off = false;  // true if all SSRs are not in HP
 };
+// sensor snapshots are copied at IMU rate and must not own heap memory
+static_assert(std::is_trivially_copyable_v<Sensors>);
 
 struct BatteryData {
   static constexpr size_t kNumCells = 36;
@@ -179,6 +189,16 @@ struct StateMachine {
 // -------------------------------------------------------------------------------------------------
 // Common Data structure/class
 // -------------------------------------------------------------------------------------------------
+enum class Substructure {
+  kStateMachine,
+  kNavigation,
+  kSensors,
+  kMotors,
+  kBatteries,
+  kTelemetry,
+  kBrakes,
+};
+
 /**
  * @brief      A singleton class managing the data exchange between sub-team
  * threads.
@@ -280,24 +300,59 @@ class Data {
    */
   void setTelemetryData(const Telemetry &telemetry_data);
 
+  /**
+   * @brief      Number of completed updates to the given substructure. Monotonically increasing.
+   */
+  uint64_t getVersion(const Substructure substructure) const;
+
+  /**
+   * @brief      Number of completed updates to any substructure. Monotonically increasing.
+   */
+  uint64_t getVersion() const;
+
+  /**
+   * @brief      Blocks until the given substructure has been updated past `since_version` or
+   *             until `timeout_millis` have passed, whichever happens first.
+   *
+   * @return     The current version of the substructure. On timeout this equals `since_version`.
+   */
+  uint64_t waitForUpdate(const Substructure substructure, const uint64_t since_version,
+                         const uint32_t timeout_millis);
+
+  /**
+   * @brief      Same as above but wakes up on an update to any substructure.
+   */
+  uint64_t waitForUpdate(const uint64_t since_version, const uint32_t timeout_millis);
+
  private:
-  StateMachine state_machine_;
-  Navigation navigation_;
-  Sensors sensors_;
-  Motors motors_;
-  FullBatteryData batteries_;
-  Telemetry telemetry_;
-  Brakes brakes_;
-
-  // locks for data substructures
-  utils::concurrent::Lock lock_state_machine_;
-  utils::concurrent::Lock lock_navigation_;
-  utils::concurrent::Lock lock_sensors_;
-  utils::concurrent::Lock lock_motors_;
-
-  utils::concurrent::Lock lock_telemetry_;
-  utils::concurrent::Lock lock_batteries_;
-  utils::concurrent::Lock lock_brakes_;
+  // each substructure is guarded by its own sequence lock so that readers never block writers
+  utils::concurrent::SeqLock<StateMachine> state_machine_;
+  utils::concurrent::SeqLock<Navigation> navigation_;
+  utils::concurrent::SeqLock<Sensors> sensors_;
+  utils::concurrent::SeqLock<Motors> motors_;
+  utils::concurrent::SeqLock<FullBatteryData> batteries_;
+  utils::concurrent::SeqLock<Telemetry> telemetry_;
+  utils::concurrent::SeqLock<Brakes> brakes_;
+
+  // kBrakes is the last substructure
+  static constexpr std::size_t kNumSubstructures
+    = static_cast<std::size_t>(Substructure::kBrakes) + 1;
+
+  // wakes up threads blocked in waitForUpdate; only signalled while somebody is waiting
+  struct UpdateSignal {
+    std::atomic<uint32_t> num_waiters = 0;
+    utils::concurrent::Lock lock;
+    utils::concurrent::ConditionVariable cv;
+  };
+  // one per substructure, followed by the one for waiters on any substructure
+  std::array<UpdateSignal, kNumSubstructures + 1> update_signals_;
+
+  void notifyUpdate(const Substructure substructure);
+  static void notify(UpdateSignal &signal);
+
+  template<typename GetVersion>
+  static uint64_t waitForVersion(UpdateSignal &signal, GetVersion get_version,
+                                 const uint64_t since_version, const uint32_t timeout_millis);
 
   Data() {}
 
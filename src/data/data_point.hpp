@@ -13,9 +13,9 @@ class DataPoint {
   /*
    * Initialises this DataPoint with the specified timestamp and value.
    */
-  DataPoint(uint32_t timestamp, const T &value) : timestamp(timestamp), value(value) {}
+  DataPoint(uint64_t timestamp, const T &value) : timestamp(timestamp), value(value) {}
 
-  uint32_t timestamp;
+  uint64_t timestamp;
   T value;
 };
 
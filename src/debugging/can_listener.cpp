@@ -4,6 +4,8 @@
 
 namespace hyped::debugging {
 
+namespace can = utils::io::can;
+
 CanListener::CanListener() : log_("CAN-LISTENER", utils::System::getSystem().config_.log_level)
 {
 }
@@ -15,19 +17,10 @@ void CanListener::processNewData(utils::io::can::Frame &message)
             message.data[3], message.data[4], message.data[5], message.data[6], message.data[7]);
 }
 
-bool CanListener::hasId(uint32_t id, bool extended)
-{
-  if (extended) {
-    log_.debug("received extended CAN message; skipping");
-    return false;
-  }
-
-  return ids_.find(id) != ids_.end(); 
-}
-
 void CanListener::subscribe(const uint32_t id)
 {
-  ids_.insert(id);
+  if (!ids_.insert(id).second) { return; }
+  utils::io::Can::getInstance().registerProcessor(this, can::IdRange::exact(id, false));
 }
 
 void CanListener::unsubscribe(const uint32_t id)
@@ -37,6 +30,7 @@ void CanListener::unsubscribe(const uint32_t id)
     return;
   }
   ids_.erase(id);
+  utils::io::Can::getInstance().unregisterProcessor(this, can::IdRange::exact(id, false));
 }
 
 }  // namespace hyped::debugging
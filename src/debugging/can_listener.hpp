@@ -11,7 +11,6 @@ class CanListener : public utils::io::ICanProcessor {
  public:
   CanListener();
   void processNewData(utils::io::can::Frame &message) override;
-  bool hasId(uint32_t id, bool extended) override;
   void subscribe(const uint32_t id);
   void unsubscribe(const uint32_t id);
 
@@ -113,12 +113,12 @@ std::optional<std::unique_ptr<Observer>> Observer::fromFile(const std::string &p
       observer->addImuManagerTask(imu_pins);
     }
   } else {  // use individual IMUs
-    log.debug("adding imu tasks");
+    LOG_DEBUG(log, "adding imu tasks");
     for (const auto imu_pin : *imu_pin_vector) {
       observer->addImuTask(imu_pin);
     }
     if (fake_trajectory) {
-      log.debug("adding fake imu tasks");
+      LOG_DEBUG(log, "adding fake imu tasks");
       auto fake_imus = sensors::FakeImu::fromFile(path, fake_trajectory);
       if (fake_imus) { observer->addFakeImuTasks(std::move(*fake_imus)); }
     }
@@ -223,6 +223,8 @@ void Observer::addImuManagerTask(const sensors::ImuPins &imu_pins)
       json_writer.StartObject();
       json_writer.Key("operational");
       json_writer.Bool(imu.operational);
+      json_writer.Key("timestamp");
+      json_writer.Uint64(imu.timestamp);
       json_writer.Key("acceleration");
       json_writer.StartArray();
       json_writer.Double(imu.acc[0]);
@@ -258,6 +260,8 @@ void Observer::addFakeImuManagerTask(std::shared_ptr<sensors::FakeTrajectory> fa
       json_writer.StartObject();
       json_writer.Key("operational");
       json_writer.Bool(imu.operational);
+      json_writer.Key("timestamp");
+      json_writer.Uint64(imu.timestamp);
       json_writer.Key("acceleration");
       json_writer.StartArray();
       json_writer.Double(imu.acc[0]);
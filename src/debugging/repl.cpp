@@ -255,8 +255,7 @@ void Repl::addDirectCanCommands()
     can_subscribe_command.identifier  = "can subscribe";
     can_subscribe_command.description = "Subscribe to a node_id on the base CAN bus";
     const auto can_listener           = std::make_shared<CanListener>();
-    can.registerProcessor(can_listener.get());
-    can_subscribe_command.handler = [this, can_listener]() {
+    can_subscribe_command.handler     = [this, can_listener]() {
       std::cout << "CAN id (e.g. `3fx'):" << std::endl;
       uint32_t node_id;
       std::cin >> std::hex >> node_id;
@@ -11,48 +11,41 @@ constexpr float KalmanFilter::kTrackMeasurementVariance;
 constexpr float KalmanFilter::kElevatorMeasurementVariance;
 constexpr float KalmanFilter::kStationaryMeasurementVariance;
 
-KalmanFilter::KalmanFilter(uint32_t n /*=3*/, uint32_t m /*=1*/, uint32_t k /*=0*/)
-    : n_(n),
-      m_(m),
-      k_(k),
-      kalmanFilter_(utils::math::KalmanMultivariate(n, m, k))
+KalmanFilter::KalmanFilter()
 {
 }
 
 void KalmanFilter::setup()
 {
   // setup dynamics & measurement models for stationary test
-  Eigen::MatrixXf A = createStateTransitionMatrix(0.0);
-  Eigen::MatrixXf Q = createStateTransitionCovarianceMatrix();
-  Eigen::MatrixXf H = createMeasurementMatrix();
+  const Filter::StateMatrix A       = createStateTransitionMatrix(0.0);
+  const Filter::StateMatrix Q       = createStateTransitionCovarianceMatrix();
+  const Filter::MeasurementMatrix H = createMeasurementMatrix();
 
   // check system navigation run for R setup
-  Eigen::MatrixXf R;
-  R = createTrackMeasurementCovarianceMatrix();
+  const Filter::MeasurementCovarianceMatrix R = createTrackMeasurementCovarianceMatrix();
 
   kalmanFilter_.setModels(A, Q, H, R);
 
   // setup initial estimates
-  Eigen::VectorXf x = Eigen::VectorXf::Zero(n_);
-  Eigen::MatrixXf P = createInitialErrorCovarianceMatrix();
+  const Filter::StateVector x = Filter::StateVector::Zero();
+  const Filter::StateMatrix P = createInitialErrorCovarianceMatrix();
   kalmanFilter_.setInitial(x, P);
 }
 
 void KalmanFilter::updateStateTransitionMatrix(const data::nav_t dt)
 {
-  Eigen::MatrixXf A = createStateTransitionMatrix(dt);
-  kalmanFilter_.updateA(A);
+  kalmanFilter_.updateA(createStateTransitionMatrix(dt));
 }
 
 void KalmanFilter::updateMeasurementCovarianceMatrix(const data::nav_t var)
 {
-  Eigen::MatrixXf R = Eigen::MatrixXf::Constant(m_, m_, var);
-  kalmanFilter_.updateR(R);
+  kalmanFilter_.updateR(Filter::MeasurementCovarianceMatrix::Constant(var));
 }
 
 data::nav_t KalmanFilter::filter(const data::nav_t z)
 {
-  Eigen::VectorXf vz(m_);
+  Filter::MeasurementVector vz;
   vz(0) = z;
   kalmanFilter_.filter(vz);
 
@@ -60,17 +53,18 @@ data::nav_t KalmanFilter::filter(const data::nav_t z)
   return estimate;
 }
 
-const Eigen::MatrixXf KalmanFilter::createInitialErrorCovarianceMatrix() const
+const KalmanFilter::Filter::StateMatrix KalmanFilter::createInitialErrorCovarianceMatrix() const
 {
-  Eigen::MatrixXf P = Eigen::MatrixXf::Constant(n_, n_, kInitialErrorVariance);
+  Filter::StateMatrix P = Filter::StateMatrix::Constant(kInitialErrorVariance);
   return P;
 }
 
 // TODO: (Max) look into kalman filter and look at what's happening here exactly
-Eigen::MatrixXf KalmanFilter::createStateTransitionMatrix(const data::nav_t dt) const
+KalmanFilter::Filter::StateMatrix KalmanFilter::createStateTransitionMatrix(
+  const data::nav_t dt) const
 {
-  Eigen::MatrixXf A   = Eigen::MatrixXf::Zero(n_, n_);
-  data::nav_t acc_ddt = 0.5 * dt * dt;
+  Filter::StateMatrix A = Filter::StateMatrix::Zero();
+  data::nav_t acc_ddt   = 0.5 * dt * dt;
   //  number of values for each acc, vel, pos: usually 1 or 3
   uint32_t num_values = n_ / 3;
 
@@ -92,49 +86,56 @@ Eigen::MatrixXf KalmanFilter::createStateTransitionMatrix(const data::nav_t dt)
   return A;
 }
 
-Eigen::MatrixXf KalmanFilter::createMeasurementMatrix() const
+KalmanFilter::Filter::MeasurementMatrix KalmanFilter::createMeasurementMatrix() const
 {
-  Eigen::MatrixXf H = Eigen::MatrixXf::Zero(m_, n_);
+  Filter::MeasurementMatrix H = Filter::MeasurementMatrix::Zero();
   for (std::size_t i = 0; i < m_; ++i) {
     H(i, i) = 1.;
   }
   return H;
 }
 
-const Eigen::MatrixXf KalmanFilter::createStateTransitionCovarianceMatrix() const
+const KalmanFilter::Filter::StateMatrix KalmanFilter::createStateTransitionCovarianceMatrix()
+  const
 {
-  Eigen::MatrixXf Q = Eigen::MatrixXf::Constant(n_, n_, kStateTransitionVariance);
+  Filter::StateMatrix Q = Filter::StateMatrix::Constant(kStateTransitionVariance);
   return Q;
 }
 
-const Eigen::MatrixXf KalmanFilter::createTrackMeasurementCovarianceMatrix() const
+const KalmanFilter::Filter::MeasurementCovarianceMatrix
+KalmanFilter::createTrackMeasurementCovarianceMatrix() const
 {
-  Eigen::MatrixXf R = Eigen::MatrixXf::Constant(m_, m_, kTrackMeasurementVariance);
+  Filter::MeasurementCovarianceMatrix R
+    = Filter::MeasurementCovarianceMatrix::Constant(kTrackMeasurementVariance);
   return R;
 }
-const Eigen::MatrixXf KalmanFilter::createElevatorMeasurementCovarianceMatrix() const
+const KalmanFilter::Filter::MeasurementCovarianceMatrix
+KalmanFilter::createElevatorMeasurementCovarianceMatrix() const
 {
-  Eigen::MatrixXf R = Eigen::MatrixXf::Constant(m_, m_, kElevatorMeasurementVariance);
+  Filter::MeasurementCovarianceMatrix R
+    = Filter::MeasurementCovarianceMatrix::Constant(kElevatorMeasurementVariance);
   return R;
 }
 
-const Eigen::MatrixXf KalmanFilter::createStationaryMeasurementCovarianceMatrix() const
+const KalmanFilter::Filter::MeasurementCovarianceMatrix
+KalmanFilter::createStationaryMeasurementCovarianceMatrix() const
 {
-  Eigen::MatrixXf R = Eigen::MatrixXf::Constant(m_, m_, kStationaryMeasurementVariance);
+  Filter::MeasurementCovarianceMatrix R
+    = Filter::MeasurementCovarianceMatrix::Constant(kStationaryMeasurementVariance);
   return R;
 }
 
 data::nav_t KalmanFilter::getEstimate()
 {
-  Eigen::VectorXf x    = kalmanFilter_.getStateEstimate();
-  data::nav_t estimate = x(0);
+  const Filter::StateVector &x = kalmanFilter_.getStateEstimate();
+  data::nav_t estimate         = x(0);
   return estimate;
 }
 
 data::nav_t KalmanFilter::getEstimateVariance()
 {
-  Eigen::MatrixXf P      = kalmanFilter_.getStateCovariance();
-  data::nav_t covariance = P(0, 0);
+  const Filter::StateMatrix &P = kalmanFilter_.getStateCovariance();
+  data::nav_t covariance       = P(0, 0);
   return covariance;
 }
 
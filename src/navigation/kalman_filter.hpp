@@ -12,7 +12,13 @@ namespace navigation {
 
 class KalmanFilter {
  public:
-  KalmanFilter(uint32_t n = 3, uint32_t m = 1, uint32_t k = 0);
+  // each IMU is filtered on its own along the movement axis
+  static constexpr uint32_t kStateDimension       = 1;
+  static constexpr uint32_t kMeasurementDimension = 1;
+
+  using Filter = utils::math::KalmanMultivariate<kStateDimension, kMeasurementDimension>;
+
+  KalmanFilter();
   void setup();
   void updateStateTransitionMatrix(data::nav_t dt);
   void updateMeasurementCovarianceMatrix(const data::nav_t var);
@@ -23,13 +29,9 @@ class KalmanFilter {
   data::nav_t getEstimateVariance();
 
  private:
-  // state dimensionality
-  uint32_t n_;
-  // measurement dimensionality
-  uint32_t m_;
-  // control dimensionality default = 0
-  uint32_t k_;
-  utils::math::KalmanMultivariate kalmanFilter_;
+  static constexpr uint32_t n_ = kStateDimension;
+  static constexpr uint32_t m_ = kMeasurementDimension;
+  Filter kalmanFilter_;
 
   // covariance matrix variances
   static constexpr float kInitialErrorVariance          = 0.5;
@@ -39,21 +41,21 @@ class KalmanFilter {
   static constexpr float kStationaryMeasurementVariance = 0.04;
 
   // create initial error covariance matrix P
-  const Eigen::MatrixXf createInitialErrorCovarianceMatrix() const;
+  const Filter::StateMatrix createInitialErrorCovarianceMatrix() const;
 
   // create state transition matrix A
-  Eigen::MatrixXf createStateTransitionMatrix(data::nav_t dt) const;
+  Filter::StateMatrix createStateTransitionMatrix(data::nav_t dt) const;
 
   // create measurement matrix H
-  Eigen::MatrixXf createMeasurementMatrix() const;
+  Filter::MeasurementMatrix createMeasurementMatrix() const;
 
   // create state transition coveriance matrix Q
-  const Eigen::MatrixXf createStateTransitionCovarianceMatrix() const;
+  const Filter::StateMatrix createStateTransitionCovarianceMatrix() const;
 
   // create measurement covariance matrices R
-  const Eigen::MatrixXf createTrackMeasurementCovarianceMatrix() const;
-  const Eigen::MatrixXf createElevatorMeasurementCovarianceMatrix() const;
-  const Eigen::MatrixXf createStationaryMeasurementCovarianceMatrix() const;
+  const Filter::MeasurementCovarianceMatrix createTrackMeasurementCovarianceMatrix() const;
+  const Filter::MeasurementCovarianceMatrix createElevatorMeasurementCovarianceMatrix() const;
+  const Filter::MeasurementCovarianceMatrix createStationaryMeasurementCovarianceMatrix() const;
 };
 }  // namespace navigation
 }  // namespace hyped
\ No newline at end of file
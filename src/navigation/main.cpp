@@ -25,6 +25,8 @@ void Main::run()
   data.setNavigationData(nav_data);
 
   // wait for calibration state for calibration
+  uint64_t state_machine_version = data.getVersion(data::Substructure::kStateMachine);
+  uint64_t sensors_version       = data.getVersion(data::Substructure::kSensors);
   while (system.isRunning() && !navigation_complete) {
     const auto current_state = data.getStateMachineData().current_state;
 
@@ -33,9 +35,16 @@ void Main::run()
       case data::State::kPreReady:
       case data::State::kReady:
       case data::State::kPreCalibrating:
+        state_machine_version = data.waitForUpdate(data::Substructure::kStateMachine,
+                                                   state_machine_version, kUpdateTimeoutMillis);
         break;
       case data::State::kCalibrating:
-        if (nav_.getModuleStatus() == data::ModuleStatus::kInit) { nav_.calibrateGravity(); }
+        if (nav_.getModuleStatus() == data::ModuleStatus::kInit) {
+          nav_.calibrateGravity();
+        } else {
+          state_machine_version = data.waitForUpdate(data::Substructure::kStateMachine,
+                                                     state_machine_version, kUpdateTimeoutMillis);
+        }
         break;
       case data::State::kAccelerating:
         if (!nav_.getHasInit()) {
@@ -43,6 +52,9 @@ void Main::run()
           nav_.setHasInit();
         }
         nav_.navigate();
+        // navigating again before new sensor data has arrived would process the same sample twice
+        sensors_version = data.waitForUpdate(data::Substructure::kSensors, sensors_version,
+                                             kUpdateTimeoutMillis);
         break;
       case data::State::kPreBraking:
       case data::State::kNominalBraking:
@@ -50,6 +62,8 @@ void Main::run()
       case data::State::kFailurePreBraking:
       case data::State::kFailureBraking:
         nav_.navigate();
+        sensors_version = data.waitForUpdate(data::Substructure::kSensors, sensors_version,
+                                             kUpdateTimeoutMillis);
         break;
       case data::State::kFailureStopped:
       case data::State::kFinished:
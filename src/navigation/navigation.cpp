@@ -1,13 +1,51 @@
 #include "navigation.hpp"
 
 #include <algorithm>
-#include <vector>
+#include <cinttypes>
+#include <limits>
 
 #include <utils/concurrent/thread.hpp>
+#include <utils/math/sorting_network.hpp>
 #include <utils/timer.hpp>
 
 namespace hyped::navigation {
 
+namespace {
+
+/**
+ * @brief Sorts the reliable readings to the front of the returned array. Unreliable readings are
+ *        replaced by the largest representable value first so that they end up at the back.
+ */
+template<typename T, std::size_t N>
+std::array<T, N> sortReliable(const std::array<T, N> &values,
+                              const std::array<bool, N> &is_reliable)
+{
+  std::array<T, N> sorted_values;
+  for (std::size_t i = 0; i < N; ++i) {
+    sorted_values[i] = is_reliable[i] ? values[i] : std::numeric_limits<T>::max();
+  }
+  utils::math::sortingNetwork(sorted_values);
+  return sorted_values;
+}
+
+template<std::size_t N>
+std::size_t countReliable(const std::array<bool, N> &is_reliable)
+{
+  return static_cast<std::size_t>(std::count(is_reliable.begin(), is_reliable.end(), true));
+}
+
+/**
+ * @brief Mean of two readings. Widened before adding so that two large encoder readings cannot
+ *        overflow.
+ */
+template<typename T>
+data::nav_t midpoint(const T lower, const T upper)
+{
+  return static_cast<data::nav_t>((static_cast<double>(lower) + static_cast<double>(upper)) / 2.);
+}
+
+}  // namespace
+
 Navigation::Navigation(const std::uint32_t axis /*=0*/)
     : data_(data::Data::getInstance()),
       log_("NAVIGATION", utils::System::getSystem().config_.log_level_navigation),
@@ -15,7 +53,6 @@ Navigation::Navigation(const std::uint32_t axis /*=0*/)
       log_counter_(0),
       movement_axis_(axis),
       calibration_limits_{{0.05, 0.05, 0.05}},
-      current_measurements_(0),
       is_imu_reliable_{{true, true, true, true}},
       num_outlier_imus_(0),
       imu_outlier_counter_{{0, 0, 0, 0}},
@@ -32,9 +69,8 @@ Navigation::Navigation(const std::uint32_t axis /*=0*/)
       velocity_integrator_(&displacement_)
 {
   log_.info("Navigation module started");
-  for (std::size_t i = 0; i < data::Sensors::kNumImus; ++i) {
-    filters_[i] = KalmanFilter(1, 1);
-    filters_[i].setup();
+  for (auto &filter : filters_) {
+    filter.setup();
   }
   status_ = data::ModuleStatus::kInit;
   updateData();
@@ -201,7 +237,8 @@ void Navigation::queryWheelEncoders()
   const auto encoder_data = data_.getSensorsWheelEncoderData();
 
   EncoderArray encoder_data_array;
-  uint32_t sum = 0;
+  // widened so that the sum of the encoder readings cannot overflow
+  uint64_t sum = 0;
   for (size_t i = 0; i < encoder_data.size(); ++i) {
     sum += encoder_data.at(i).value;
     encoder_data_array.at(i) = encoder_data.at(i).value;
@@ -217,8 +254,7 @@ void Navigation::queryImus()
 {
   NavigationArray raw_acceleration_moving;  // Raw values in moving axis
 
-  const auto imu_data                      = data_.getSensorsImuData();
-  const uint64_t current_trajectory_micros = imu_data.timestamp;
+  const auto imu_data = data_.getSensorsImuData();
   // process raw values
   ImuAxisData raw_acceleration;  // All raw data, four values per axis
   for (std::size_t i = 0; i < data::Sensors::kNumImus; ++i) {
@@ -230,8 +266,8 @@ void Navigation::queryImus()
     if (!is_imu_reliable_.at(i)) { raw_acceleration_moving.at(i) = 0; }
     raw_acceleration_moving.at(i) = acceleration[movement_axis_];
   }
-  log_.debug("Raw acceleration values: %.3f, %.3f, %.3f, %.3f", raw_acceleration_moving[0],
-             raw_acceleration_moving[1], raw_acceleration_moving[2], raw_acceleration_moving[3]);
+  LOG_DEBUG(log_, "Raw acceleration values: %.3f, %.3f, %.3f, %.3f", raw_acceleration_moving[0],
+            raw_acceleration_moving[1], raw_acceleration_moving[2], raw_acceleration_moving[3]);
   // Run outlier detection on moving axis
   imuOutlierDetection(raw_acceleration_moving);
   // TODO(Justus) how to run outlier detection on non-moving axes without affecting "reliable"
@@ -239,22 +275,23 @@ void Navigation::queryImus()
 
   // Kalman filter the readings which are reliable
   utils::math::OnlineStatistics<data::nav_t> acceleration_average_filter;
+  // the IMUs are read one after another, so the average is stamped with the mean of the times at
+  // which the IMUs contributing to it were read
+  uint64_t timestamp_sum   = 0;
+  std::size_t num_reliable = 0;
   for (std::size_t i = 0; i < data::Sensors::kNumImus; ++i) {
     if (is_imu_reliable_.at(i)) {
       data::nav_t estimate = filters_.at(i).filter(raw_acceleration_moving.at(i));
       acceleration_average_filter.update(estimate);
+      timestamp_sum += imu_data.value.at(i).timestamp;
+      ++num_reliable;
     }
   }
-  previous_measurements_[current_measurements_] = raw_acceleration;
-  current_measurements_++;
-  if (current_measurements_ == kPreviousMeasurements) {
-    current_measurements_ = 0;
-    previous_filled_      = 1;
-  }
-  if (previous_filled_) checkVibration();
+  vibration_statistics_.update(raw_acceleration);
+  if (vibration_statistics_.isFilled()) checkVibration();
 
   acceleration_.value     = acceleration_average_filter.getMean();
-  acceleration_.timestamp = current_trajectory_micros;
+  acceleration_.timestamp = num_reliable > 0 ? timestamp_sum / num_reliable : imu_data.timestamp;
 
   acceleration_integrator_.update(acceleration_);
   velocity_integrator_.update(velocity_);
@@ -276,22 +313,11 @@ void Navigation::compareEncoderImu()
 
 void Navigation::checkVibration()
 {
-  // curr_msmt points at next measurement, ie the last one
-  std::array<utils::math::OnlineStatistics<data::nav_t>, 3> online_array_axis;
-  for (std::size_t i = 0; i < kPreviousMeasurements; ++i) {
-    const auto raw_data
-      = previous_measurements_[(current_measurements_ + i) % kPreviousMeasurements];
-    for (std::size_t axis = 0; axis < 3; ++axis) {
-      if (axis != movement_axis_) {  // assume variance in moving axis are not vibrations
-        for (const auto raw_data_for_imu : raw_data[axis]) {
-          online_array_axis[axis].update(raw_data_for_imu);
-        }
-      }
-    }
-  }
   for (std::size_t axis = 0; axis < 3; ++axis) {
-    const auto variance = online_array_axis[axis].getVariance();
-    if (log_counter_ % 100000 == 0 && axis != movement_axis_) {
+    // assume variance in moving axis are not vibrations
+    if (axis == movement_axis_) { continue; }
+    const auto variance = vibration_statistics_.getVariance(axis);
+    if (log_counter_ % 100000 == 0) {
       log_.info("Variance in axis %d: %.3f", axis, variance);
     }
     const auto ratio                      = variance / calibration_variance_[axis];
@@ -344,22 +370,30 @@ void Navigation::logWrite()
 
 Navigation::QuartileBounds Navigation::calculateImuQuartiles(const NavigationArray &data_array)
 {
-  std::vector<data::nav_t> data_vector;
-  std::array<data::nav_t, 3> quartile_bounds;
-
-  for (size_t i = 0; i < data::Sensors::kNumImus; ++i) {
-    if (is_imu_reliable_.at(i)) { data_vector.push_back(data_array.at(i)); }
+  const NavigationArray sorted_values = sortReliable(data_array, is_imu_reliable_);
+  const std::size_t num_reliable      = countReliable(is_imu_reliable_);
+  if (num_reliable < 2) {
+    // quartiles need two readings, past the reliable ones are only the sentinels of sortReliable
+    status_                       = data::ModuleStatus::kCriticalFailure;
+    auto navigation_data          = data_.getNavigationData();
+    navigation_data.module_status = data::ModuleStatus::kCriticalFailure;
+    data_.setNavigationData(navigation_data);
+    log_.error("Fewer than two IMUs reliable, entering CriticalFailure.");
+    const data::nav_t only_value = num_reliable == 1 ? sorted_values[0] : 0;
+    return {only_value, only_value, only_value};
   }
-  std::sort(data_vector.begin(), data_vector.end());
+  const std::size_t last = num_reliable - 1;
 
-  quartile_bounds.at(0) = (data_vector.at(0) + data_vector.at(1)) / 2.;
-  quartile_bounds.at(2)
-    = (data_vector.at(data_vector.size() - 2) + data_vector.at(data_vector.size() - 1)) / 2.;
+  QuartileBounds quartile_bounds;
+  quartile_bounds[0] = midpoint(sorted_values[0], sorted_values[1]);
+  quartile_bounds[2] = midpoint(sorted_values[last - 1], sorted_values[last]);
   if (num_outlier_imus_ == 0) {
-    quartile_bounds.at(1) = (data_vector.at(1) + data_vector.at(2)) / 2.;
+    quartile_bounds[1] = midpoint(sorted_values[1], sorted_values[2]);
   } else if (num_outlier_imus_ == 1) {
-    quartile_bounds.at(1) = data_vector.at(1);
+    quartile_bounds[1] = sorted_values[1];
   } else {
+    // only two readings remain, so their mean is the median
+    quartile_bounds[1]            = quartile_bounds[0];
     auto navigation_data          = data_.getNavigationData();
     navigation_data.module_status = data::ModuleStatus::kCriticalFailure;
     data_.setNavigationData(navigation_data);
@@ -370,22 +404,29 @@ Navigation::QuartileBounds Navigation::calculateImuQuartiles(const NavigationArr
 
 Navigation::QuartileBounds Navigation::calculateEncoderQuartiles(const EncoderArray &data_array)
 {
-  std::vector<uint32_t> data_vector;
-
-  for (size_t i = 0; i < data::Sensors::kNumEncoders; ++i) {
-    if (is_encoder_reliable_.at(i)) { data_vector.push_back(data_array.at(i)); }
+  const EncoderArray sorted_values = sortReliable(data_array, is_encoder_reliable_);
+  const std::size_t num_reliable   = countReliable(is_encoder_reliable_);
+  if (num_reliable < 2) {
+    status_                       = data::ModuleStatus::kCriticalFailure;
+    auto navigation_data          = data_.getNavigationData();
+    navigation_data.module_status = data::ModuleStatus::kCriticalFailure;
+    data_.setNavigationData(navigation_data);
+    log_.error("Fewer than two Encoders reliable, entering CriticalFailure.");
+    const data::nav_t only_value = num_reliable == 1 ? sorted_values[0] : 0;
+    return {only_value, only_value, only_value};
   }
-  std::sort(data_vector.begin(), data_vector.end());
+  const std::size_t last = num_reliable - 1;
 
-  std::array<data::nav_t, 3> quartile_bounds;
-  quartile_bounds.at(0) = (data_vector.at(0) + data_vector.at(1)) / 2.;
-  quartile_bounds.at(2)
-    = (data_vector.at(data_vector.size() - 2) + data_vector.at(data_vector.size() - 1)) / 2.;
+  QuartileBounds quartile_bounds;
+  quartile_bounds[0] = midpoint(sorted_values[0], sorted_values[1]);
+  quartile_bounds[2] = midpoint(sorted_values[last - 1], sorted_values[last]);
   if (num_outlier_encoders_ == 0) {
-    quartile_bounds.at(1) = (data_vector.at(1) + data_vector.at(2)) / 2.;
+    quartile_bounds[1] = midpoint(sorted_values[1], sorted_values[2]);
   } else if (num_outlier_encoders_ == 1) {
-    quartile_bounds.at(1) = data_vector.at(1);
+    quartile_bounds[1] = sorted_values[1];
   } else {
+    // only two readings remain, so their mean is the median
+    quartile_bounds[1]            = quartile_bounds[0];
     auto navigation_data          = data_.getNavigationData();
     navigation_data.module_status = data::ModuleStatus::kCriticalFailure;
     data_.setNavigationData(navigation_data);
@@ -408,8 +449,9 @@ void Navigation::imuOutlierDetection(NavigationArray &data_array)
   for (std::size_t i = 0; i < data::Sensors::kNumImus; ++i) {
     const bool exceeds_limits = data_array.at(i) < lower_limit || data_array.at(i) > upper_limit;
     if (exceeds_limits && is_imu_reliable_.at(i)) {
-      log_.debug("Outlier detected in IMU %d, reading: %.3f not in [%.3f, %.3f]. Updated to %.3f",
-                 i + 1, data_array.at(i), lower_limit, upper_limit, quartile_bounds.at(1));
+      LOG_DEBUG(log_,
+                "Outlier detected in IMU %d, reading: %.3f not in [%.3f, %.3f]. Updated to %.3f",
+                i + 1, data_array.at(i), lower_limit, upper_limit, quartile_bounds.at(1));
       data_array.at(i) = quartile_bounds.at(1);
       imu_outlier_counter_.at(i)++;
       // If this counter exceeds some threshold then that IMU is deemed unreliable
@@ -441,9 +483,10 @@ void Navigation::wheelEncoderOutlierDetection(EncoderArray &data_array)
   for (std::size_t i = 0; i < data::Sensors::kNumEncoders; ++i) {
     const bool exceeds_limits = data_array.at(i) < lower_limit || data_array.at(i) > upper_limit;
     if (exceeds_limits && is_encoder_reliable_.at(i)) {
-      log_.debug(
-        "Outlier detected in Encoder %d, reading: %.3f not in [%.3f, %.3f]. Updated to %.3f", i + 1,
-        data_array.at(i), lower_limit, upper_limit, quartile_bounds.at(1));
+      LOG_DEBUG(log_,
+                "Outlier detected in Encoder %d, reading: %.3f not in [%.3f, %.3f]. "
+                "Updated to %.3f",
+                i + 1, data_array.at(i), lower_limit, upper_limit, quartile_bounds.at(1));
       data_array.at(i) = quartile_bounds.at(1);
       encoder_outlier_counter_.at(i)++;
       // If this counter exceeds some threshold then that encoder is deemed unreliable
@@ -474,10 +517,10 @@ void Navigation::updateData()
   data_.setNavigationData(nav_data);
 
   if (log_counter_ % 100 == 0) {
-    log_.debug("%d: Data Update: a=%.3f, v=%.3f, d=%.3f", log_counter_, nav_data.acceleration,
-               nav_data.velocity, nav_data.displacement);
-    log_.debug("%d: Data Update: v(unc)=%.3f, d(unc)=%.3f", log_counter_, velocity_uncertainty_,
-               displacement_uncertainty_);
+    LOG_DEBUG(log_, "%d: Data Update: a=%.3f, v=%.3f, d=%.3f", log_counter_,
+              nav_data.acceleration, nav_data.velocity, nav_data.displacement);
+    LOG_DEBUG(log_, "%d: Data Update: v(unc)=%.3f, d(unc)=%.3f", log_counter_,
+              velocity_uncertainty_, displacement_uncertainty_);
   }
   ++log_counter_;
   // Update all prev measurements
@@ -505,7 +548,7 @@ void Navigation::initialiseTimestamps()
   previous_acceleration_       = getImuAcceleration();
   previous_velocity_           = getImuVelocity();
   initial_timestamp_           = initial_timestamp;
-  log_.debug("Initial timestamp:%d", initial_timestamp_);
+  LOG_DEBUG(log_, "Initial timestamp:%" PRIu64, initial_timestamp_);
   previous_timestamp_ = initial_timestamp;
 }
 }  // namespace hyped::navigation
\ No newline at end of file
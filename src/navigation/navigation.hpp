@@ -1,6 +1,7 @@
 #pragma once
 
 #include "kalman_filter.hpp"
+#include "vibration_statistics.hpp"
 
 #include <math.h>
 
@@ -90,7 +91,8 @@ class Navigation {
    */
   void calibrateGravity();
   /**
-   * @brief Calculate quartiles for an array of readings. Updates quartile_bounds array
+   * @brief Calculate quartiles for an array of readings. Sorts the reliable readings with a
+   *        sorting network on the stack, so this neither allocates nor branches on the data.
    *
    * @param pointer to array of original acceleration readings
    *
@@ -98,11 +100,12 @@ class Navigation {
    */
   QuartileBounds calculateImuQuartiles(const NavigationArray &data_array);
   /**
-   * @brief Calculate quartiles for an array of readings. Updates quartile_bounds array
+   * @brief Calculate quartiles for an array of readings. Sorts the reliable readings with a
+   *        sorting network on the stack, so this neither allocates nor branches on the data.
    *
-   * @param pointer to array of original acceleration readings
+   * @param pointer to array of original encoder readings
    *
-   * @return quartiles of reliable IMU readings of form (q1, q2(median), q3)
+   * @return quartiles of reliable encoder readings of form (q1, q2(median), q3)
    */
   QuartileBounds calculateEncoderQuartiles(const EncoderArray &data_array);
   /**
@@ -180,12 +183,8 @@ class Navigation {
   // Calibration variances in each dimension, necessary for vibration checking
   std::array<data::nav_t, data::Sensors::kNumImus> calibration_variance_;
 
-  // Array of previous measurements
-  std::array<ImuAxisData, kPreviousMeasurements> previous_measurements_;
-  // Current point in recent measurements, to save space
-  uint16_t current_measurements_;
-  // Boolean value to check if the array has been filled, to not wrong variance
-  bool previous_filled_;
+  // Variance of the previous measurements, used to check for vibrations
+  VibrationStatistics<kPreviousMeasurements> vibration_statistics_;
 
   // Flag to write to file
   bool write_to_file_;
@@ -216,9 +215,9 @@ class Navigation {
   NavigationVectorArray gravity_calibration_;
 
   // Initial timestamp (for comparisons)
-  uint32_t initial_timestamp_;
+  uint64_t initial_timestamp_;
   // Previous timestamp
-  uint32_t previous_timestamp_;
+  uint64_t previous_timestamp_;
   // Uncertainty in distance
   data::nav_t displacement_uncertainty_;
   // Uncertainty in velocity
@@ -246,7 +245,8 @@ class Navigation {
    */
   void updateUncertainty();
   /**
-   * @brief Check for vibrations
+   * @brief Check for vibrations. Constant time, the variances are maintained by
+   * vibration_statistics_
    */
   void checkVibration();
   /**
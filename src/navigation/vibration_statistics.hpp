@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include <data/data.hpp>
+#include <utils/math/statistics.hpp>
+
+namespace hyped::navigation {
+
+/**
+ * @brief Variance of the last `kWindowSize` readings of every IMU, per axis. All IMUs share one
+ *        window per axis, i.e. each axis pools `kWindowSize * kNumImus` samples.
+ *
+ *        Each axis is a utils::math::FixedRollingStatistics, so an update costs the same regardless
+ *        of the window size and never allocates.
+ *
+ * @tparam kWindowSize Number of readings per IMU in the window
+ */
+template<std::size_t kWindowSize>
+class VibrationStatistics {
+ public:
+  using ImuAxisData = std::array<std::array<data::nav_t, data::Sensors::kNumImus>, 3>;
+
+  static constexpr std::size_t kNumSamples = kWindowSize * data::Sensors::kNumImus;
+  static_assert(kNumSamples > 1, "sample variance needs at least two samples");
+
+  VibrationStatistics() : num_readings_(0) {}
+
+  /**
+   * @brief Adds one reading of every IMU, retiring the oldest reading if the window is full.
+   */
+  void update(const ImuAxisData &raw_acceleration)
+  {
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      for (const data::nav_t value : raw_acceleration[axis]) {
+        statistics_[axis].update(value);
+      }
+    }
+    if (num_readings_ < kWindowSize) { ++num_readings_; }
+  }
+
+  /**
+   * @brief Whether `kWindowSize` readings have been added, i.e. whether the variance covers a
+   *        full window.
+   */
+  bool isFilled() const { return num_readings_ == kWindowSize; }
+
+  /**
+   * @brief Sample variance of the readings currently in the window along `axis`.
+   */
+  data::nav_t getVariance(const std::size_t axis) const
+  {
+    // rounding may push the variance marginally below zero for a constant signal
+    return static_cast<data::nav_t>(std::max(statistics_[axis].getVariance(), 0.0));
+  }
+
+ private:
+  std::size_t num_readings_;
+  // accumulated in double so that rounding errors do not build up over a run
+  std::array<utils::math::FixedRollingStatistics<double, kNumSamples>, 3> statistics_;
+};
+
+}  // namespace hyped::navigation
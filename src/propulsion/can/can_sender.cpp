@@ -1,6 +1,6 @@
 #include "can_sender.hpp"
 
-#include <utils/timer.hpp>
+#include <chrono>
 
 namespace hyped::propulsion {
 
@@ -8,41 +8,59 @@ CanSender::CanSender(utils::Logger &log, const uint8_t node_id, IController &con
     : log_(log),
       node_id_(node_id),
       can_(utils::io::Can::getInstance()),
+      sdo_client_(SdoClient::getInstance()),
       controller_(controller)
 {
-  is_sending_ = false;
   can_.start();
 }
 
 bool CanSender::sendMessage(utils::io::can::Frame &message)
+{
+  auto response = sendMessageAsync(message);
+  return awaitResponse(response);
+}
+
+std::future<bool> CanSender::sendMessageAsync(utils::io::can::Frame &message)
 {
   log_.info("Sending Message");
-  can_.send(message);
-  is_sending_    = true;
-  const auto now = utils::Timer::getTimeMicros();
-  while (is_sending_) {
-    if ((utils::Timer::getTimeMicros() - now) > kTimeout) {
-      // TODO(Iain): Test the latency and set the TIMEOUT to a reasonable value.
-      log_.error("Sender timeout reached");
-      return false;
-    }
+  if (message.id != kSdoReceive + node_id_) {
+    // nothing to wait for
+    std::promise<bool> is_sent;
+    is_sent.set_value(can_.send(message) == 1);
+    return is_sent.get_future();
+  }
+  // register before sending so that a fast response cannot be missed
+  auto response = sdo_client_.expectResponse(kSdoTransmit + node_id_);
+  if (can_.send(message) != 1) { sdo_client_.cancel(kSdoTransmit + node_id_); }
+  return response;
+}
+
+bool CanSender::awaitResponse(std::future<bool> &response)
+{
+  if (response.wait_for(std::chrono::microseconds(kTimeout)) != std::future_status::ready) {
+    // TODO(Iain): Test the latency and set the TIMEOUT to a reasonable value.
+    log_.error("Sender timeout reached");
+    sdo_client_.cancel(kSdoTransmit + node_id_);
   }
-  return true;
+  return response.get();
 }
 
 void CanSender::registerController()
 {
-  can_.registerProcessor(this);
+  for (const uint32_t cob_id : canIds) {
+    can_.registerProcessor(this, utils::io::can::IdRange::exact(cob_id + node_id_, false));
+  }
 }
 
 void CanSender::processNewData(utils::io::can::Frame &message)
 {
-  is_sending_ = false;
   uint32_t id = message.id;
   if (id == kEmgyTransmit + node_id_) {
     controller_.processEmergencyMessage(message);
   } else if (id == kSdoTransmit + node_id_) {
     controller_.processSdoMessage(message);
+    // only complete the request once the controller has seen the response
+    sdo_client_.processResponse(message);
   } else if (id == kNmtTransmit + node_id_) {
     controller_.processNmtMessage(message);
   } else {
@@ -50,16 +68,8 @@ void CanSender::processNewData(utils::io::can::Frame &message)
   }
 }
 
-bool CanSender::hasId(uint32_t id, bool)
-{
-  for (uint32_t cobId : canIds) {
-    if (cobId + node_id_ == id) { return true; }
-  }
-  return false;
-}
-
 bool CanSender::getIsSending()
 {
-  return is_sending_;
+  return sdo_client_.isPending(kSdoTransmit + node_id_);
 }
 }  // namespace hyped::propulsion
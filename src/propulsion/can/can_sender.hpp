@@ -1,9 +1,9 @@
 #pragma once
 
+#include "sdo_client.hpp"
 #include "sender_interface.hpp"
 
-#include <atomic>
-#include <iostream>
+#include <future>
 
 #include <propulsion/controller_interface.hpp>
 #include <utils/concurrent/thread.hpp>
@@ -21,10 +21,30 @@ class CanSender : public utils::io::ICanProcessor, public ISender {
   CanSender(utils::Logger &log, const uint8_t node_id, IController &controller);
 
   /**
-   * @brief Sends CAN messages
+   * @brief Sends a CAN message. SDO requests wait for the controller's response for up to
+   *        kTimeout; other messages return as soon as they are written.
+   *
+   * @return false iff the message could not be sent or the response timed out
    */
   bool sendMessage(utils::io::can::Frame &message) override;
 
+  /**
+   * @brief Sends a CAN message without waiting for a response.
+   *
+   * @return for SDO requests, a future that becomes true when the controller's response has been
+   *         processed and false if the request fails; for other messages, a future that is
+   *         already true iff the message was written
+   */
+  std::future<bool> sendMessageAsync(utils::io::can::Frame &message);
+
+  /**
+   * @brief Waits for a future returned by sendMessageAsync for at most kTimeout and gives up on
+   *        the request if the timeout is reached.
+   *
+   * @return the value of the future, false on timeout
+   */
+  bool awaitResponse(std::future<bool> &response);
+
   /**
    * @brief Registers the controller to process incoming CAN messages
    */
@@ -35,11 +55,6 @@ class CanSender : public utils::io::ICanProcessor, public ISender {
    */
   void processNewData(utils::io::can::Frame &message) override;
 
-  /**
-   * @brief If this function returns true, the CAN message is ment for this CAN node
-   */
-  bool hasId(uint32_t id, bool extended) override;
-
   /**
    * @brief Return if the can_sender is sending a CAN message right now
    */
@@ -49,7 +64,7 @@ class CanSender : public utils::io::ICanProcessor, public ISender {
   utils::Logger &log_;
   uint8_t node_id_;
   utils::io::Can &can_;
-  std::atomic<bool> is_sending_;
+  SdoClient &sdo_client_;
   IController &controller_;
 
   static constexpr uint32_t kEmgyTransmit = 0x80;
@@ -29,11 +29,6 @@ void FakeCanSender::processNewData(utils::io::can::Frame &)
   is_sending_ = false;
 }
 
-bool FakeCanSender::hasId(uint32_t, bool)
-{
-  return true;
-}
-
 bool FakeCanSender::getIsSending()
 {
   return is_sending_;
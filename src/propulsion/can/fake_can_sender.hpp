@@ -21,8 +21,6 @@ class FakeCanSender : public utils::io::ICanProcessor, public ISender {
 
   void processNewData(utils::io::can::Frame &message) override;
 
-  bool hasId(uint32_t id, bool extended) override;
-
   bool getIsSending() override;
 
  private:
@@ -0,0 +1,43 @@
+#include "sdo_client.hpp"
+
+namespace hyped::propulsion {
+
+std::future<bool> SdoClient::expectResponse(const uint32_t cob_id)
+{
+  std::promise<bool> promise;
+  std::future<bool> response = promise.get_future();
+  utils::concurrent::ScopedLock scoped_lock(&lock_);
+  const auto [it, is_new] = pending_.try_emplace(cob_id, std::move(promise));
+  if (!is_new) {
+    it->second.set_value(false);
+    it->second = std::move(promise);
+  }
+  return response;
+}
+
+bool SdoClient::processResponse(const utils::io::can::Frame &frame)
+{
+  utils::concurrent::ScopedLock scoped_lock(&lock_);
+  const auto it = pending_.find(frame.id);
+  if (it == pending_.end()) { return false; }
+  it->second.set_value(true);
+  pending_.erase(it);
+  return true;
+}
+
+void SdoClient::cancel(const uint32_t cob_id)
+{
+  utils::concurrent::ScopedLock scoped_lock(&lock_);
+  const auto it = pending_.find(cob_id);
+  if (it == pending_.end()) { return; }
+  it->second.set_value(false);
+  pending_.erase(it);
+}
+
+bool SdoClient::isPending(const uint32_t cob_id)
+{
+  utils::concurrent::ScopedLock scoped_lock(&lock_);
+  return pending_.find(cob_id) != pending_.end();
+}
+
+}  // namespace hyped::propulsion
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <unordered_map>
+
+#include <utils/concurrent/lock.hpp>
+#include <utils/io/can.hpp>
+
+namespace hyped::propulsion {
+
+/**
+ * @brief Tracks outstanding SDO requests by the COB-ID their response arrives with, so that a
+ *        sender can wait for the response on a future rather than polling a flag. Requests to
+ *        different nodes are independent, which lets several controllers be addressed at once.
+ *
+ *        CANopen servers handle one SDO transfer at a time, so there is at most one outstanding
+ *        request per COB-ID.
+ */
+class SdoClient {
+ public:
+  static SdoClient &getInstance()
+  {
+    static SdoClient sdo_client;
+    return sdo_client;
+  }
+
+  SdoClient() = default;
+
+  /**
+   * @brief Registers a request whose response will arrive with the given COB-ID. A request still
+   *        outstanding for the same COB-ID is abandoned.
+   *
+   * @return future that becomes true when the response arrives and false if the request is
+   *         cancelled or abandoned
+   */
+  std::future<bool> expectResponse(uint32_t cob_id);
+
+  /**
+   * @brief Completes the request outstanding for the COB-ID of `frame`, if there is one. To be
+   *        called from the CAN receive side after the frame has been processed.
+   *
+   * @return true iff a request was outstanding for the frame
+   */
+  bool processResponse(const utils::io::can::Frame &frame);
+
+  /**
+   * @brief Gives up on the request outstanding for the given COB-ID, e.g. after a timeout.
+   */
+  void cancel(uint32_t cob_id);
+
+  /**
+   * @return true iff a request is outstanding for the given COB-ID
+   */
+  bool isPending(uint32_t cob_id);
+
+ private:
+  utils::concurrent::Lock lock_;
+  std::unordered_map<uint32_t, std::promise<bool>> pending_;
+};
+
+}  // namespace hyped::propulsion
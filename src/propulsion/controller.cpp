@@ -13,7 +13,8 @@ Controller::Controller(utils::Logger &log, uint8_t id)
       actual_torque_(0),
       motor_temperature_(0),
       controller_temperature_(0),
-      sender_(log, node_id_, *this)
+      sender_(log, node_id_, *this),
+      is_pending_response_critical_(false)
 {
   sdo_message_.id       = kSdoReceive + node_id_;
   sdo_message_.extended = false;
@@ -26,11 +27,17 @@ Controller::Controller(utils::Logger &log, uint8_t id)
 
 bool Controller::sendControllerMessage(const ControllerMessage message_template)
 {
-  std::copy(message_template.begin(), message_template.end(), sdo_message_.data);
-  sendSdoMessage(sdo_message_);
+  requestControllerMessage(message_template);
+  awaitResponse();
   return critical_failure_;
 }
 
+void Controller::requestControllerMessage(const ControllerMessage message_template)
+{
+  std::copy(message_template.begin(), message_template.end(), sdo_message_.data);
+  requestSdoMessage(sdo_message_, true);
+}
+
 void Controller::registerController()
 {
   sender_.registerController();
@@ -89,11 +96,17 @@ void Controller::enterPreOperational()
 
 void Controller::checkState()
 {
-  log_.debug("Controller %d: Checking state", node_id_);
+  LOG_DEBUG(log_, "Controller %d: Checking state", node_id_);
   sendControllerMessage(kCheckStateMessage);
 }
 
 void Controller::sendTargetVelocity(const int32_t target_velocity)
+{
+  requestTargetVelocity(target_velocity);
+  awaitResponse();
+}
+
+void Controller::requestTargetVelocity(const int32_t target_velocity)
 {
   log_.info("Controller %d: Setting target velocity to %d", node_id_, target_velocity);
   std::copy(kSendTargetVelocityMessage.begin(), kSendTargetVelocityMessage.end(),
@@ -105,7 +118,8 @@ void Controller::sendTargetVelocity(const int32_t target_velocity)
   sdo_message_.data[6] = (target_velocity >> 16) & 0xFF;
   sdo_message_.data[7] = (target_velocity >> 24) & 0xFF;
 
-  sender_.sendMessage(sdo_message_);
+  // a missing reply to a velocity update is not critical
+  requestSdoMessage(sdo_message_, false);
 }
 
 void Controller::sendTargetTorque(const int16_t target_torque)
@@ -121,9 +135,15 @@ void Controller::sendTargetTorque(const int16_t target_torque)
 }
 
 void Controller::updateActualVelocity()
+{
+  requestActualVelocity();
+  awaitResponse();
+}
+
+void Controller::requestActualVelocity()
 {
   log_.info("Controller %d: Updating actual velocity", node_id_);
-  sendControllerMessage(kUpdateActualVelocityMessage);
+  requestControllerMessage(kUpdateActualVelocityMessage);
 }
 
 void Controller::updateActualTorque()
@@ -147,9 +167,15 @@ void Controller::healthCheck()
 }
 
 void Controller::updateMotorTemp()
+{
+  requestMotorTemp();
+  awaitResponse();
+}
+
+void Controller::requestMotorTemp()
 {
   log_.info("Controller %d: Updating motor temperature", node_id_);
-  sendControllerMessage(kMotorTemperatureMessage);
+  requestControllerMessage(kMotorTemperatureMessage);
 }
 
 void Controller::updateControllerTemp()
@@ -161,10 +187,26 @@ void Controller::updateControllerTemp()
 
 void Controller::sendSdoMessage(utils::io::can::Frame &message)
 {
-  if (!sender_.sendMessage(message)) {
+  requestSdoMessage(message, true);
+  awaitResponse();
+}
+
+void Controller::requestSdoMessage(utils::io::can::Frame &message, const bool is_critical)
+{
+  awaitResponse();
+  pending_response_             = sender_.sendMessageAsync(message);
+  is_pending_response_critical_ = is_critical;
+}
+
+bool Controller::awaitResponse()
+{
+  if (!pending_response_.valid()) { return true; }
+  const bool has_response = sender_.awaitResponse(pending_response_);
+  if (!has_response && is_pending_response_critical_) {
     log_.error("Controller %d: No response from controller", node_id_);
     throwCriticalFailure();
   }
+  return has_response;
 }
 
 void Controller::throwCriticalFailure()
@@ -180,7 +222,8 @@ void Controller::requestStateTransition(utils::io::can::Frame &message, Controll
   // Wait for max of 3 seconds, checking if the state has changed every second
   // If it hasn't changed by the end then throw critical failure.
   for (uint8_t state_count = 0; state_count < 3; ++state_count) {
-    sender_.sendMessage(message);
+    requestSdoMessage(message, false);
+    awaitResponse();
     utils::concurrent::Thread::sleep(1000);
     checkState();
     if (state_ == state) { return; }
@@ -330,7 +373,7 @@ void Controller::processEmergencyMessage(utils::io::can::Frame &message)
     uint16_t error_message = (index_2 << 8) | index_1;
     processErrorMessage(error_message);
   }
-  log_.debug("index 1: %d, index 2: %d", index_1, index_2);
+  LOG_DEBUG(log_, "index 1: %d, index 2: %d", index_1, index_2);
 }
 
 void Controller::processErrorMessage(const uint16_t error_message)
@@ -495,119 +538,119 @@ void Controller::processSdoMessage(utils::io::can::Frame &message)
     switch (status) {
       case 0x00:
         state_ = kNotReadyToSwitchOn;
-        log_.debug("Controller %d state: Not ready to switch on", node_id_);
+        LOG_DEBUG(log_, "Controller %d state: Not ready to switch on", node_id_);
         break;
       case 0x40:
         state_ = kSwitchOnDisabled;
-        log_.debug("Controller %d state: Switch on disabled", node_id_);
+        LOG_DEBUG(log_, "Controller %d state: Switch on disabled", node_id_);
         break;
       case 0x21:
         state_ = kReadyToSwitchOn;
-        log_.debug("Controller %d state: Ready to switch on", node_id_);
+        LOG_DEBUG(log_, "Controller %d state: Ready to switch on", node_id_);
         break;
       case 0x23:
         state_ = kSwitchedOn;
-        log_.debug("Controller %d state: Switched on", node_id_);
+        LOG_DEBUG(log_, "Controller %d state: Switched on", node_id_);
         break;
       case 0x27:
         state_ = kOperationEnabled;
-        log_.debug("Controller %d state: Operation enabled", node_id_);
+        LOG_DEBUG(log_, "Controller %d state: Operation enabled", node_id_);
         break;
       case 0x07:
         state_ = kQuickStopActive;
-        log_.debug("Controller %d state: Quick stop active", node_id_);
+        LOG_DEBUG(log_, "Controller %d state: Quick stop active", node_id_);
         break;
       case 0x0F:
         state_ = kFaultReactionActive;
-        log_.debug("Controller %d state: Fault reaction active", node_id_);
+        LOG_DEBUG(log_, "Controller %d state: Fault reaction active", node_id_);
         break;
       case 0x08:
         state_ = kFault;
-        log_.debug("Controller %d state: Fault", node_id_);
+        LOG_DEBUG(log_, "Controller %d state: Fault", node_id_);
         break;
       default:
-        log_.debug("Controller %d state: State not recognised", node_id_);
+        LOG_DEBUG(log_, "Controller %d state: State not recognised", node_id_);
     }
     return;
   }
 
   // Process configuration messages
   if (index_1 == 0x33 && index_2 == 0x20 && sub_index == 0x00) {
-    log_.debug("Controller %d: Motor poles configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Motor poles configured", node_id_);
     return;
   }
   if (index_1 == 0x40 && index_2 == 0x20 && sub_index == 0x01) {
-    log_.debug("Controller %d: Feedback type configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Feedback type configured", node_id_);
     return;
   }
   if (index_1 == 0x40 && index_2 == 0x20 && sub_index == 0x02) {
-    log_.debug("Controller %d: Motor phase offset configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Motor phase offset configured", node_id_);
     return;
   }
   if (index_1 == 0x40 && index_2 == 0x20 && sub_index == 0x08) {
-    log_.debug("Controller %d: Motor phase offset compensation configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Motor phase offset compensation configured", node_id_);
     return;
   }
   if (index_1 == 0x54 && index_2 == 0x20 && sub_index == 0x00) {
-    log_.debug("Controller %d: Over voltage limit configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Over voltage limit configured", node_id_);
     return;
   }
   if (index_1 == 0x55 && index_2 == 0x20 && sub_index == 0x03) {
-    log_.debug("Controller %d: Under voltage minimum configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Under voltage minimum configured", node_id_);
     return;
   }
   if (index_1 == 0x55 && index_2 == 0x20 && sub_index == 0x01) {
-    log_.debug("Controller %d: Under voltage limit configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Under voltage limit configured", node_id_);
     return;
   }
   if (index_1 == 0x57 && index_2 == 0x20 && sub_index == 0x01) {
-    log_.debug("Controller %d: Temperature sensor configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Temperature sensor configured", node_id_);
     return;
   }
   if (index_1 == 0x75 && index_2 == 0x60 && sub_index == 0x00) {
-    log_.debug("Controller %d: Motor rated current configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Motor rated current configured", node_id_);
     return;
   }
   if (index_1 == 0x76 && index_2 == 0x60 && sub_index == 0x00) {
-    log_.debug("Controller %d: Motor rated torque configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Motor rated torque configured", node_id_);
     return;
   }
   if (index_1 == 0xF6 && index_2 == 0x60 && sub_index == 0x01) {
-    log_.debug("Controller %d: Current control torque P gain configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Current control torque P gain configured", node_id_);
     return;
   }
   if (index_1 == 0xF6 && index_2 == 0x60 && sub_index == 0x02) {
-    log_.debug("Controller %d: Current control torque I gain configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Current control torque I gain configured", node_id_);
     return;
   }
   if (index_1 == 0xF6 && index_2 == 0x60 && sub_index == 0x03) {
-    log_.debug("Controller %d: Current control flux P gain configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Current control flux P gain configured", node_id_);
     return;
   }
   if (index_1 == 0xF6 && index_2 == 0x60 && sub_index == 0x04) {
-    log_.debug("Controller %d: Current control flux I gain configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Current control flux I gain configured", node_id_);
     return;
   }
   if (index_1 == 0xF6 && index_2 == 0x60 && sub_index == 0x05) {
-    log_.debug("Controller %d: Current control ramp configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Current control ramp configured", node_id_);
     return;
   }
   if (index_1 == 0x50 && index_2 == 0x20 && sub_index == 0x00) {
-    log_.debug("Controller %d: Maximum current limit configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Maximum current limit configured", node_id_);
     return;
   }
   if (index_1 == 0x51 && index_2 == 0x20 && sub_index == 0x00) {
-    log_.debug("Controller %d: Secondary current protection configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Secondary current protection configured", node_id_);
     return;
   }
   if (index_1 == 0x52 && index_2 == 0x20 && sub_index == 0x01) {
-    log_.debug("Controller %d: Maximum RPM configured", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Maximum RPM configured", node_id_);
     return;
   }
 
   // Controlword updates
   if (index_1 == 0x40 && index_2 == 0x60 && sub_index == 0x00) {
-    log_.debug("Controller %d: Control Word updated", node_id_);
+    LOG_DEBUG(log_, "Controller %d: Control Word updated", node_id_);
     return;
   }
 }
@@ -4,6 +4,7 @@
 #include "messages.hpp"
 
 #include <atomic>
+#include <future>
 
 #include <data/data.hpp>
 #include <propulsion/can/can_sender.hpp>
@@ -140,6 +141,10 @@ class Controller : public IController {
    * @param[in] { CAN message to be sent, Controller state requested}
    */
   void requestStateTransition(utils::io::can::Frame &message, ControllerState state) override;
+  void requestActualVelocity() override;
+  void requestTargetVelocity(int32_t target_velocity) override;
+  void requestMotorTemp() override;
+  bool awaitResponse() override;
   /**
    * @brief Sets the mode of operation to the auto align motor positon mode.
    *        The motor should spin briefly in both directions. This is a testing state and the
@@ -159,6 +164,16 @@ class Controller : public IController {
    * @brief Sends a CAN frame but waits for a reply
    */
   void sendSdoMessage(utils::io::can::Frame &message);
+  /**
+   * @brief Sends a CAN frame without waiting for the reply, see awaitResponse. Waits for the
+   *        previous request first as the controller handles one SDO transfer at a time.
+   * @param is_critical whether a missing reply is a critical failure
+   */
+  void requestSdoMessage(utils::io::can::Frame &message, bool is_critical);
+  /**
+   * @brief Fills the SDO message with the given template and requests it, see requestSdoMessage
+   */
+  void requestControllerMessage(ControllerMessage message_template);
   /**
    * @brief set critical failure flag to true and write failure to data structure.
    */
@@ -177,6 +192,8 @@ class Controller : public IController {
   CanSender sender_;
   utils::io::can::Frame sdo_message_;
   utils::io::can::Frame nmt_message_;
+  std::future<bool> pending_response_;
+  bool is_pending_response_critical_;
 
   // Network management CAN commands:
   const uint8_t kNmtOperational = 0x01;
@@ -40,6 +40,20 @@ class IController {
   virtual void processSdoMessage(utils::io::can::Frame &message)                             = 0;
   virtual void processNmtMessage(utils::io::can::Frame &message)                             = 0;
   virtual void requestStateTransition(utils::io::can::Frame &message, ControllerState state) = 0;
+
+  /*
+   * Non-blocking variants of updateActualVelocity, sendTargetVelocity and updateMotorTemp. They
+   * send the request and return immediately so that several controllers can be addressed at
+   * once; awaitResponse has to be called before the result is read.
+   */
+  virtual void requestActualVelocity()                       = 0;
+  virtual void requestTargetVelocity(int32_t target_velocity) = 0;
+  virtual void requestMotorTemp()                            = 0;
+  /**
+   * @brief Waits for the response to the last request, if it is still outstanding.
+   * @return false iff the response timed out
+   */
+  virtual bool awaitResponse() = 0;
 };
 }  // namespace propulsion
 }  // namespace hyped
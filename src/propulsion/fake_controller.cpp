@@ -34,25 +34,25 @@ void FakeController::startTimer()
 void FakeController::enterOperational()
 {
   state_ = kOperationEnabled;
-  log_.debug("Controller %d: entering operational", id_);
+  LOG_DEBUG(log_, "Controller %d: entering operational", id_);
 }
 
 void FakeController::enterPreOperational()
 {
-  if (state_ != kSwitchOnDisabled) { log_.debug("Controller %d: shutting down motor", id_); }
+  if (state_ != kSwitchOnDisabled) { LOG_DEBUG(log_, "Controller %d: shutting down motor", id_); }
   state_           = kSwitchOnDisabled;
   actual_velocity_ = 0;
 }
 
 void FakeController::checkState()
 {
-  log_.debug("Controller %d: checking status", id_);
+  LOG_DEBUG(log_, "Controller %d: checking status", id_);
 }
 
 void FakeController::sendTargetVelocity(const int32_t target_velocity)
 {
   if (!timer_started_) { startTimer(); }
-  log_.debug("Controller %d: updating target velocity to %d", id_, target_velocity);
+  LOG_DEBUG(log_, "Controller %d: updating target velocity to %d", id_, target_velocity);
   actual_velocity_ = target_velocity;
 }
 
@@ -67,7 +67,7 @@ int32_t FakeController::getVelocity()
 
 void FakeController::quickStop()
 {
-  log_.debug("Controller %d: sending quick stop command", id_);
+  LOG_DEBUG(log_, "Controller %d: sending quick stop command", id_);
 }
 
 void FakeController::healthCheck()
@@ -90,6 +90,20 @@ class FakeController : public IController {
   void updateMotorTemp() override
   { /*EMPTY*/
   }
+  void requestActualVelocity() override
+  { /*EMPTY*/
+  }
+  void requestMotorTemp() override
+  { /*EMPTY*/
+  }
+  /**
+   * @brief  Same as sendTargetVelocity, the fake controller answers immediately.
+   */
+  void requestTargetVelocity(const int32_t target_velocity) override
+  {
+    sendTargetVelocity(target_velocity);
+  }
+  bool awaitResponse() override { return true; }
 
  private:
   /**
@@ -80,8 +80,8 @@ void StateProcessor::accelerate()
   }
 
   auto motor_data = data_.getMotorData();
+  requestAll([](IController &controller) { controller.requestActualVelocity(); });
   for (size_t i = 0; i < data::Motors::kNumMotors; ++i) {
-    controllers_.at(i)->updateActualVelocity();
     motor_data.rpms.at(i) = controllers_.at(i)->getVelocity();
   }
   data_.setMotorData(motor_data);
@@ -93,9 +93,7 @@ void StateProcessor::accelerate()
     const auto act_rpm          = calculateAverageRpm();
     const auto rpm              = RpmRegulator::calculateRpm(velocity, act_rpm);
     log_.info("sending %d rpm as target", rpm);
-    for (auto &controller : controllers_) {
-      controller->sendTargetVelocity(rpm);
-    }
+    requestAll([rpm](IController &controller) { controller.requestTargetVelocity(rpm); });
   }
 }
 
@@ -117,9 +115,9 @@ bool StateProcessor::isOverLimits()
 
 int32_t StateProcessor::calculateAverageRpm()
 {
+  requestAll([](IController &controller) { controller.requestActualVelocity(); });
   int32_t total = 0;
   for (auto &controller : controllers_) {
-    controller->updateActualVelocity();
     total += controller->getVelocity();
   }
   // integer division should be good enough
@@ -139,9 +137,9 @@ int16_t StateProcessor::calculateMaximumCurrent()
 
 int32_t StateProcessor::calculateMaximumTemperature()
 {
+  requestAll([](IController &controller) { controller.requestMotorTemp(); });
   int32_t max_temp = 0;
   for (auto &controller : controllers_) {
-    controller->updateMotorTemp();
     const auto temp = controller->getMotorTemp();
     if (max_temp < temp) { max_temp = temp; }
   }
@@ -101,6 +101,21 @@ class StateProcessor {
 
   int32_t calculateMaximumTemperature();
 
+  /**
+   * @brief Applies `request` to every controller and then waits for all of them to respond, so
+   *        that the controllers process their requests in parallel.
+   */
+  template<typename Request>
+  void requestAll(Request request)
+  {
+    for (auto &controller : controllers_) {
+      request(*controller);
+    }
+    for (auto &controller : controllers_) {
+      controller->awaitResponse();
+    }
+  }
+
   utils::Logger &log_;
   utils::System &sys_;
   data::Data &data_;
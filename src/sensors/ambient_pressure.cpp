@@ -18,14 +18,15 @@ void AmbientPressure::run()
   pressure_data_.ambient_pressure          = 0;
   const uint16_t digital_temperature_value = temperature_pin_.read();
   const uint16_t digital_pressure_value    = pressure_pin_.read();
-  log_.debug("Raw AmbientPressure Data: %d", digital_temperature_value, digital_pressure_value);
+  LOG_DEBUG(log_, "Raw AmbientPressure Data: %d", digital_temperature_value,
+            digital_pressure_value);
   const auto scaled_data = scaleData(digital_pressure_value, digital_temperature_value);
   if (!scaled_data) {
     pressure_data_.operational = false;
     return;
   }
   pressure_data_.ambient_pressure = *scaled_data;
-  log_.debug("Scaled AmbientPressure Data: %d", pressure_data_.ambient_pressure);
+  LOG_DEBUG(log_, "Scaled AmbientPressure Data: %d", pressure_data_.ambient_pressure);
   pressure_data_.operational = true;
 }
 
@@ -1,5 +1,7 @@
 #include "bms.hpp"
 
+#include <cinttypes>
+
 #include <data/data.hpp>
 #include <utils/logger.hpp>
 #include <utils/timer.hpp>
@@ -27,8 +29,10 @@ Bms::Bms(uint8_t id, utils::Logger &log)
   }
   existing_ids_.push_back(id);
 
-  // tell CAN about yourself
-  can_.registerProcessor(this);
+  // tell CAN about yourself, this Bms only understands extended IDs
+  can_.registerProcessor(this, {id_base_, id_base_ + bms::kIdSize - 1, true});
+  // LP current CAN message
+  can_.registerProcessor(this, utils::io::can::IdRange::exact(0x28, true));
   can_.start();
 
   running_ = true;
@@ -52,7 +56,7 @@ void Bms::request()
 
   int sent = can_.send(message);
   if (sent) {
-    log_.debug("module %u: request message sent", id_);
+    LOG_DEBUG(log_, "module %u: request message sent", id_);
   } else {
     log_.error("module %u error: request message not sent", id_);
   }
@@ -68,22 +72,9 @@ void Bms::run()
   log_.info("module %u: stopped BMS", id_);
 }
 
-bool Bms::hasId(uint32_t id, bool extended)
-{
-  if (!extended) return false;  // this Bms only understands extended IDs
-
-  // LP Bms CAN messages
-  if (id_base_ <= id && id < id_base_ + bms::kIdSize) return true;
-
-  // LP current CAN message
-  if (id == 0x28) return true;
-
-  return false;
-}
-
 void Bms::processNewData(utils::io::can::Frame &message)
 {
-  log_.debug("module %u: received CAN message with id %d", id_, message.id);
+  LOG_DEBUG(log_, "module %u: received CAN message with id %d", id_, message.id);
 
   // check current CAN message
   if (message.id == 0x28) {
@@ -96,7 +87,7 @@ void Bms::processNewData(utils::io::can::Frame &message)
     return;
   }
 
-  log_.debug("message data[0,1] %d %d", message.data[0], message.data[1]);
+  LOG_DEBUG(log_, "message data[0,1] %d %d", message.data[0], message.data[1]);
   uint8_t offset = message.id - (bms::kIdBase + (bms::kIdIncrement * id_));
   switch (offset) {
     case 0x1:  // cells 1-4
@@ -170,6 +161,11 @@ data::BatteryData Bms::getData()
 std::vector<uint16_t> HighPowerBms::existing_ids_;
 
 HighPowerBms::HighPowerBms(uint16_t id, utils::Logger &log)
+    : HighPowerBms(id, utils::io::Can::getInstance(), log)
+{
+}
+
+HighPowerBms::HighPowerBms(uint16_t id, utils::io::Can &can, utils::Logger &log)
     : log_(log),
       can_id_(id * 2 + bms::kHPBase),
       thermistor_id_(id + bms::kThermistorBase),
@@ -187,8 +183,32 @@ HighPowerBms::HighPowerBms(uint16_t id, utils::Logger &log)
   existing_ids_.push_back(id);
 
   // tell CAN about yourself
-  utils::io::Can::getInstance().registerProcessor(this);
-  utils::io::Can::getInstance().start();
+  using utils::io::can::IdRange;
+  // HPBMS
+  can.registerProcessor(this, IdRange::exact(can_id_, false));
+  can.registerProcessor(this, IdRange::exact(static_cast<uint16_t>(can_id_ + 1), false));
+  // CAN ID for broadcast message
+  can.registerProcessor(this, IdRange::exact(cell_id_, false));
+  // OBDII ECU ID
+  can.registerProcessor(this, IdRange::exact(0x7E4, false));
+  // unused messages, fault message?
+  for (const uint32_t id : {0x6D0, 0x7EC, 0x70, 0x80}) {
+    can.registerProcessor(this, IdRange::exact(id, false));
+  }
+  // Thermistor expansion module, which only sends extended ids
+  if (thermistor_id_ <= IdRange::kMaxExtendedId) {
+    can.registerProcessor(this, IdRange::exact(static_cast<uint32_t>(thermistor_id_), true));
+  } else {
+    log_.error("thermistor CAN id 0x%" PRIx64 " of HighPowerBms %d is out of range", thermistor_id_,
+               id);
+  }
+  // Thermistor node IDs
+  can.registerProcessor(this, {0x6B4, 0x6B5, false});
+  // ignore misc thermistor module messages
+  for (const uint32_t id : {0x1838F380, 0x18EEFF80, 0x1838F381, 0x18EEFF81}) {
+    can.registerProcessor(this, IdRange::exact(id, true));
+  }
+  can.start();
 }
 
 bool HighPowerBms::isOnline()
@@ -202,43 +222,17 @@ data::BatteryData HighPowerBms::getData()
   return battery_data_;
 }
 
-bool HighPowerBms::hasId(uint32_t id, bool)
-{
-  // HPBMS
-  if (id == can_id_ || id == static_cast<uint16_t>(can_id_ + 1)) return true;
-
-  // CAN ID for broadcast message
-  if (id == cell_id_) return true;
-
-  // OBDII ECU ID
-  if (id == 0x7E4) return true;
-  // unused messages, fault message?
-  if (id == 0x6D0 || id == 0x7EC) return true;
-  if (id == 0x70 || id == 0x80) return true;
-
-  // Thermistor expansion module
-  if (id == thermistor_id_) return true;
-
-  // Thermistor node IDs
-  if (id == 0x6B4 || id == 0x6B5) return true;
-  // ignore misc thermistor module messages
-  if (id == 0x1838F380 || id == 0x18EEFF80) return true;
-  if (id == 0x1838F381 || id == 0x18EEFF81) return true;
-
-  return false;
-}
-
 void HighPowerBms::processNewData(utils::io::can::Frame &message)
 {
   // thermistor expansion module
-  if (message.id == thermistor_id_) {  // C
+  if (message.extended && message.id == thermistor_id_) {  // C
     battery_data_.low_temperature     = message.data[1];
     battery_data_.high_temperature    = message.data[2];
     battery_data_.average_temperature = message.data[3];
   }
 
-  log_.debug("High Temp: %d, Average Temp: %d, Low Temp: %d", battery_data_.high_temperature,
-             battery_data_.average_temperature, battery_data_.low_temperature);
+  LOG_DEBUG(log_, "High Temp: %d, Average Temp: %d, Low Temp: %d", battery_data_.high_temperature,
+            battery_data_.average_temperature, battery_data_.low_temperature);
 
   // voltage, current, charge, and isolation 1:1 configured
   // low_voltage_cell and high_voltage_cell 10:1 configured
@@ -254,7 +248,7 @@ void HighPowerBms::processNewData(utils::io::can::Frame &message)
     battery_data_.high_voltage_cell = ((message.data[0] << 8) | message.data[1]);  // mV
     uint16_t insulation_monitoring_device_reading
       = ((message.data[2] << 8) | message.data[3]);  // mV
-    log_.debug("Isolation ADC: %u", insulation_monitoring_device_reading);
+    LOG_DEBUG(log_, "Isolation ADC: %u", insulation_monitoring_device_reading);
     if (insulation_monitoring_device_reading > 4000) {  // 4 volts for safe isolation
       battery_data_.insulation_monitoring_device_fault = true;
     } else {
@@ -270,9 +264,9 @@ void HighPowerBms::processNewData(utils::io::can::Frame &message)
     battery_data_.cell_voltage[cell_num] /= 10;  // mV
   }
 
-  log_.debug("Cell voltage: %u", battery_data_.cell_voltage[0]);
-  log_.debug("received data Volt,Curr,Char,low_v,high_v: %u,%u,%u,%u,%u", battery_data_.voltage,
-             battery_data_.current, battery_data_.charge, battery_data_.low_voltage_cell,
-             battery_data_.high_voltage_cell);
+  LOG_DEBUG(log_, "Cell voltage: %u", battery_data_.cell_voltage[0]);
+  LOG_DEBUG(log_, "received data Volt,Curr,Char,low_v,high_v: %u,%u,%u,%u,%u",
+            battery_data_.voltage, battery_data_.current, battery_data_.charge,
+            battery_data_.low_voltage_cell, battery_data_.high_voltage_cell);
 }
 }  // namespace hyped::sensors
@@ -88,9 +88,6 @@ class Bms : public utils::concurrent::Thread, public utils::io::ICanProcessor, p
   bool isOnline() override;
   data::BatteryData getData() override;
 
-  // From CanProcessor interface
-  bool hasId(uint32_t id, bool extended) override;
-
  private:
   /**
    * @brief Send request CAN message to update data periodically
@@ -132,13 +129,16 @@ class HighPowerBms : public utils::io::ICanProcessor, public IBms {
    */
   HighPowerBms(uint16_t id, utils::Logger &log = utils::System::getLogger());
 
+  /**
+   * @brief Construct a new HighPowerBms object that receives from `can` rather than
+   *        utils::io::Can::getInstance(), e.g. a Can over a node of a can::VirtualBus
+   */
+  HighPowerBms(uint16_t id, utils::io::Can &can, utils::Logger &log = utils::System::getLogger());
+
   // from IBms
   bool isOnline() override;
   data::BatteryData getData() override;
 
-  // from CanProcessor
-  bool hasId(uint32_t id, bool extended) override;
-
  private:
   void processNewData(utils::io::can::Frame &message) override;
 
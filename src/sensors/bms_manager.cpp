@@ -132,7 +132,7 @@ void BmsManager::run()
     if (utils::Timer::getTimeMicros() - start_time_ > config_.bms_startup_time_micros) {
       // if previous state is kInit, turn it to ready
       if (battery_data_.module_status == data::ModuleStatus::kInit) {
-        log_.debug("Batteries are ready");
+        LOG_DEBUG(log_, "Batteries are ready");
         battery_data_.module_status = data::ModuleStatus::kReady;
       }
       if (battery_data_.module_status != data::ModuleStatus::kCriticalFailure) {
@@ -13,9 +13,9 @@ BrakePressure::BrakePressure(const uint8_t pin)
 void BrakePressure::run()
 {
   const uint16_t raw_value = pin_.read();
-  log_.debug("raw value: %d", raw_value);
+  LOG_DEBUG(log_, "raw value: %d", raw_value);
   pressure_data_.brake_pressure = scaleData(raw_value);
-  log_.debug("scaled value: %d", pressure_data_.brake_pressure);
+  LOG_DEBUG(log_, "scaled value: %d", pressure_data_.brake_pressure);
   pressure_data_.operational = true;
 }
 
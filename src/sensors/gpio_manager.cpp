@@ -1,5 +1,8 @@
 #include "gpio_manager.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 #include <utils/timer.hpp>
 
 namespace hyped::sensors {
@@ -17,6 +20,18 @@ GpioManager::GpioManager(utils::Logger log, const Config &config)
     high_power_ssr_.at(i)->clear();
     log_.info("HP SSR %d has been initialised CLEAR", i);
   }
+  auto registers = std::make_shared<utils::io::MappedGpioRegisters>();
+  for (const uint32_t pin : config_.high_power_ssr_pins) {
+    const uint8_t bank = utils::io::GpioBank::getBank(pin);
+    auto ssr_bank      = std::find_if(
+      high_power_ssr_banks_.begin(), high_power_ssr_banks_.end(),
+      [bank](const auto &ssr_bank) { return ssr_bank.first.getIndex() == bank; });
+    if (ssr_bank == high_power_ssr_banks_.end()) {
+      high_power_ssr_banks_.emplace_back(utils::io::GpioBank(bank, registers), 0);
+      ssr_bank = std::prev(high_power_ssr_banks_.end());
+    }
+    ssr_bank->second |= utils::io::GpioBank::getMask(pin);
+  }
   // master switch to keep pod on
   master_ = std::make_unique<utils::io::Gpio>(config_.master_switch_pin,
                                               utils::io::Gpio::Direction::kOut);
@@ -30,8 +45,9 @@ void GpioManager::clearHighPower()
 {
   data::Sensors sensors_data_struct = data_.getSensorsData();
   master_->clear();  // important to clear this first
-  for (size_t i = 0; i < data::FullBatteryData::kNumHPBatteries; ++i) {
-    high_power_ssr_[i]->clear();  // HP off until kReady State
+  // HP off until kReady State, all SSRs of a bank at the same instant
+  for (auto &[bank, mask] : high_power_ssr_banks_) {
+    bank.clear(mask);
   }
   sensors_data_struct.high_power_off = true;  // all SSRs in HP off
   data_.setSensorsData(sensors_data_struct);
@@ -51,6 +67,7 @@ void GpioManager::setHighPower()
 
 void GpioManager::run()
 {
+  uint64_t state_machine_version = data_.getVersion(data::Substructure::kStateMachine);
   while (sys_.isRunning()) {
     const auto state = data_.getStateMachineData().current_state;
     if (state != previous_state_) {
@@ -95,8 +112,9 @@ void GpioManager::run()
           break;
       }
     }
-    previous_state_ = state;
-    sleep(100);
+    previous_state_       = state;
+    state_machine_version = data_.waitForUpdate(data::Substructure::kStateMachine,
+                                                state_machine_version, kUpdateTimeoutMillis);
   }
 }
 
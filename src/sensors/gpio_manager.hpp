@@ -2,11 +2,13 @@
 
 #include <cstdint>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include <data/data.hpp>
 #include <utils/concurrent/thread.hpp>
 #include <utils/io/gpio.hpp>
+#include <utils/io/gpio_bank.hpp>
 #include <utils/system.hpp>
 
 namespace hyped::sensors {
@@ -24,9 +26,13 @@ class GpioManager : public utils::concurrent::Thread {
     uint32_t master_switch_pin;
     std::array<uint32_t, data::FullBatteryData::kNumHPBatteries> high_power_ssr_pins;
   };
+  explicit GpioManager(utils::Logger log, const Config &config);
   void run() override;
   static std::unique_ptr<GpioManager> fromFile(const std::string &path);
 
+  // upper bound on how long we sleep without a state change before rechecking whether to exit
+  static constexpr uint32_t kUpdateTimeoutMillis = 100;
+
  private:
   utils::System &sys_;
   data::Data &data_;
@@ -46,13 +52,17 @@ class GpioManager : public utils::concurrent::Thread {
    */
   std::vector<std::unique_ptr<utils::io::Gpio>> high_power_ssr_;
 
+  /**
+   * @brief banks holding the SSR pins, each with the mask of the SSRs in it, so that all SSRs of
+   *        a bank are switched off by a single register write
+   */
+  std::vector<std::pair<utils::io::GpioBank, uint32_t>> high_power_ssr_banks_;
+
   /**
    * @brief stores the previous state when switch statement checks state machine
    *        conditional statement prevents repetitive actuation
    */
   data::State previous_state_;
-
-  explicit GpioManager(utils::Logger log, const Config &config);
 };
 
 }  // namespace hyped::sensors
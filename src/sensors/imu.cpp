@@ -146,12 +146,12 @@ bool Imu::whoAmI()
 
   for (send_counter = 1; send_counter < 10; send_counter++) {
     readByte(kWhoAmIImu, &data);
-    log_.debug("connected to SPI, data: %d", data);
+    LOG_DEBUG(log_, "connected to SPI, data: %d", data);
     if (data == kWhoAmIResetValue) {
       is_online_ = true;
       break;
     } else {
-      log_.debug("Cannot initialise. Who am I is incorrect");
+      LOG_DEBUG(log_, "Cannot initialise. Who am I is incorrect");
       is_online_ = false;
       utils::concurrent::Thread::yield();
     }
@@ -170,7 +170,7 @@ void Imu::selectBank(uint8_t switch_bank)
 {
   writeByte(kRegBankSel, (switch_bank << 4));
   user_bank_ = switch_bank;
-  log_.debug("User bank switched to %u", user_bank_);
+  LOG_DEBUG(log_, "User bank switched to %u", user_bank_);
 }
 
 void Imu::writeByte(uint8_t write_reg, uint8_t write_data)
@@ -228,27 +228,32 @@ void Imu::setAcclScale()
 int Imu::readFifo(data::ImuData &data)
 {
   if (is_online_) {
-    data.fifo.clear();
+    data.fifo_size = 0;
     // get fifo size
-    uint8_t buffer[kFrameSize];
+    uint8_t buffer[kFrameSize * data::ImuData::kFifoCapacity];
     uint8_t size_buffer[2];
     readBytes(kFifoCountH, reinterpret_cast<uint8_t *>(size_buffer), 2);  // from count H/L
     // convert big->little endian of count (2 bytes)
     uint16_t fifo_size = (((uint16_t)(size_buffer[0] & 0x1F)) << 8) | (size_buffer[1]);
 
     if (fifo_size == 0) {
-      log_.debug("FIFO EMPTY");
+      LOG_DEBUG(log_, "FIFO EMPTY");
       return 0;
     }
-    log_.debug("Buffer size = %d", fifo_size);
+    LOG_DEBUG(log_, "Buffer size = %d", fifo_size);
     int16_t axcounts, aycounts, azcounts;  // include negative int
     float value_x, value_y, value_z;
-    log_.debug("iterating = %lu", fifo_size / kFrameSize);
-    for (size_t i = 0; i < fifo_size / kFrameSize; ++i) {  // make sure is less than array size
-      readBytes(kFifoRW, buffer, kFrameSize);
-      axcounts = (((int16_t)buffer[0]) << 8) | buffer[1];  // 2 byte acc data for xyz
-      aycounts = (((int16_t)buffer[2]) << 8) | buffer[3];
-      azcounts = (((int16_t)buffer[4]) << 8) | buffer[5];
+    // frames that do not fit into data.fifo are left in the hardware FIFO for the next read
+    const size_t num_frames = std::min(fifo_size / kFrameSize, data::ImuData::kFifoCapacity);
+    LOG_DEBUG(log_, "iterating = %lu", num_frames);
+    // FIFO_R_W does not auto-increment, so one burst read pops all frames in a single transfer
+    readBytes(kFifoRW, buffer, static_cast<uint8_t>(num_frames * kFrameSize));
+    for (size_t i = 0; i < num_frames; ++i) {
+      const uint8_t *frame = &buffer[i * kFrameSize];
+
+      axcounts = (((int16_t)frame[0]) << 8) | frame[1];  // 2 byte acc data for xyz
+      aycounts = (((int16_t)frame[2]) << 8) | frame[3];
+      azcounts = (((int16_t)frame[4]) << 8) | frame[5];
 
       value_x = static_cast<float>(axcounts);
       value_y = static_cast<float>(aycounts);
@@ -260,7 +265,7 @@ int Imu::readFifo(data::ImuData &data)
       imu_data[0]      = value_x / acc_divider_ * 9.80665;
       imu_data[1]      = value_y / acc_divider_ * 9.80665;
       imu_data[2]      = value_z / acc_divider_ * 9.80665;
-      data.fifo.push_back(imu_data);
+      data.fifo[data.fifo_size++] = imu_data;
       // log_.INFO("Imu-FIFO", "FIFO readings %d: %f m/s^2, y: %f m/s^2, z: %f m/s^2", 0,
       // imu_data[0], imu_data[1], imu_data[2]);   // NOLINT
     }
@@ -280,12 +285,12 @@ data::ImuData Imu::getData()
     if (is_fifo_) {
       int count = readFifo(imu_data);
       if (count) {
-        log_.debug("Fifo filled");
+        LOG_DEBUG(log_, "Fifo filled");
       } else {
-        log_.debug("Fifo empty");
+        LOG_DEBUG(log_, "Fifo empty");
       }
     } else {
-      log_.debug("Getting Imu data");
+      LOG_DEBUG(log_, "Getting Imu data");
       uint8_t response[8];
       int16_t bit_data;
       float value;
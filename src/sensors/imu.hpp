@@ -41,10 +41,10 @@ class Imu : public IImu {
   data::ImuData getData() override;
 
   /**
-   * @brief calculates number of bytes in FIFO and reads number of full sets (6 bytes) into vector
-   * of ImuData See data.hpp for ImuData struct
+   * @brief calculates number of bytes in FIFO and reads up to ImuData::kFifoCapacity full sets
+   * (6 bytes) into the fifo of ImuData. See data.hpp for ImuData struct
    *
-   * @param data ImuData vector to read number of full sets into
+   * @param data ImuData to read number of full sets into
    * @return 0 if empty
    */
   int readFifo(data::ImuData &data);
@@ -1,5 +1,6 @@
 #include "imu_manager.hpp"
 
+#include <algorithm>
 #include <memory>
 
 #include <sensors/fake_imu.hpp>
@@ -54,14 +55,24 @@ void ImuManager::run()
   auto &sys  = utils::System::getSystem();
   auto &data = data::Data::getInstance();
   while (sys.isRunning()) {
-    data::DataPoint<std::array<data::ImuData, data::Sensors::kNumImus>> imu_data;
-    for (size_t i = 0; i < imus_.size(); ++i) {
-      imu_data.value[i] = imus_.at(i)->getData();
-    }
-    imu_data.timestamp = utils::Timer::getTimeMicros();
-    data.setSensorsImuData(imu_data);
+    data.setSensorsImuData(sample());
   }
   log_.info("stopped");
 }
 
+data::DataPoint<std::array<data::ImuData, data::Sensors::kNumImus>> ImuManager::sample()
+{
+  data::DataPoint<std::array<data::ImuData, data::Sensors::kNumImus>> imu_data;
+  uint64_t latest_timestamp = 0;
+  for (size_t i = 0; i < imus_.size(); ++i) {
+    const uint64_t read_start   = utils::Timer::getTimeMicros();
+    imu_data.value[i]           = imus_.at(i)->getData();
+    const uint64_t read_end     = utils::Timer::getTimeMicros();
+    imu_data.value[i].timestamp = read_start + (read_end - read_start) / 2;
+    latest_timestamp            = std::max(latest_timestamp, imu_data.value[i].timestamp);
+  }
+  imu_data.timestamp = latest_timestamp;
+  return imu_data;
+}
+
 }  // namespace hyped::sensors
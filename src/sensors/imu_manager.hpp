@@ -25,6 +25,13 @@ class ImuManager : public utils::concurrent::Thread {
    */
   void run() override;
 
+  /**
+   * @brief Reads every IMU once. Each reading is stamped with the midpoint of its own read, so the
+   *        IMUs read later in the round are not attributed to the time of the first one. The
+   *        timestamp of the returned point is that of the most recent reading.
+   */
+  data::DataPoint<std::array<data::ImuData, data::Sensors::kNumImus>> sample();
+
  private:
   std::array<std::unique_ptr<IImu>, data::Sensors::kNumImus> imus_;
 };
@@ -21,9 +21,9 @@ Temperature::~Temperature()
 void Temperature::run()
 {
   uint16_t raw_value = pin_.read();
-  log_.debug("raw value: %d", raw_value);
+  LOG_DEBUG(log_, "raw value: %d", raw_value);
   temperature_data_.temperature = scaleData(raw_value);
-  log_.debug("scaled value: %d", temperature_data_.temperature);
+  LOG_DEBUG(log_, "scaled value: %d", temperature_data_.temperature);
   temperature_data_.operational = true;
 }
 
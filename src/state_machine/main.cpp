@@ -19,6 +19,7 @@ void Main::run()
   current_state_->enter(log_);
 
   State *new_state;
+  uint64_t data_version = data.getVersion();
   while (sys.isRunning()) {
     // checkTransition returns a new state or nullptr
     if ((new_state = current_state_->checkTransition(log_))) {
@@ -27,9 +28,9 @@ void Main::run()
       current_state_->enter(log_);
     }
 
-    // Yielding because running the loop twice without any other thread being active
-    // will result in identical behaviour and thus waste resources.
-    yield();
+    // Transitions only depend on the central data structure, so running the loop again before
+    // any of it has been updated would result in identical behaviour and thus waste resources.
+    data_version = data.waitForUpdate(data_version, kUpdateTimeoutMillis);
   }
 
   data::StateMachine sm_data = data.getStateMachineData();
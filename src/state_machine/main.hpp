@@ -15,6 +15,9 @@ class Main : public utils::concurrent::Thread {
  public:
   Main();
 
+  // upper bound on how long we sleep without an update before rechecking whether to exit
+  static constexpr uint32_t kUpdateTimeoutMillis = 100;
+
   /**
    *  @brief  Runs state machine thread.
    */
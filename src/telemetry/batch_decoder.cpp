@@ -0,0 +1,115 @@
+#include "batch_decoder.hpp"
+#include "binary_decoder.hpp"
+
+#include <utility>
+
+namespace hyped::telemetry {
+
+namespace {
+
+bool readString(const uint8_t *&position, const uint8_t *end, std::string &value)
+{
+  uint64_t length;
+  if (!binary::readVarint(position, end, length)) { return false; }
+  if (length > static_cast<uint64_t>(end - position)) { return false; }
+  value.assign(reinterpret_cast<const char *>(position), length);
+  position += length;
+  return true;
+}
+
+}  // namespace
+
+BatchDecoder::BatchDecoder()
+    : frame_type_(binary::FrameType::kColumns),
+      id_(0),
+      columns_(binary::getColumns())
+{
+}
+
+bool BatchDecoder::decode(const uint8_t *data, const std::size_t len)
+{
+  const auto size = BinaryDecoder::getFrameSize(data, len);
+  if (!size || *size != len) { return false; }
+  const uint8_t *body = data + binary::kHeaderSize;
+  switch (static_cast<binary::FrameType>(data[3])) {
+    case binary::FrameType::kColumns:
+      return decodeColumns(body, data + len);
+    case binary::FrameType::kBatch:
+      return decodeBatch(body, data + len);
+    default:
+      return false;
+  }
+}
+
+std::optional<std::size_t> BatchDecoder::findColumn(const std::string &name) const
+{
+  for (std::size_t column = 0; column < columns_.size(); ++column) {
+    if (columns_[column].name == name) { return column; }
+  }
+  return std::nullopt;
+}
+
+bool BatchDecoder::decodeColumns(const uint8_t *position, const uint8_t *end)
+{
+  uint64_t num_columns;
+  if (!binary::readVarint(position, end, num_columns)) { return false; }
+  // every column takes at least two bytes, which bounds the allocation for corrupt frames
+  if (num_columns > static_cast<uint64_t>(end - position) / 2) { return false; }
+  std::vector<binary::Column> columns(num_columns);
+  for (auto &column : columns) {
+    if (!readString(position, end, column.name) || !readString(position, end, column.unit)) {
+      return false;
+    }
+  }
+  if (position != end) { return false; }
+  frame_type_ = binary::FrameType::kColumns;
+  columns_    = std::move(columns);
+  times_.clear();
+  values_.clear();
+  return true;
+}
+
+bool BatchDecoder::decodeBatch(const uint8_t *position, const uint8_t *end)
+{
+  uint64_t id;
+  uint64_t num_rows;
+  uint64_t num_columns;
+  if (!binary::readVarint(position, end, id) || !binary::readVarint(position, end, num_rows)
+      || !binary::readVarint(position, end, num_columns)) {
+    return false;
+  }
+  if (num_rows > binary::kMaxBatchSize) { return false; }
+  std::vector<uint64_t> times(num_rows);
+  for (uint64_t row = 0; row < num_rows; ++row) {
+    uint64_t time;
+    if (!binary::readVarint(position, end, time)) { return false; }
+    times[row] = row == 0 ? time : times[row - 1] + binary::zigzagDecode(time);
+  }
+  std::vector<int64_t> values(num_rows * columns_.size(), 0);
+  for (uint64_t column = 0; num_rows > 0 && column < num_columns; ++column) {
+    if (position == end) { return false; }
+    const auto encoding = static_cast<binary::ColumnEncoding>(*position++);
+    if (encoding != binary::ColumnEncoding::kConstant
+        && encoding != binary::ColumnEncoding::kDelta) {
+      return false;
+    }
+    uint64_t value;
+    if (!binary::readVarint(position, end, value)) { return false; }
+    int64_t current = binary::zigzagDecode(value);
+    for (uint64_t row = 0; row < num_rows; ++row) {
+      if (row > 0 && encoding == binary::ColumnEncoding::kDelta) {
+        if (!binary::readVarint(position, end, value)) { return false; }
+        current += binary::zigzagDecode(value);
+      }
+      if (column < columns_.size()) { values[row * columns_.size() + column] = current; }
+    }
+  }
+  if (position != end) { return false; }
+  frame_type_ = binary::FrameType::kBatch;
+  id_         = static_cast<uint32_t>(id);
+  times_      = std::move(times);
+  values_     = std::move(values);
+  return true;
+}
+
+}  // namespace hyped::telemetry
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "binary_schema.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace hyped::telemetry {
+
+/**
+ * @brief Decodes the frames built by BatchWriter, as the ground station would. Starts out with the
+ *        columns compiled into this binary and replaces them with any column frame it decodes.
+ *        Frames can be split from the stream with BinaryDecoder::getFrameSize.
+ */
+class BatchDecoder {
+ public:
+  BatchDecoder();
+
+  /**
+   * @brief Decodes one complete column or batch frame. Columns beyond the known ones are skipped.
+   *
+   * @return false if the frame is truncated or malformed, in which case the last batch is kept
+   */
+  bool decode(const uint8_t *data, const std::size_t len);
+
+  binary::FrameType getFrameType() const { return frame_type_; }
+  uint32_t getId() const { return id_; }
+  const std::vector<binary::Column> &getColumns() const { return columns_; }
+  std::size_t getNumRows() const { return times_.size(); }
+  // time of the given sample of the last batch in microseconds
+  uint64_t getTime(const std::size_t row) const { return times_.at(row); }
+  int64_t getValue(const std::size_t row, const std::size_t column) const
+  {
+    return values_.at(row * columns_.size() + column);
+  }
+
+  /**
+   * @return the index of the column with the given name, std::nullopt if there is none
+   */
+  std::optional<std::size_t> findColumn(const std::string &name) const;
+
+ private:
+  bool decodeColumns(const uint8_t *position, const uint8_t *end);
+  bool decodeBatch(const uint8_t *position, const uint8_t *end);
+
+  binary::FrameType frame_type_;
+  uint32_t id_;
+  std::vector<binary::Column> columns_;
+  std::vector<uint64_t> times_;
+  // row after row, each with a value for every column
+  std::vector<int64_t> values_;
+};
+
+}  // namespace hyped::telemetry
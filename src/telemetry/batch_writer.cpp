@@ -0,0 +1,81 @@
+#include "batch_writer.hpp"
+
+#include <algorithm>
+
+namespace hyped::telemetry {
+
+BatchWriter::BatchWriter(const std::size_t batch_size)
+    : times_(std::clamp<std::size_t>(batch_size, 1, binary::kMaxBatchSize), 0),
+      rows_(times_.size()),
+      num_rows_(0)
+{
+  // every sample time and value takes at most ten bytes, plus the encoding byte of each column
+  static_assert(binary::kHeaderSize + 4 * 10
+                  + binary::kMaxBatchSize * (binary::kNumColumns + 1) * 10 + binary::kNumColumns
+                <= binary::kMaxFrameSize);
+  buffer_.reserve(binary::kHeaderSize + 4 * 10
+                  + rows_.size() * (binary::kNumColumns + 1) * 10 + binary::kNumColumns);
+}
+
+void BatchWriter::packColumns()
+{
+  const auto &columns = binary::getColumns();
+  binary::startFrame(buffer_, binary::FrameType::kColumns);
+  binary::appendVarint(buffer_, columns.size());
+  for (const auto &column : columns) {
+    binary::appendVarint(buffer_, column.name.size());
+    buffer_.insert(buffer_.end(), column.name.begin(), column.name.end());
+    binary::appendVarint(buffer_, column.unit.size());
+    buffer_.insert(buffer_.end(), column.unit.begin(), column.unit.end());
+  }
+  binary::endFrame(buffer_);
+}
+
+bool BatchWriter::addRow(const uint64_t time, const binary::Row &row)
+{
+  if (num_rows_ < rows_.size()) {
+    times_[num_rows_] = time;
+    rows_[num_rows_]  = row;
+    ++num_rows_;
+  }
+  return num_rows_ == rows_.size();
+}
+
+void BatchWriter::packBatch(const uint32_t id)
+{
+  binary::startFrame(buffer_, binary::FrameType::kBatch);
+  binary::appendVarint(buffer_, id);
+  binary::appendVarint(buffer_, num_rows_);
+  binary::appendVarint(buffer_, binary::kNumColumns);
+  if (num_rows_ > 0) {
+    binary::appendVarint(buffer_, times_[0]);
+    // timestamps may wrap around, so the differences are signed
+    for (std::size_t i = 1; i < num_rows_; ++i) {
+      binary::appendVarint(
+        buffer_, binary::zigzagEncode(static_cast<int64_t>(times_[i] - times_[i - 1])));
+    }
+    for (std::size_t column = 0; column < binary::kNumColumns; ++column) {
+      appendColumn(column);
+    }
+  }
+  binary::endFrame(buffer_);
+  num_rows_ = 0;
+}
+
+void BatchWriter::appendColumn(const std::size_t column)
+{
+  const int64_t first = rows_[0][column];
+  bool is_constant    = true;
+  for (std::size_t i = 1; i < num_rows_ && is_constant; ++i) {
+    is_constant = rows_[i][column] == first;
+  }
+  buffer_.push_back(static_cast<uint8_t>(is_constant ? binary::ColumnEncoding::kConstant
+                                                     : binary::ColumnEncoding::kDelta));
+  binary::appendVarint(buffer_, binary::zigzagEncode(first));
+  if (is_constant) { return; }
+  for (std::size_t i = 1; i < num_rows_; ++i) {
+    binary::appendVarint(buffer_, binary::zigzagEncode(rows_[i][column] - rows_[i - 1][column]));
+  }
+}
+
+}  // namespace hyped::telemetry
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "binary_schema.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hyped::telemetry {
+
+/*
+  Packs samples of the high rate channel into the column and batch frames described in
+  binary_schema.hpp. Samples are collected with addRow() until the batch is full and then packed
+  together by packBatch(), which starts the next batch. A receiver needs a column frame before it
+  can name the columns of a batch, so packColumns() should be sent once after connecting.
+
+  Rows and frame buffer are allocated up front for the configured batch size, so collecting and
+  packing samples does not allocate.
+*/
+class BatchWriter {
+ public:
+  explicit BatchWriter(const std::size_t batch_size);
+
+  // packs the name and unit of every column
+  void packColumns();
+
+  // adds a sample taken at `time` in microseconds; returns true once the batch is full
+  bool addRow(const uint64_t time, const binary::Row &row);
+
+  // packs the samples added since the last batch, at most the batch size, and starts a new batch
+  void packBatch(const uint32_t id);
+
+  std::size_t getBatchSize() const { return rows_.size(); }
+  std::size_t getNumRows() const { return num_rows_; }
+
+  // the last packed frame, header included
+  const uint8_t *getData() const { return buffer_.data(); }
+  std::size_t getSize() const { return buffer_.size(); }
+
+ private:
+  void appendColumn(const std::size_t column);
+
+  std::vector<uint8_t> buffer_;
+  std::vector<uint64_t> times_;
+  std::vector<binary::Row> rows_;
+  std::size_t num_rows_;
+};
+
+}  // namespace hyped::telemetry
@@ -0,0 +1,131 @@
+#include "binary_decoder.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace hyped::telemetry {
+
+BinaryDecoder::BinaryDecoder()
+    : frame_type_(binary::FrameType::kSchema),
+      id_(0),
+      time_(0),
+      has_state_(false),
+      schema_(binary::getSchema()),
+      values_(schema_.size(), 0)
+{
+}
+
+std::optional<std::size_t> BinaryDecoder::getFrameSize(const uint8_t *data, const std::size_t len)
+{
+  if (len < binary::kHeaderSize) { return std::nullopt; }
+  if (!std::equal(binary::kMagic.begin(), binary::kMagic.end(), data)) { return std::nullopt; }
+  if (data[2] != binary::kVersion) { return std::nullopt; }
+  const std::size_t size = data[4] | (static_cast<std::size_t>(data[5]) << 8);
+  if (size < binary::kHeaderSize) { return std::nullopt; }
+  return size;
+}
+
+bool BinaryDecoder::decode(const uint8_t *data, const std::size_t len)
+{
+  const auto size = getFrameSize(data, len);
+  if (!size || *size != len) { return false; }
+  const uint8_t *body = data + binary::kHeaderSize;
+  switch (static_cast<binary::FrameType>(data[3])) {
+    case binary::FrameType::kSchema:
+      return decodeSchema(body, data + len);
+    case binary::FrameType::kFull:
+      return decodeFull(body, data + len);
+    case binary::FrameType::kDelta:
+      if (decodeDelta(body, data + len)) { return true; }
+      has_state_ = false;
+      return false;
+    default:
+      return false;
+  }
+}
+
+std::optional<int64_t> BinaryDecoder::getValue(const std::string &name) const
+{
+  for (std::size_t field = 0; field < schema_.size(); ++field) {
+    if (schema_[field].name == name) { return values_[field]; }
+  }
+  return std::nullopt;
+}
+
+bool BinaryDecoder::decodeSchema(const uint8_t *position, const uint8_t *end)
+{
+  uint64_t num_fields;
+  if (!binary::readVarint(position, end, num_fields)) { return false; }
+  // every field takes at least three bytes, which bounds the allocation for corrupt frames
+  if (num_fields > static_cast<uint64_t>(end - position) / 3) { return false; }
+  std::vector<binary::Field> schema(num_fields);
+  for (uint64_t i = 0; i < num_fields; ++i) {
+    uint64_t id;
+    uint64_t name_length;
+    if (!binary::readVarint(position, end, id) || id >= num_fields) { return false; }
+    if (position == end) { return false; }
+    schema[id].type = static_cast<binary::FieldType>(*position++);
+    if (!binary::readVarint(position, end, name_length)) { return false; }
+    if (name_length > static_cast<uint64_t>(end - position)) { return false; }
+    schema[id].name.assign(reinterpret_cast<const char *>(position), name_length);
+    position += name_length;
+  }
+  if (position != end) { return false; }
+  frame_type_ = binary::FrameType::kSchema;
+  has_state_  = false;
+  schema_     = std::move(schema);
+  values_.assign(schema_.size(), 0);
+  return true;
+}
+
+bool BinaryDecoder::decodeFull(const uint8_t *position, const uint8_t *end)
+{
+  uint64_t id;
+  uint64_t time;
+  uint64_t num_fields;
+  if (!binary::readVarint(position, end, id) || !binary::readVarint(position, end, time)
+      || !binary::readVarint(position, end, num_fields)) {
+    return false;
+  }
+  // decode into a copy so that a malformed frame leaves the state as it was
+  std::vector<int64_t> values(values_.size(), 0);
+  for (uint64_t field = 0; field < num_fields; ++field) {
+    uint64_t value;
+    if (!binary::readVarint(position, end, value)) { return false; }
+    if (field < values.size()) { values[field] = binary::zigzagDecode(value); }
+  }
+  if (position != end) { return false; }
+  frame_type_ = binary::FrameType::kFull;
+  id_         = static_cast<uint32_t>(id);
+  time_       = time;
+  has_state_  = true;
+  values_     = std::move(values);
+  return true;
+}
+
+bool BinaryDecoder::decodeDelta(const uint8_t *position, const uint8_t *end)
+{
+  uint64_t id;
+  uint64_t elapsed;
+  if (!binary::readVarint(position, end, id) || !binary::readVarint(position, end, elapsed)) {
+    return false;
+  }
+  // the changes are relative to the previous frame, so none may have been missed
+  if (!has_state_ || id != static_cast<uint32_t>(id_ + 1)) { return false; }
+  std::vector<int64_t> values = values_;
+  while (position != end) {
+    uint64_t field;
+    uint64_t value;
+    if (!binary::readVarint(position, end, field) || !binary::readVarint(position, end, value)) {
+      return false;
+    }
+    if (field < values.size()) { values[field] = binary::zigzagDecode(value); }
+  }
+  frame_type_ = binary::FrameType::kDelta;
+  id_         = static_cast<uint32_t>(id);
+  time_ += elapsed;
+  values_ = std::move(values);
+  return true;
+}
+
+}  // namespace hyped::telemetry
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "binary_schema.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace hyped::telemetry {
+
+/**
+ * @brief Decodes the frames built by BinaryWriter, as the ground station would. Starts out with
+ *        the schema compiled into this binary and replaces it with any schema frame it decodes.
+ *        Delta frames are applied to the state of the previous frame, so the values always hold
+ *        the full state of the pod as of the last decoded frame.
+ */
+class BinaryDecoder {
+ public:
+  BinaryDecoder();
+
+  /**
+   * @brief Returns the size of the frame at the start of `data` so that a stream can be split into
+   *        frames, or std::nullopt if the header is incomplete or not a supported frame header.
+   */
+  static std::optional<std::size_t> getFrameSize(const uint8_t *data, const std::size_t len);
+
+  /**
+   * @brief Decodes one complete frame. Fields with ids beyond the schema are skipped.
+   *
+   * @return false if the frame is truncated or malformed, or if it is a delta frame that does not
+   *         directly follow the last decoded frame, in which case the state is unchanged and
+   *         further delta frames are rejected until the next full frame
+   */
+  bool decode(const uint8_t *data, const std::size_t len);
+
+  binary::FrameType getFrameType() const { return frame_type_; }
+  uint32_t getId() const { return id_; }
+  uint64_t getTime() const { return time_; }
+  // whether the values hold a full state, i.e. a full frame was decoded since the last schema
+  bool hasState() const { return has_state_; }
+  const std::vector<binary::Field> &getSchema() const { return schema_; }
+  const std::vector<int64_t> &getValues() const { return values_; }
+  int64_t getValue(const std::size_t field) const { return values_.at(field); }
+
+  /**
+   * @return the value of the field with the given name, std::nullopt if the schema lacks it
+   */
+  std::optional<int64_t> getValue(const std::string &name) const;
+
+ private:
+  bool decodeSchema(const uint8_t *position, const uint8_t *end);
+  bool decodeFull(const uint8_t *position, const uint8_t *end);
+  bool decodeDelta(const uint8_t *position, const uint8_t *end);
+
+  binary::FrameType frame_type_;
+  uint32_t id_;
+  uint64_t time_;
+  bool has_state_;
+  std::vector<binary::Field> schema_;
+  std::vector<int64_t> values_;
+};
+
+}  // namespace hyped::telemetry
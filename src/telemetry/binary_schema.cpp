@@ -0,0 +1,219 @@
+#include "binary_schema.hpp"
+
+#include <cmath>
+
+namespace hyped::telemetry::binary {
+
+namespace {
+
+void addBatteryFields(std::vector<Field> &schema, const std::string &prefix)
+{
+  schema.push_back({prefix + "/average_temp", FieldType::kInt});
+  schema.push_back({prefix + "/voltage", FieldType::kInt});
+  schema.push_back({prefix + "/current", FieldType::kInt});
+  schema.push_back({prefix + "/charge", FieldType::kInt});
+  schema.push_back({prefix + "/low_temp", FieldType::kInt});
+  schema.push_back({prefix + "/high_temp", FieldType::kInt});
+  schema.push_back({prefix + "/low_voltage_cell", FieldType::kInt});
+  schema.push_back({prefix + "/high_voltage_cell", FieldType::kInt});
+  schema.push_back({prefix + "/insulation_monitoring_device_fault", FieldType::kBool});
+}
+
+std::vector<Field> makeSchema()
+{
+  std::vector<Field> schema;
+  schema.reserve(kNumFields);
+  schema.push_back({"/telemetry/calibrate", FieldType::kBool});
+  schema.push_back({"/telemetry/emergency_stop", FieldType::kBool});
+  schema.push_back({"/telemetry/launch", FieldType::kBool});
+  schema.push_back({"/telemetry/nominal_breaking", FieldType::kBool});
+  schema.push_back({"/telemetry/service_propulsion_go", FieldType::kBool});
+  schema.push_back({"/telemetry/shutdown", FieldType::kBool});
+  schema.push_back({"/telemetry/telemetry_status", FieldType::kModuleStatus});
+  schema.push_back({"/navigation/braking_distance", FieldType::kInt});
+  schema.push_back({"/navigation/displacement", FieldType::kInt});
+  schema.push_back({"/navigation/emergency_braking_distance", FieldType::kInt});
+  schema.push_back({"/navigation/velocity", FieldType::kInt});
+  schema.push_back({"/navigation/acceleration", FieldType::kInt});
+  schema.push_back({"/navigation/navigation_status", FieldType::kModuleStatus});
+  for (std::size_t i = 0; i < data::FullBatteryData::kNumLPBatteries; ++i) {
+    addBatteryFields(schema, "/sensors/lp_batteries/" + std::to_string(i));
+  }
+  for (std::size_t i = 0; i < data::FullBatteryData::kNumHPBatteries; ++i) {
+    addBatteryFields(schema, "/sensors/hp_batteries/" + std::to_string(i));
+  }
+  for (std::size_t i = 0; i < data::Brakes::kNumBrakes; ++i) {
+    schema.push_back({"/sensors/brakes_retracted/" + std::to_string(i), FieldType::kBool});
+  }
+  schema.push_back({"/sensors/temperature", FieldType::kInt});
+  schema.push_back({"/sensors/pressure", FieldType::kInt});
+  schema.push_back({"/sensors/brakes_status", FieldType::kModuleStatus});
+  schema.push_back({"/sensors/sensors_status", FieldType::kModuleStatus});
+  schema.push_back({"/sensors/batteries_status", FieldType::kModuleStatus});
+  for (std::size_t i = 0; i < data::Motors::kNumMotors; ++i) {
+    schema.push_back({"/motors/motor_rpms/" + std::to_string(i), FieldType::kInt});
+  }
+  schema.push_back({"/motors/motors_status", FieldType::kModuleStatus});
+  schema.push_back({"/state_machine/critical_failure", FieldType::kBool});
+  schema.push_back({"/state_machine/current_state", FieldType::kState});
+  return schema;
+}
+
+std::vector<Column> makeColumns()
+{
+  static constexpr const char *kAxes[] = {"x", "y", "z"};
+  std::vector<Column> columns;
+  columns.reserve(kNumColumns);
+  for (std::size_t i = 0; i < data::Sensors::kNumImus; ++i) {
+    for (const char *axis : kAxes) {
+      columns.push_back({"/sensors/imu/" + std::to_string(i) + "/acc/" + axis, "mm/s^2"});
+    }
+  }
+  for (std::size_t i = 0; i < data::Sensors::kNumEncoders; ++i) {
+    columns.push_back({"/sensors/wheel_encoders/" + std::to_string(i), "count"});
+  }
+  for (std::size_t i = 0; i < data::FullBatteryData::kNumHPBatteries; ++i) {
+    for (std::size_t cell = 0; cell < data::BatteryData::kNumCells; ++cell) {
+      columns.push_back(
+        {"/sensors/hp_batteries/" + std::to_string(i) + "/cell_voltage/" + std::to_string(cell),
+         "mV"});
+    }
+  }
+  return columns;
+}
+
+void captureBattery(const data::BatteryData &battery, const std::size_t first,
+                    const std::size_t index, Values &values)
+{
+  int64_t *battery_values          = &values[getBatteryField(first, index, kAverageTemp)];
+  battery_values[kAverageTemp]     = battery.average_temperature;
+  battery_values[kVoltage]         = battery.voltage;
+  battery_values[kCurrent]         = battery.current;
+  battery_values[kCharge]          = battery.charge;
+  battery_values[kLowTemp]         = battery.low_temperature;
+  battery_values[kHighTemp]        = battery.high_temperature;
+  battery_values[kLowVoltageCell]  = battery.low_voltage_cell;
+  battery_values[kHighVoltageCell] = battery.high_voltage_cell;
+  battery_values[kImdFault]        = battery.insulation_monitoring_device_fault;
+}
+
+}  // namespace
+
+const std::vector<Field> &getSchema()
+{
+  static const std::vector<Field> schema = makeSchema();
+  return schema;
+}
+
+void capture(data::Data &data, Values &values)
+{
+  const auto telemetry_data    = data.getTelemetryData();
+  values[kCalibrate]           = telemetry_data.calibrate_command;
+  values[kEmergencyStop]       = telemetry_data.emergency_stop_command;
+  values[kLaunch]              = telemetry_data.launch_command;
+  values[kNominalBraking]      = telemetry_data.nominal_braking_command;
+  values[kServicePropulsionGo] = telemetry_data.service_propulsion_go;
+  values[kShutdown]            = telemetry_data.shutdown_command;
+  values[kTelemetryStatus]     = static_cast<int64_t>(telemetry_data.module_status);
+
+  // truncated to whole units like the JSON packets
+  const auto nav_data               = data.getNavigationData();
+  values[kBrakingDistance]          = static_cast<int64_t>(nav_data.braking_distance);
+  values[kDisplacement]             = static_cast<int64_t>(nav_data.displacement);
+  values[kEmergencyBrakingDistance] = static_cast<int64_t>(nav_data.emergency_braking_distance);
+  values[kVelocity]                 = static_cast<int64_t>(nav_data.velocity);
+  values[kAcceleration]             = static_cast<int64_t>(nav_data.acceleration);
+  values[kNavigationStatus]         = static_cast<int64_t>(nav_data.module_status);
+
+  const auto sensors_data   = data.getSensorsData();
+  const auto batteries_data = data.getBatteriesData();
+  const auto brakes_data    = data.getBrakesData();
+  for (std::size_t i = 0; i < data::FullBatteryData::kNumLPBatteries; ++i) {
+    captureBattery(batteries_data.low_power_batteries[i], kLpBatteries, i, values);
+  }
+  for (std::size_t i = 0; i < data::FullBatteryData::kNumHPBatteries; ++i) {
+    captureBattery(batteries_data.high_power_batteries[i], kHpBatteries, i, values);
+  }
+  for (std::size_t i = 0; i < data::Brakes::kNumBrakes; ++i) {
+    values[kBrakesRetracted + i] = brakes_data.brakes_retracted[i];
+  }
+  values[kTemperature]     = sensors_data.temperature.temperature;
+  values[kPressure]        = sensors_data.ambient_pressure.ambient_pressure;
+  values[kBrakesStatus]    = static_cast<int64_t>(brakes_data.module_status);
+  values[kSensorsStatus]   = static_cast<int64_t>(sensors_data.module_status);
+  values[kBatteriesStatus] = static_cast<int64_t>(batteries_data.module_status);
+
+  const auto motor_data = data.getMotorData();
+  for (std::size_t i = 0; i < data::Motors::kNumMotors; ++i) {
+    values[kMotorRpms + i] = motor_data.rpms[i];
+  }
+  values[kMotorsStatus] = static_cast<int64_t>(motor_data.module_status);
+
+  const auto sm_data       = data.getStateMachineData();
+  values[kCriticalFailure] = sm_data.critical_failure;
+  values[kCurrentState]    = static_cast<int64_t>(sm_data.current_state);
+}
+
+const std::vector<Column> &getColumns()
+{
+  static const std::vector<Column> columns = makeColumns();
+  return columns;
+}
+
+void captureRow(const data::Sensors &sensors, const data::FullBatteryData &batteries, Row &row)
+{
+  for (std::size_t i = 0; i < data::Sensors::kNumImus; ++i) {
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      row[kImuAcceleration + 3 * i + axis] = std::lround(sensors.imu.value[i].acc[axis] * 1000.0);
+    }
+  }
+  for (std::size_t i = 0; i < data::Sensors::kNumEncoders; ++i) {
+    row[kEncoderCounts + i] = sensors.wheel_encoders[i].value;
+  }
+  for (std::size_t i = 0; i < data::FullBatteryData::kNumHPBatteries; ++i) {
+    const auto &cell_voltage = batteries.high_power_batteries[i].cell_voltage;
+    for (std::size_t cell = 0; cell < data::BatteryData::kNumCells; ++cell) {
+      row[kCellVoltages + i * data::BatteryData::kNumCells + cell] = cell_voltage[cell];
+    }
+  }
+}
+
+void startFrame(std::vector<uint8_t> &buffer, const FrameType type)
+{
+  // length is filled in by endFrame
+  buffer.assign(kHeaderSize, 0);
+  buffer[0] = kMagic[0];
+  buffer[1] = kMagic[1];
+  buffer[2] = kVersion;
+  buffer[3] = static_cast<uint8_t>(type);
+}
+
+void endFrame(std::vector<uint8_t> &buffer)
+{
+  const std::size_t size = buffer.size();
+  buffer[4]              = static_cast<uint8_t>(size & 0xff);
+  buffer[5]              = static_cast<uint8_t>(size >> 8);
+}
+
+void appendVarint(std::vector<uint8_t> &buffer, uint64_t value)
+{
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<uint8_t>(value));
+}
+
+bool readVarint(const uint8_t *&position, const uint8_t *end, uint64_t &value)
+{
+  value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (position == end) { return false; }
+    const uint8_t byte = *position++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) { return true; }
+  }
+  return false;
+}
+
+}  // namespace hyped::telemetry::binary
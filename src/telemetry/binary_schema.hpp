@@ -0,0 +1,191 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <data/data.hpp>
+
+namespace hyped::telemetry::binary {
+
+/*
+  Binary telemetry frames carry the same values as the JSON packets built by Writer in a fraction
+  of the space. Every frame starts with a fixed header
+
+    magic (2 bytes) | version (1) | frame type (1) | frame length including header (2, LE)
+
+  followed by a body that depends on the frame type. Integers in the body are LEB128 varints and
+  signed values are zigzag encoded first, so the small numbers that make up most of the pod state
+  take a single byte. Field ids are positions in the schema; a full frame states how many fields
+  it carries and then lists their values in id order, so a receiver skips trailing fields it does
+  not know and older ground stations keep working when fields are appended to the schema.
+
+  Most fields rarely change between packets, so instead of a full frame the sender may send a delta
+  frame that holds only the (field id, value) pairs of the fields that changed since the previous
+  frame. The receiver applies it to the state of that frame; full frames act as keyframes from
+  which a receiver that joined late, or lost its state, can start over.
+
+  The high rate channel streams raw sensor samples that are too many to fit in the packets above.
+  Its frames share the header, but carry a column schema and batches of samples instead. A batch
+  holds a number of samples of every column and is stored column by column: the time of the first
+  sample in microseconds, the (zigzag) difference to the previous sample for the others, then for
+  each column an encoding byte followed by its values. A column either holds the same value in
+  every sample, which is sent once, or the first value followed by the difference of each sample
+  to the one before. Sensor readings change little between samples, so most take a single byte.
+*/
+static constexpr std::array<uint8_t, 2> kMagic = {'H', 'T'};
+static constexpr uint8_t kVersion              = 1;
+static constexpr std::size_t kHeaderSize       = 6;
+static constexpr std::size_t kMaxFrameSize     = UINT16_MAX;
+
+enum class FrameType : uint8_t {
+  kSchema,   // number of fields, then id, type and name of each field
+  kFull,     // packet id, time in milliseconds, number of fields, then the value of every field
+  kDelta,    // packet id, milliseconds since the previous frame, then (field id, value) pairs
+  kColumns,  // number of columns, then name and unit of each column
+  kBatch,    // batch id, number of samples, number of columns, then sample times and columns
+};
+
+enum class FieldType : uint8_t {
+  kBool,
+  kInt,
+  kModuleStatus,  // data::ModuleStatus
+  kState,         // data::State
+};
+
+struct Field {
+  std::string name;  // JSON pointer to the same value in the packets built by Writer
+  FieldType type;
+};
+
+enum BatteryField : std::size_t {
+  kAverageTemp,
+  kVoltage,
+  kCurrent,
+  kCharge,
+  kLowTemp,
+  kHighTemp,
+  kLowVoltageCell,
+  kHighVoltageCell,
+  kImdFault,
+  kNumBatteryFields
+};
+
+// ids are positions in the schema; new fields must only ever be appended
+enum FieldId : std::size_t {
+  kCalibrate,
+  kEmergencyStop,
+  kLaunch,
+  kNominalBraking,
+  kServicePropulsionGo,
+  kShutdown,
+  kTelemetryStatus,
+  kBrakingDistance,
+  kDisplacement,
+  kEmergencyBrakingDistance,
+  kVelocity,
+  kAcceleration,
+  kNavigationStatus,
+  kLpBatteries,
+  kHpBatteries = kLpBatteries + data::FullBatteryData::kNumLPBatteries * kNumBatteryFields,
+  kBrakesRetracted = kHpBatteries + data::FullBatteryData::kNumHPBatteries * kNumBatteryFields,
+  kTemperature     = kBrakesRetracted + data::Brakes::kNumBrakes,
+  kPressure,
+  kBrakesStatus,
+  kSensorsStatus,
+  kBatteriesStatus,
+  kMotorRpms,
+  kMotorsStatus = kMotorRpms + data::Motors::kNumMotors,
+  kCriticalFailure,
+  kCurrentState,
+  kNumFields
+};
+
+using Values = std::array<int64_t, kNumFields>;
+
+struct Column {
+  std::string name;  // JSON pointer style path, following the names of the fields
+  std::string unit;
+};
+
+enum class ColumnEncoding : uint8_t {
+  kConstant,  // a single value shared by every sample
+  kDelta,     // the first value, then the difference of each sample to the previous one
+};
+
+// columns of the high rate channel; like field ids, new columns must only ever be appended
+enum ColumnId : std::size_t {
+  kImuAcceleration,  // x, y and z of each IMU
+  kEncoderCounts = kImuAcceleration + data::Sensors::kNumImus * 3,
+  kCellVoltages  = kEncoderCounts + data::Sensors::kNumEncoders,  // cells of each HP battery
+  kNumColumns
+    = kCellVoltages + data::FullBatteryData::kNumHPBatteries * data::BatteryData::kNumCells
+};
+
+using Row = std::array<int64_t, kNumColumns>;
+
+// the largest batch that is guaranteed to fit in a frame
+static constexpr std::size_t kMaxBatchSize = 64;
+
+/**
+ * @brief Id of a field of the `index`th battery in the group starting at `first`.
+ */
+constexpr std::size_t getBatteryField(const std::size_t first, const std::size_t index,
+                                      const BatteryField field)
+{
+  return first + index * kNumBatteryFields + field;
+}
+
+/**
+ * @return the fields in the order of their ids
+ */
+const std::vector<Field> &getSchema();
+
+/**
+ * @brief Reads the current value of every field from the central data structure.
+ */
+void capture(data::Data &data, Values &values);
+
+/**
+ * @return the columns of the high rate channel in the order of their ids
+ */
+const std::vector<Column> &getColumns();
+
+/**
+ * @brief Converts a sample of the sensors and batteries to the columns of the high rate channel.
+ *        Accelerations are rounded to mm/s^2.
+ */
+void captureRow(const data::Sensors &sensors, const data::FullBatteryData &batteries, Row &row);
+
+/**
+ * @brief Starts a frame of the given type in `buffer`, discarding its contents.
+ */
+void startFrame(std::vector<uint8_t> &buffer, const FrameType type);
+
+/**
+ * @brief Fills in the length of the frame in `buffer` once its body has been appended.
+ */
+void endFrame(std::vector<uint8_t> &buffer);
+
+void appendVarint(std::vector<uint8_t> &buffer, uint64_t value);
+
+/**
+ * @brief Reads a varint starting at `position` and advances it past the varint.
+ *
+ * @return false if the varint runs past `end` or is longer than 64 bits
+ */
+bool readVarint(const uint8_t *&position, const uint8_t *end, uint64_t &value);
+
+constexpr uint64_t zigzagEncode(const int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+constexpr int64_t zigzagDecode(const uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+}  // namespace hyped::telemetry::binary
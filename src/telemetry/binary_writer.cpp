@@ -0,0 +1,85 @@
+#include "binary_writer.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+namespace hyped::telemetry {
+
+BinaryWriter::BinaryWriter()
+    : previous_time_(0),
+      has_previous_(false),
+      data_(data::Data::getInstance())
+{
+  // a delta frame with every field changed is the largest, at most ten bytes per varint
+  buffer_.reserve(binary::kHeaderSize + (2 + 2 * binary::kNumFields) * 10);
+}
+
+void BinaryWriter::packSchema()
+{
+  const auto &schema = binary::getSchema();
+  binary::startFrame(buffer_, binary::FrameType::kSchema);
+  binary::appendVarint(buffer_, schema.size());
+  for (std::size_t id = 0; id < schema.size(); ++id) {
+    binary::appendVarint(buffer_, id);
+    buffer_.push_back(static_cast<uint8_t>(schema[id].type));
+    binary::appendVarint(buffer_, schema[id].name.size());
+    buffer_.insert(buffer_.end(), schema[id].name.begin(), schema[id].name.end());
+  }
+  binary::endFrame(buffer_);
+}
+
+void BinaryWriter::packFull(const uint32_t id)
+{
+  binary::capture(data_, values_);
+  packFull(id, getTime(), values_);
+}
+
+void BinaryWriter::packFull(const uint32_t id, const uint64_t time, const binary::Values &values)
+{
+  binary::startFrame(buffer_, binary::FrameType::kFull);
+  binary::appendVarint(buffer_, id);
+  binary::appendVarint(buffer_, time);
+  binary::appendVarint(buffer_, values.size());
+  for (const int64_t value : values) {
+    binary::appendVarint(buffer_, binary::zigzagEncode(value));
+  }
+  binary::endFrame(buffer_);
+  previous_values_ = values;
+  previous_time_   = time;
+  has_previous_    = true;
+}
+
+void BinaryWriter::packDelta(const uint32_t id)
+{
+  binary::capture(data_, values_);
+  packDelta(id, getTime(), values_);
+}
+
+void BinaryWriter::packDelta(const uint32_t id, const uint64_t time, const binary::Values &values)
+{
+  // the time is sent relative to the previous frame and cannot go backwards
+  if (!has_previous_ || time < previous_time_) {
+    packFull(id, time, values);
+    return;
+  }
+  binary::startFrame(buffer_, binary::FrameType::kDelta);
+  binary::appendVarint(buffer_, id);
+  binary::appendVarint(buffer_, time - previous_time_);
+  for (std::size_t field = 0; field < values.size(); ++field) {
+    if (values[field] == previous_values_[field]) { continue; }
+    binary::appendVarint(buffer_, field);
+    binary::appendVarint(buffer_, binary::zigzagEncode(values[field]));
+    previous_values_[field] = values[field];
+  }
+  binary::endFrame(buffer_);
+  previous_time_ = time;
+}
+
+uint64_t BinaryWriter::getTime() const
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+           std::chrono::system_clock::now().time_since_epoch())
+    .count();
+}
+
+}  // namespace hyped::telemetry
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "binary_schema.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <data/data.hpp>
+
+namespace hyped::telemetry {
+
+/*
+  Counterpart of Writer that packs the central data structure into binary frames as described in
+  binary_schema.hpp. A receiver needs a schema frame before it can name the fields of full frames,
+  so packSchema() should be sent once after connecting.
+
+  The frame buffer is kept between packs, so a writer that is reused for every packet does not
+  allocate once the first frame has been built. The writer also remembers the values of the last
+  full or delta frame, which are what the next delta frame is relative to.
+*/
+class BinaryWriter {
+ public:
+  explicit BinaryWriter();
+
+  // packs the id, type and name of every field
+  void packSchema();
+
+  // packs the packet id, the current time and every field as currently stored in data
+  void packFull(const uint32_t id);
+  void packFull(const uint32_t id, const uint64_t time, const binary::Values &values);
+
+  // packs only the fields that changed since the previous frame; packs a full frame instead if
+  // there is no previous frame to refer to
+  void packDelta(const uint32_t id);
+  void packDelta(const uint32_t id, const uint64_t time, const binary::Values &values);
+
+  // the last packed frame, header included
+  const uint8_t *getData() const { return buffer_.data(); }
+  std::size_t getSize() const { return buffer_.size(); }
+
+ private:
+  uint64_t getTime() const;
+
+  std::vector<uint8_t> buffer_;
+  binary::Values values_;
+  binary::Values previous_values_;
+  uint64_t previous_time_;
+  bool has_previous_;
+  data::Data &data_;
+};
+
+}  // namespace hyped::telemetry
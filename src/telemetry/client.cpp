@@ -1,15 +1,21 @@
+#include "binary_schema.hpp"
 #include "client.hpp"
 
+#include <fcntl.h>
 #include <netdb.h>
 #include <unistd.h>
 
+#include <array>
+#include <cerrno>
 #include <cstring>
 #include <fstream>
 #include <string>
+#include <utility>
 
 #include <rapidjson/document.h>
 #include <rapidjson/istreamwrapper.h>
 #include <rapidjson/stringbuffer.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 
@@ -17,7 +23,25 @@
 
 namespace hyped::telemetry {
 
-Client::Client(utils::Logger log, const Config &config) : log_(log), config_(config)
+namespace {
+
+// room for every packet the sender builds without growing the queued buffers
+constexpr std::size_t kReservedMessageSize = 4096;
+
+}  // namespace
+
+Client::Client(utils::Logger log, const Config &config)
+    : log_(log),
+      config_(config),
+      socket_(-1),
+      wakeup_fd_(-1),
+      is_connected_(false),
+      outgoing_(config.queue_capacity, kReservedMessageSize),
+      read_size_(0),
+      received_front_(0),
+      received_size_(0),
+      num_received_(0),
+      num_dropped_received_(0)
 {
 }
 
@@ -45,15 +69,27 @@ bool Client::connect()
   socket_ = socket(server_info->ai_family, server_info->ai_socktype, server_info->ai_protocol);
   if (socket_ == -1) {
     log_.error("%s", strerror(errno));
+    freeaddrinfo(server_info);
     throw std::runtime_error{"Failed getting socket file descriptor"};
   }
 
   // connect socket to server
   if (::connect(socket_, server_info->ai_addr, server_info->ai_addrlen) == -1) {
-    close(socket_);
     log_.error("%s", strerror(errno));
+    freeaddrinfo(server_info);
+    closeSockets();
     throw std::runtime_error{"Failed connecting to socket (couldn't connect to server)"};
   }
+  freeaddrinfo(server_info);
+
+  // from here on the IoThread does all reading and writing and must never block
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wakeup_fd_ == -1 || fcntl(socket_, F_SETFL, fcntl(socket_, F_GETFL) | O_NONBLOCK) == -1) {
+    log_.error("%s", strerror(errno));
+    closeSockets();
+    throw std::runtime_error{"Failed making socket non-blocking"};
+  }
+  is_connected_ = true;
 
   log_.info("Connected to server");
 
@@ -62,46 +98,145 @@ bool Client::connect()
 
 Client::~Client()
 {
-  close(socket_);
+  closeSockets();
 }
 
-bool Client::sendData(std::string message)
+void Client::closeSockets()
 {
-  log_.debug("Starting to send message to server");
-
-  message.append("\n");
+  if (socket_ != -1) { close(socket_); }
+  if (wakeup_fd_ != -1) { close(wakeup_fd_); }
+  socket_    = -1;
+  wakeup_fd_ = -1;
+}
 
-  int payload_length = message.length();
+void Client::onConnectionLost()
+{
+  // the sockets stay open until destruction, as other threads may still be queueing messages
+  is_connected_ = false;
+  // wake up anybody waiting for a message that will not arrive
+  utils::concurrent::ScopedLock L(&received_lock_);
+  received_cv_.notifyAll();
+}
 
-  // send payload
-  if (send(socket_, message.c_str(), payload_length, 0) == -1) { return false; }
+bool Client::sendData(std::string_view message)
+{
+  static const char kDelimiter = '\n';
+  std::array<iovec, 2> parts;
+  parts[0].iov_base = const_cast<char *>(message.data());
+  parts[0].iov_len  = message.size();
+  parts[1].iov_base = const_cast<char *>(&kDelimiter);
+  parts[1].iov_len  = 1;
+  return queue(parts.data(), parts.size(), true);
+}
 
-  log_.debug("Finished sending message to server");
+bool Client::sendFrame(const uint8_t *data, const std::size_t len, const bool is_droppable)
+{
+  iovec part;
+  part.iov_base = const_cast<uint8_t *>(data);
+  part.iov_len  = len;
+  return queue(&part, 1, is_droppable);
+}
 
+bool Client::queue(const iovec *parts, const std::size_t num_parts, const bool is_droppable)
+{
+  if (!is_connected_) { return false; }
+  if (outgoing_.push(parts, num_parts, is_droppable)) {
+    // the I/O thread only watches for the socket to become writable while it has data to write
+    eventfd_write(wakeup_fd_, 1);
+  }
   return true;
 }
 
-std::string Client::receiveData()
+void Client::clearWakeup()
+{
+  eventfd_t value;
+  eventfd_read(wakeup_fd_, &value);
+}
+
+std::optional<std::string> Client::receiveData(const uint32_t timeout_millis)
 {
-  log_.debug("Waiting to receive from server");
+  utils::concurrent::ScopedLock L(&received_lock_);
+  if (received_size_ == 0 && is_connected_) {
+    received_cv_.waitFor(&received_lock_, static_cast<uint64_t>(timeout_millis) * 1000);
+  }
+  if (received_size_ == 0) { return std::nullopt; }
+  std::string message = std::move(received_[received_front_]);
+  received_front_     = (received_front_ + 1) % received_.size();
+  --received_size_;
+  return message;
+}
 
-  char header[8];
+Client::Stats Client::getStats() const
+{
+  Stats stats;
+  stats.outgoing = outgoing_.getStats();
+  utils::concurrent::ScopedLock L(&received_lock_);
+  stats.num_received         = num_received_;
+  stats.num_dropped_received = num_dropped_received_;
+  return stats;
+}
 
-  // receive header
-  if (recv(socket_, header, 8, 0) == -1) { throw std::runtime_error{"Error receiving header"}; }
+bool Client::readAvailable()
+{
+  while (true) {
+    const ssize_t received = recv(socket_, read_buffer_.data() + read_size_,
+                                  read_buffer_.size() - read_size_, MSG_DONTWAIT);
+    if (received == 0) {
+      log_.error("Connection closed by server");
+      return false;
+    }
+    if (received == -1) {
+      if (errno == EINTR) { continue; }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) { return true; }
+      log_.error("%s", strerror(errno));
+      return false;
+    }
+    read_size_ += received;
 
-  int payload_length = strtol(header, NULL, 0);
-  char buffer[1024];                  // power of 2 because apparently it's better for networking
-  memset(buffer, 0, sizeof(buffer));  // fill with 0's so null terminated by default
+    // a read may end anywhere in a message, so only complete ones are taken
+    std::size_t position = 0;
+    while (read_size_ - position >= kMessageHeaderSize) {
+      const auto payload_size = parseHeader(&read_buffer_[position]);
+      if (!payload_size) {
+        log_.error("Received malformed message header from server");
+        return false;
+      }
+      const std::size_t message_size = kMessageHeaderSize + *payload_size;
+      if (read_size_ - position < message_size) { break; }
+      const char *payload = reinterpret_cast<const char *>(&read_buffer_[position])
+                            + kMessageHeaderSize;
 
-  // receive payload
-  if (recv(socket_, buffer, payload_length, 0) == -1) {
-    throw std::runtime_error{"Error receiving payload"};
+      utils::concurrent::ScopedLock L(&received_lock_);
+      if (received_size_ == received_.size()) {
+        received_front_ = (received_front_ + 1) % received_.size();
+        --received_size_;
+        ++num_dropped_received_;
+      }
+      received_[(received_front_ + received_size_) % received_.size()].assign(payload,
+                                                                               *payload_size);
+      ++received_size_;
+      ++num_received_;
+      received_cv_.notify();
+      position += message_size;
+    }
+    std::memmove(read_buffer_.data(), read_buffer_.data() + position, read_size_ - position);
+    read_size_ -= position;
   }
+}
 
-  log_.debug("Finished receiving from server");
-
-  return std::string(buffer);
+std::optional<std::size_t> Client::parseHeader(const uint8_t *header)
+{
+  std::size_t size = 0;
+  std::size_t i    = 0;
+  while (i < kMessageHeaderSize && (header[i] == ' ' || header[i] == '0')) {
+    ++i;
+  }
+  for (; i < kMessageHeaderSize; ++i) {
+    if (header[i] < '0' || header[i] > '9') { return std::nullopt; }
+    size = size * 10 + (header[i] - '0');
+  }
+  if (size > kMaxMessageSize) { return std::nullopt; }
+  return size;
 }
 
 std::unique_ptr<Client> Client::fromFile(const std::string &path)
@@ -149,6 +284,72 @@ std::optional<Client::Config> Client::readConfig(utils::Logger &log, const std::
     return std::nullopt;
   }
   config.server_port = config_object["server_port"].GetString();
+  if (config_object.HasMember("format")) {
+    const std::string format = config_object["format"].GetString();
+    if (format == "json") {
+      config.format = Format::kJson;
+    } else if (format == "binary") {
+      config.format = Format::kBinary;
+    } else if (format == "delta") {
+      config.format = Format::kDelta;
+    } else {
+      log.error("Unknown 'telemetry.format' %s in configuration file at %s", format.c_str(),
+                path.c_str());
+      return std::nullopt;
+    }
+  }
+  if (config_object.HasMember("keyframe_interval")) {
+    config.keyframe_interval = config_object["keyframe_interval"].GetUint();
+    if (config.keyframe_interval == 0) {
+      log.error("Field 'telemetry.keyframe_interval' in configuration file at %s must be positive",
+                path.c_str());
+      return std::nullopt;
+    }
+  }
+  if (config_object.HasMember("period_millis")) {
+    config.period_millis = config_object["period_millis"].GetUint();
+  }
+  if (config_object.HasMember("queue_capacity")) {
+    config.queue_capacity = config_object["queue_capacity"].GetUint();
+    if (config.queue_capacity < OutgoingQueue::kMinCapacity) {
+      log.error("Field 'telemetry.queue_capacity' in configuration file at %s must be at least %zu",
+                path.c_str(), OutgoingQueue::kMinCapacity);
+      return std::nullopt;
+    }
+  }
+  if (config_object.HasMember("high_rate")) {
+    auto high_rate_object = config_object["high_rate"].GetObject();
+    auto &high_rate       = config.high_rate;
+    if (high_rate_object.HasMember("enabled")) {
+      high_rate.enabled = high_rate_object["enabled"].GetBool();
+    }
+    if (high_rate_object.HasMember("server_port")) {
+      high_rate.server_port = high_rate_object["server_port"].GetString();
+    } else if (high_rate.enabled) {
+      log.error("Missing required field 'telemetry.high_rate.server_port' in configuration file "
+                "at %s",
+                path.c_str());
+      return std::nullopt;
+    }
+    if (high_rate_object.HasMember("batch_size")) {
+      high_rate.batch_size = high_rate_object["batch_size"].GetUint();
+      if (high_rate.batch_size == 0 || high_rate.batch_size > binary::kMaxBatchSize) {
+        log.error("Field 'telemetry.high_rate.batch_size' in configuration file at %s must be "
+                  "between 1 and %zu",
+                  path.c_str(), binary::kMaxBatchSize);
+        return std::nullopt;
+      }
+    }
+    if (high_rate_object.HasMember("decimation")) {
+      high_rate.decimation = high_rate_object["decimation"].GetUint();
+      if (high_rate.decimation == 0) {
+        log.error("Field 'telemetry.high_rate.decimation' in configuration file at %s must be "
+                  "positive",
+                  path.c_str());
+        return std::nullopt;
+      }
+    }
+  }
   return config;
 }
 
@@ -1,33 +1,146 @@
 #pragma once
 
+#include "outgoing_queue.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 
+#include <utils/concurrent/condition_variable.hpp>
+#include <utils/concurrent/lock.hpp>
 #include <utils/logger.hpp>
+#include <utils/utils.hpp>
 
 namespace hyped::telemetry {
 
+// Forward declaration
+class IoThread;
+
+/**
+ * @brief Connection to the ground station. Once connected, the socket is non-blocking and all
+ *        reading and writing is done by the IoThread the client is added to: sending only queues
+ *        a message and receiving takes the next message the I/O thread has read, so neither ever
+ *        waits for the network.
+ *
+ *        Messages from the server are framed by a header of kMessageHeaderSize bytes holding the
+ *        length of the payload that follows in decimal ASCII, padded with leading zeros or spaces.
+ */
 class Client {
+  friend IoThread;
+
  public:
+  // how packets are encoded, see Writer and BinaryWriter
+  enum class Format { kJson, kBinary, kDelta };
+
+  // opt-in channel streaming raw sensor samples on its own connection, see HighRateSender
+  struct HighRateConfig {
+    bool enabled = false;
+    std::string server_port;
+    uint32_t batch_size = 10;
+    // only every this many IMU samples is sent
+    uint32_t decimation = 1;
+  };
+
   struct Config {
     std::string server_port;
     std::string server_ip;
+    Format format = Format::kJson;
+    // with Format::kDelta, every this many packets is a full frame
+    uint32_t keyframe_interval = 10;
+    uint32_t period_millis     = 100;
+    // packets waiting to be sent before the oldest is dropped
+    uint32_t queue_capacity = 32;
+    HighRateConfig high_rate;
   };
 
+  struct Stats {
+    OutgoingQueue::Stats outgoing;
+    uint64_t num_received;          // messages received from the server
+    uint64_t num_dropped_received;  // messages dropped because nobody took them in time
+  };
+
+  static constexpr std::size_t kMessageHeaderSize = 8;
+  static constexpr std::size_t kMaxMessageSize    = 1024;
+  // messages received but not yet taken before the oldest is dropped
+  static constexpr std::size_t kReceivedCapacity = 16;
+
   Client(utils::Logger log, const Config &config);
   ~Client();
   static std::unique_ptr<Client> fromFile(const std::string &path);
   static std::optional<Config> readConfig(utils::Logger &log, const std::string &path);
 
+  /**
+   * @brief Connects to the server, blocking until connected, and makes the socket non-blocking.
+   */
   bool connect();
-  bool sendData(std::string message);
-  std::string receiveData();
+
+  // queues a JSON packet followed by the newline that delimits packets
+  bool sendData(std::string_view message);
+  // queues a binary frame as is, as frames carry their own length; frames that are sent once
+  // rather than superseded by the next one must not be droppable, see OutgoingQueue
+  bool sendFrame(const uint8_t *data, const std::size_t len, const bool is_droppable = true);
+
+  /**
+   * @brief Takes the oldest message received from the server, waiting up to `timeout_millis` for
+   *        one to arrive.
+   *
+   * @return std::nullopt if no message arrived in time or the connection is lost
+   */
+  std::optional<std::string> receiveData(const uint32_t timeout_millis);
+
+  // false once the connection failed or was closed by the server
+  bool isConnected() const { return is_connected_; }
+  const Config &getConfig() const { return config_; }
+  Stats getStats() const;
 
  private:
+  /**
+   * @brief Queues the buffers as one message and wakes up the I/O thread if it was idle.
+   */
+  bool queue(const iovec *parts, const std::size_t num_parts, const bool is_droppable);
+
+  /**
+   * @brief Called by the IoThread when the socket is readable. Reads everything available and
+   *        queues every complete message.
+   *
+   * @return false if the connection failed, was closed or sent a malformed header
+   */
+  bool readAvailable();
+  void clearWakeup();
+  // called by the IoThread when reading or writing failed
+  void onConnectionLost();
+  void closeSockets();
+
+  /**
+   * @return the length of the payload announced by a header, std::nullopt if it is malformed
+   */
+  static std::optional<std::size_t> parseHeader(const uint8_t *header);
+
   utils::Logger log_;
   const Config config_;
   int socket_;
+  // signalled when messages are queued while the queue was empty
+  int wakeup_fd_;
+  std::atomic<bool> is_connected_;
+  OutgoingQueue outgoing_;
+
+  std::array<uint8_t, kMessageHeaderSize + kMaxMessageSize> read_buffer_;
+  std::size_t read_size_;
+
+  mutable utils::concurrent::Lock received_lock_;
+  utils::concurrent::ConditionVariable received_cv_;
+  std::array<std::string, kReceivedCapacity> received_;
+  std::size_t received_front_;
+  std::size_t received_size_;
+  uint64_t num_received_;
+  uint64_t num_dropped_received_;
+
+  NO_COPY_ASSIGN(Client)
 };
 
 }  // namespace hyped::telemetry
@@ -0,0 +1,57 @@
+#include "high_rate_sender.hpp"
+
+namespace hyped::telemetry {
+
+HighRateSender::HighRateSender(data::Data &data, Client &client)
+    : utils::concurrent::Thread(
+      utils::Logger("HIGH_RATE", utils::System::getSystem().config_.log_level_telemetry)),
+      sys_(utils::System::getSystem()),
+      data_(data),
+      client_(client),
+      batch_writer_(client.getConfig().high_rate.batch_size),
+      last_imu_timestamp_(data.getSensorsImuData().timestamp),
+      num_samples_(0),
+      num_batches_sent_(0)
+{
+  LOG_DEBUG(log_, "Telemetry HighRateSender thread object created");
+}
+
+void HighRateSender::run()
+{
+  LOG_DEBUG(log_, "Telemetry HighRateSender thread started");
+
+  bool sent        = sendColumns();
+  uint64_t version = data_.getVersion(data::Substructure::kSensors);
+  while (sent && sys_.isRunning()) {
+    version = data_.waitForUpdate(data::Substructure::kSensors, version, kUpdateTimeoutMillis);
+    sent    = sample();
+  }
+
+  // the regular packets do not depend on this channel, so losing it is not a failure of the pod
+  if (!sent) { log_.error("Lost connection, no longer sending high rate telemetry"); }
+
+  LOG_DEBUG(log_, "Exiting Telemetry HighRateSender thread");
+}
+
+bool HighRateSender::sendColumns()
+{
+  batch_writer_.packColumns();
+  // batches cannot be decoded without the columns, which are only sent once
+  return client_.sendFrame(batch_writer_.getData(), batch_writer_.getSize(), false);
+}
+
+bool HighRateSender::sample()
+{
+  // the sensors are also updated by the encoders, which do not make a new sample
+  const auto sensors_data = data_.getSensorsData();
+  if (sensors_data.imu.timestamp == last_imu_timestamp_) { return true; }
+  last_imu_timestamp_ = sensors_data.imu.timestamp;
+  if (num_samples_++ % client_.getConfig().high_rate.decimation != 0) { return true; }
+
+  binary::captureRow(sensors_data, data_.getBatteriesData(), row_);
+  if (!batch_writer_.addRow(sensors_data.imu.timestamp, row_)) { return true; }
+  batch_writer_.packBatch(num_batches_sent_++);
+  return client_.sendFrame(batch_writer_.getData(), batch_writer_.getSize());
+}
+
+}  // namespace hyped::telemetry
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "batch_writer.hpp"
+#include "client.hpp"
+
+#include <cstdint>
+
+#include <data/data.hpp>
+#include <utils/concurrent/thread.hpp>
+#include <utils/system.hpp>
+
+namespace hyped::telemetry {
+
+/**
+ * @brief Streams the raw IMU accelerations, encoder counts and cell voltages at the rate of the
+ *        IMUs, so the ground station sees the samples navigation works with. Every new IMU sample,
+ *        or every `decimation`th one, is added to a batch that is sent once it is full. Runs on
+ *        its own connection so that batches do not delay the regular packets.
+ */
+class HighRateSender : public utils::concurrent::Thread {
+ public:
+  explicit HighRateSender(data::Data &data, Client &client);
+  void run() override;
+
+  /**
+   * @brief Sends the names and units of the columns that batches need to be decoded.
+   */
+  bool sendColumns();
+
+  /**
+   * @brief Adds the current sample to the batch if the IMUs produced a new one and it is not
+   *        dropped by decimation, and sends the batch once it is full.
+   *
+   * @return false if sending failed
+   */
+  bool sample();
+
+ private:
+  static constexpr uint32_t kUpdateTimeoutMillis = 100;
+
+  utils::System &sys_;
+  data::Data &data_;
+  Client &client_;
+  BatchWriter batch_writer_;
+  binary::Row row_;
+  uint64_t last_imu_timestamp_;
+  uint32_t num_samples_;
+  uint32_t num_batches_sent_;
+};
+
+}  // namespace hyped::telemetry
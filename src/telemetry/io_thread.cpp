@@ -0,0 +1,144 @@
+#include "io_thread.hpp"
+
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+
+#include <sys/epoll.h>
+
+namespace hyped::telemetry {
+
+namespace {
+
+// epoll events carry the index of the registration and whether the event is for the wakeup
+uint64_t makeEventData(const std::size_t index, const bool is_wakeup)
+{
+  return index * 2 + (is_wakeup ? 1 : 0);
+}
+
+}  // namespace
+
+IoThread::IoThread()
+    : utils::concurrent::Thread(
+      utils::Logger("IO", utils::System::getSystem().config_.log_level_telemetry)),
+      sys_(utils::System::getSystem()),
+      epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      num_connected_(0)
+{
+  registrations_.reserve(kMaxClients);
+  if (epoll_fd_ == -1) { log_.error("Failed creating epoll instance: %s", strerror(errno)); }
+}
+
+IoThread::~IoThread()
+{
+  if (epoll_fd_ != -1) { close(epoll_fd_); }
+}
+
+bool IoThread::add(Client &client)
+{
+  if (epoll_fd_ == -1 || !client.isConnected() || registrations_.size() == kMaxClients) {
+    return false;
+  }
+  const std::size_t index = registrations_.size();
+  epoll_event event       = {};
+  event.events            = EPOLLIN;
+  event.data.u64          = makeEventData(index, true);
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, client.wakeup_fd_, &event) == -1) {
+    log_.error("Failed watching client: %s", strerror(errno));
+    return false;
+  }
+  event.events   = EPOLLIN | EPOLLRDHUP;
+  event.data.u64 = makeEventData(index, false);
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, client.socket_, &event) == -1) {
+    log_.error("Failed watching client: %s", strerror(errno));
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, client.wakeup_fd_, nullptr);
+    return false;
+  }
+  registrations_.push_back({&client, false});
+  ++num_connected_;
+  return true;
+}
+
+void IoThread::run()
+{
+  LOG_DEBUG(log_, "Telemetry IoThread started");
+
+  // anything queued before the thread started has not woken it up
+  for (auto &registration : registrations_) {
+    if (!flush(registration)) { remove(registration); }
+  }
+
+  std::array<epoll_event, 2 * kMaxClients> events;
+  while (is_running_ && sys_.isRunning() && num_connected_ > 0) {
+    const int num_events = epoll_wait(epoll_fd_, events.data(), events.size(), kTimeoutMillis);
+    if (num_events == -1) {
+      if (errno == EINTR) { continue; }
+      log_.error("Failed waiting for events: %s", strerror(errno));
+      break;
+    }
+    for (int i = 0; i < num_events; ++i) {
+      auto &registration = registrations_[events[i].data.u64 / 2];
+      if (registration.client == nullptr) { continue; }
+      const bool is_wakeup = events[i].data.u64 % 2 == 1;
+      if (is_wakeup) { registration.client->clearWakeup(); }
+      // errors and hang ups are reported by the read itself
+      const bool is_readable = !is_wakeup && (events[i].events & ~EPOLLOUT) != 0;
+      if ((is_readable && !registration.client->readAvailable()) || !flush(registration)) {
+        remove(registration);
+      }
+    }
+  }
+
+  for (auto &registration : registrations_) {
+    if (registration.client == nullptr) { continue; }
+    const auto stats = registration.client->getStats().outgoing;
+    log_.info("Sent %" PRIu64 " messages, dropped %" PRIu64 ", average latency %" PRIu64
+              " us, maximum %" PRIu64 " us",
+              stats.num_sent, stats.num_dropped,
+              stats.num_sent > 0 ? stats.total_latency_micros / stats.num_sent : 0,
+              stats.max_latency_micros);
+  }
+
+  LOG_DEBUG(log_, "Exiting Telemetry IoThread");
+}
+
+bool IoThread::flush(Registration &registration)
+{
+  switch (registration.client->outgoing_.writeTo(registration.client->socket_)) {
+    case OutgoingQueue::WriteResult::kDone:
+      return !registration.is_writing || watch(registration, false);
+    case OutgoingQueue::WriteResult::kWouldBlock:
+      return registration.is_writing || watch(registration, true);
+    case OutgoingQueue::WriteResult::kError:
+      log_.error("Failed sending to server: %s", strerror(errno));
+      return false;
+  }
+  return false;
+}
+
+bool IoThread::watch(Registration &registration, const bool is_writing)
+{
+  epoll_event event = {};
+  event.events      = is_writing ? EPOLLIN | EPOLLRDHUP | EPOLLOUT : EPOLLIN | EPOLLRDHUP;
+  event.data.u64    = makeEventData(&registration - registrations_.data(), false);
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, registration.client->socket_, &event) == -1) {
+    log_.error("Failed watching client: %s", strerror(errno));
+    return false;
+  }
+  registration.is_writing = is_writing;
+  return true;
+}
+
+void IoThread::remove(Registration &registration)
+{
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, registration.client->socket_, nullptr);
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, registration.client->wakeup_fd_, nullptr);
+  registration.client->onConnectionLost();
+  registration.client = nullptr;
+  --num_connected_;
+}
+
+}  // namespace hyped::telemetry
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "client.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <utils/concurrent/thread.hpp>
+#include <utils/system.hpp>
+#include <utils/utils.hpp>
+
+namespace hyped::telemetry {
+
+/**
+ * @brief Single thread doing all network I/O of the telemetry clients added to it. Waits on epoll
+ *        for any socket to become readable, for a client to queue messages, or for a socket that
+ *        was full to become writable again, and then reads or writes as much as it can without
+ *        blocking. A slow or stalled ground station therefore only fills the bounded queue of its
+ *        client, where the oldest packets are dropped, instead of stalling the threads sending.
+ *
+ *        A client whose connection fails is removed and marked as disconnected. The thread exits
+ *        once it is stopped, the system stops or no connected client is left.
+ */
+class IoThread : public utils::concurrent::Thread {
+ public:
+  static constexpr std::size_t kMaxClients = 4;
+
+  IoThread();
+  ~IoThread();
+
+  /**
+   * @brief Adds a connected client. Must be called before the thread is started.
+   */
+  bool add(Client &client);
+
+  void run() override;
+
+ private:
+  // wake up regularly to notice being stopped
+  static constexpr int kTimeoutMillis = 100;
+
+  struct Registration {
+    Client *client;
+    // whether epoll also reports the socket becoming writable
+    bool is_writing;
+  };
+
+  /**
+   * @brief Writes what the client has queued and watches for the socket to become writable if
+   *        the socket is full.
+   *
+   * @return false if the connection failed
+   */
+  bool flush(Registration &registration);
+  bool watch(Registration &registration, const bool is_writing);
+  void remove(Registration &registration);
+
+  utils::System &sys_;
+  int epoll_fd_;
+  std::vector<Registration> registrations_;
+  std::size_t num_connected_;
+
+  NO_COPY_ASSIGN(IoThread)
+};
+
+}  // namespace hyped::telemetry
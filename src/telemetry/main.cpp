@@ -2,6 +2,8 @@
 #include "receiver.hpp"
 #include "sender.hpp"
 
+#include <utility>
+
 #include <utils/system.hpp>
 
 namespace hyped::telemetry {
@@ -18,13 +20,13 @@ Main::Main()
                system_config.client_config_path.c_str());
     utils::System::getSystem().stop();
   }
-  client_ = std::make_unique<Client>(*client_optional);
+  client_ = std::move(client_optional);
 }
 
 void Main::run()
 {
   auto telemetry_data = data_.getTelemetryData();
-  log_.debug("Telemetry Main thread started");
+  LOG_DEBUG(log_, "Telemetry Main thread started");
   try {
     client_->connect();
   } catch (std::exception &e) {
@@ -39,14 +41,42 @@ void Main::run()
   telemetry_data.module_status = data::ModuleStatus::kReady;
   data_.setTelemetryData(telemetry_data);
 
+  IoThread io_thread;
+  io_thread.add(*client_);
   Sender sender(data_, *client_);
   Receiver receiver(data_, *client_);
+  auto high_rate_sender = startHighRateSender(io_thread);
+  io_thread.start();
   sender.start();
   receiver.start();
   sender.join();
   receiver.join();
+  if (high_rate_sender) { high_rate_sender->join(); }
+  io_thread.join();
+
+  LOG_DEBUG(log_, "Exiting Telemetry Main thread");
+}
 
-  log_.debug("Exiting Telemetry Main thread");
+std::unique_ptr<HighRateSender> Main::startHighRateSender(IoThread &io_thread)
+{
+  const auto &high_rate = client_->getConfig().high_rate;
+  if (!high_rate.enabled) { return nullptr; }
+  Client::Config config = client_->getConfig();
+  config.server_port    = high_rate.server_port;
+  high_rate_client_     = std::make_unique<Client>(
+    utils::Logger("CLIENT", utils::System::getSystem().config_.log_level_telemetry), config);
+  try {
+    high_rate_client_->connect();
+  } catch (std::exception &e) {
+    // optional channel, the pod can run without it
+    log_.error(e.what());
+    log_.error("Not sending high rate telemetry (due to error connecting)");
+    return nullptr;
+  }
+  io_thread.add(*high_rate_client_);
+  auto high_rate_sender = std::make_unique<HighRateSender>(data_, *high_rate_client_);
+  high_rate_sender->start();
+  return high_rate_sender;
 }
 
 }  // namespace hyped::telemetry
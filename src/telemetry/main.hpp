@@ -1,6 +1,10 @@
 #pragma once
 
 #include "client.hpp"
+#include "high_rate_sender.hpp"
+#include "io_thread.hpp"
+
+#include <memory>
 
 #include <data/data.hpp>
 #include <utils/concurrent/thread.hpp>
@@ -13,8 +17,17 @@ class Main : public utils::concurrent::Thread {
   void run() override;
 
  private:
+  /**
+   * @brief Connects and starts the high rate channel if it is enabled in the config. Its client
+   *        is added to `io_thread`, which must not have been started yet.
+   *
+   * @return the started thread, nullptr if the channel is disabled or could not connect
+   */
+  std::unique_ptr<HighRateSender> startHighRateSender(IoThread &io_thread);
+
   data::Data &data_;
   std::unique_ptr<Client> client_;
+  std::unique_ptr<Client> high_rate_client_;
 };
 
 }  // namespace hyped::telemetry
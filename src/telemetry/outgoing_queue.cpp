@@ -0,0 +1,127 @@
+#include "outgoing_queue.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <sys/socket.h>
+
+#include <utils/timer.hpp>
+
+namespace hyped::telemetry {
+
+OutgoingQueue::OutgoingQueue(const std::size_t capacity, const std::size_t reserved_size)
+    : messages_(std::max(capacity, kMinCapacity)),
+      front_(0),
+      size_(0),
+      front_offset_(0),
+      stats_{}
+{
+  for (auto &message : messages_) {
+    message.data.reserve(reserved_size);
+  }
+}
+
+bool OutgoingQueue::push(const iovec *parts, const std::size_t num_parts, const bool is_droppable)
+{
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < num_parts; ++i) {
+    size += parts[i].iov_len;
+  }
+  const uint64_t now = utils::Timer::getTimeMicros();
+
+  utils::concurrent::ScopedLock L(&lock_);
+  const bool was_empty = size_ == 0;
+  if (size_ == messages_.size()) {
+    ++stats_.num_dropped;
+    // a partly written front message has to be finished, so the search starts behind it
+    std::size_t dropped = front_offset_ > 0 ? 1 : 0;
+    while (dropped < size_ && !at(dropped).is_droppable) {
+      ++dropped;
+    }
+    if (dropped == size_) { return was_empty; }
+    if (dropped == 0) {
+      popFront();
+    } else {
+      // keep the order of the remaining messages, moving the dropped buffer to the back for reuse
+      for (std::size_t i = dropped; i + 1 < size_; ++i) {
+        std::swap(at(i), at(i + 1));
+      }
+      --size_;
+    }
+  }
+  Message &message = at(size_);
+  message.data.resize(size);
+  uint8_t *position = message.data.data();
+  for (std::size_t i = 0; i < num_parts; ++i) {
+    std::memcpy(position, parts[i].iov_base, parts[i].iov_len);
+    position += parts[i].iov_len;
+  }
+  message.queued_micros = now;
+  message.is_droppable  = is_droppable;
+  ++size_;
+  return was_empty;
+}
+
+OutgoingQueue::WriteResult OutgoingQueue::writeTo(const int socket)
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  std::array<iovec, kMaxWriteMessages> buffers;
+  while (size_ > 0) {
+    const std::size_t num_buffers = std::min(size_, buffers.size());
+    for (std::size_t i = 0; i < num_buffers; ++i) {
+      auto &data               = at(i).data;
+      const std::size_t offset = i == 0 ? front_offset_ : 0;
+      buffers[i].iov_base      = data.data() + offset;
+      buffers[i].iov_len       = data.size() - offset;
+    }
+    msghdr header     = {};
+    header.msg_iov    = buffers.data();
+    header.msg_iovlen = num_buffers;
+    // a closed connection must fail the write rather than raise SIGPIPE
+    ssize_t sent = sendmsg(socket, &header, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (sent == -1) {
+      if (errno == EINTR) { continue; }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) { return WriteResult::kWouldBlock; }
+      return WriteResult::kError;
+    }
+    stats_.num_bytes_sent += sent;
+    const uint64_t now = utils::Timer::getTimeMicros();
+    for (std::size_t i = 0; i < num_buffers && sent > 0; ++i) {
+      if (static_cast<std::size_t>(sent) < buffers[i].iov_len) {
+        front_offset_ += sent;
+        break;
+      }
+      sent -= buffers[i].iov_len;
+      const uint64_t latency = now - messages_[front_].queued_micros;
+      stats_.total_latency_micros += latency;
+      stats_.max_latency_micros = std::max(stats_.max_latency_micros, latency);
+      ++stats_.num_sent;
+      popFront();
+    }
+  }
+  return WriteResult::kDone;
+}
+
+bool OutgoingQueue::isEmpty() const
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  return size_ == 0;
+}
+
+OutgoingQueue::Stats OutgoingQueue::getStats() const
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  return stats_;
+}
+
+void OutgoingQueue::popFront()
+{
+  front_        = (front_ + 1) % messages_.size();
+  front_offset_ = 0;
+  --size_;
+}
+
+}  // namespace hyped::telemetry
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include <utils/concurrent/lock.hpp>
+
+namespace hyped::telemetry {
+
+/**
+ * @brief Bounded queue of messages waiting to be written to a non-blocking socket. Producers copy
+ *        messages in from any thread, the I/O thread writes them out in order with as few system
+ *        calls as the socket allows and resumes partial writes where they stopped.
+ *
+ *        When the queue is full the oldest message is dropped to make room, as a newer packet
+ *        supersedes an older one. The message at the front is kept if part of it has already been
+ *        written, so that the receiver never sees a truncated message, and so are messages queued
+ *        as not droppable, such as a schema the receiver needs to decode everything after it. If
+ *        nothing queued may be dropped, the new message is dropped instead.
+ *
+ *        Messages are copied into buffers that are allocated up front and reused, so queueing does
+ *        not allocate unless a message is larger than any before it.
+ */
+class OutgoingQueue {
+ public:
+  enum class WriteResult {
+    kDone,        // every queued message has been written
+    kWouldBlock,  // the socket is full, write again once it is writable
+    kError,       // the connection failed, see errno
+  };
+
+  struct Stats {
+    uint64_t num_sent;     // messages written completely
+    uint64_t num_dropped;  // messages dropped because the queue was full
+    uint64_t num_bytes_sent;
+    // time from queueing a message to writing its last byte
+    uint64_t total_latency_micros;
+    uint64_t max_latency_micros;
+  };
+
+  static constexpr std::size_t kMinCapacity = 2;
+
+  /**
+   * @param capacity number of messages, at least kMinCapacity
+   * @param reserved_size bytes allocated up front for each message
+   */
+  OutgoingQueue(const std::size_t capacity, const std::size_t reserved_size);
+
+  /**
+   * @brief Copies the parts into the queue as one message, dropping the oldest droppable message
+   *        if full.
+   *
+   * @param is_droppable false for messages that are sent only once and must not be superseded
+   * @return true if the queue was empty, i.e. the I/O thread may need waking up
+   */
+  bool push(const iovec *parts, const std::size_t num_parts, const bool is_droppable = true);
+
+  /**
+   * @brief Writes queued messages to `socket` until the queue is empty or the socket is full.
+   *        Holds the lock of the queue while writing, which never blocks on a non-blocking socket.
+   */
+  WriteResult writeTo(const int socket);
+
+  bool isEmpty() const;
+  std::size_t getCapacity() const { return messages_.size(); }
+  Stats getStats() const;
+
+ private:
+  // messages written with a single system call at most
+  static constexpr std::size_t kMaxWriteMessages = 16;
+
+  struct Message {
+    std::vector<uint8_t> data;
+    uint64_t queued_micros;
+    bool is_droppable;
+  };
+
+  // the message `index` places behind the front
+  Message &at(const std::size_t index) { return messages_[(front_ + index) % messages_.size()]; }
+  void popFront();
+
+  mutable utils::concurrent::Lock lock_;
+  std::vector<Message> messages_;
+  std::size_t front_;
+  std::size_t size_;
+  // bytes of the front message that have already been written
+  std::size_t front_offset_;
+  Stats stats_;
+};
+
+}  // namespace hyped::telemetry
@@ -9,50 +9,50 @@ namespace hyped::telemetry {
 Receiver::Receiver(data::Data &data, Client &client)
     : utils::concurrent::Thread(
       utils::Logger("RECEIVER", utils::System::getSystem().config_.log_level_telemetry)),
+      sys_(utils::System::getSystem()),
       data_(data),
       client_(client)
 {
-  log_.debug("constructed");
+  LOG_DEBUG(log_, "constructed");
 }
 
 void Receiver::run()
 {
-  log_.debug("thread started");
-  while (true) {
+  LOG_DEBUG(log_, "thread started");
+  while (sys_.isRunning()) {
+    const auto message = client_.receiveData(kReceiveTimeoutMillis);
+    if (!message && client_.isConnected()) { continue; }
     auto telemetry_data = data_.getTelemetryData();
-    std::string message;
-    try {
-      message = client_.receiveData();
-    } catch (std::exception &e) {
-      log_.error("%s", e.what());
+    if (!message) {
+      log_.error("Lost connection to server");
       telemetry_data.module_status = data::ModuleStatus::kCriticalFailure;
       data_.setTelemetryData(telemetry_data);
       break;
     }
-    if (message == "ACK") {
+    if (*message == "ACK") {
       log_.info("FROM SERVER: ACK");
-    } else if (message == "STOP") {
+    } else if (*message == "STOP") {
       log_.info("FROM SERVER: STOP");
       telemetry_data.emergency_stop_command = true;
-    } else if (message == "CALIBRATE") {
+    } else if (*message == "CALIBRATE") {
       log_.info("FROM SERVER: CALIBRATE");
       telemetry_data.calibrate_command = true;
-    } else if (message == "LAUNCH") {
+    } else if (*message == "LAUNCH") {
       log_.info("FROM SERVER: LAUNCH");
       telemetry_data.launch_command = true;
-    } else if (message == "SHUTDOWN") {
+    } else if (*message == "SHUTDOWN") {
       log_.info("FROM SERVER: SHUTDOWN");
       telemetry_data.shutdown_command = true;
-    } else if (message == "SERVER_PROPULSION_GO") {
+    } else if (*message == "SERVER_PROPULSION_GO") {
       log_.info("FROM SERVER: SERVICE_PROPULSION_GO");
       telemetry_data.service_propulsion_go = true;
-    } else if (message == "SERVER_PROPULSION_STOP") {
+    } else if (*message == "SERVER_PROPULSION_STOP") {
       log_.info("FROM SERVER: SERVICE_PROPULSION_STOP");
       telemetry_data.service_propulsion_go = false;
-    } else if (message == "NOMINAL_BRAKING") {
+    } else if (*message == "NOMINAL_BRAKING") {
       log_.info("FROM SERVER: NOMINAL_BRAKING");
       telemetry_data.nominal_braking_command = true;
-    } else if (message == "NOMINAL_RETRACT") {
+    } else if (*message == "NOMINAL_RETRACT") {
       log_.info("FROM SERVER: NOMINAL_RETRACT");
       telemetry_data.nominal_braking_command = false;
     } else {
@@ -61,7 +61,7 @@ void Receiver::run()
     }
     data_.setTelemetryData(telemetry_data);
   }
-  log_.debug("Exiting Telemetry RecvLoop thread");
+  LOG_DEBUG(log_, "Exiting Telemetry RecvLoop thread");
 }
 
 }  // namespace hyped::telemetry
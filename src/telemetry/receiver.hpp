@@ -2,8 +2,11 @@
 
 #include "main.hpp"
 
+#include <cstdint>
+
 #include "data/data.hpp"
 #include "utils/concurrent/thread.hpp"
+#include "utils/system.hpp"
 
 namespace hyped::telemetry {
 
@@ -13,6 +16,10 @@ class Receiver : public utils::concurrent::Thread {
   void run() override;
 
  private:
+  // wake up regularly to notice the system stopping
+  static constexpr uint32_t kReceiveTimeoutMillis = 100;
+
+  utils::System &sys_;
   data::Data &data_;
   Client &client_;
 };
@@ -1,5 +1,4 @@
 #include "sender.hpp"
-#include "writer.hpp"
 
 #include <string>
 
@@ -14,39 +13,68 @@ Sender::Sender(data::Data &data, Client &client)
       data_(data),
       client_(client)
 {
-  log_.debug("Telemetry Sender thread object created");
+  LOG_DEBUG(log_, "Telemetry Sender thread object created");
 }
 
 void Sender::run()
 {
-  log_.debug("Telemetry Sender thread started");
+  LOG_DEBUG(log_, "Telemetry Sender thread started");
 
-  int num_packages_sent = 0;
+  bool sent = sendSchema();
 
-  while (sys_.isRunning()) {
-    Writer writer;
+  uint32_t num_packages_sent = 0;
 
-    writer.start();
-    writer.packTime();
-    writer.packId(num_packages_sent);
-    writer.packTelemetryData();
-    writer.packSensorsData();
-    writer.packMotorData();
-    writer.packStateMachineData();
-    writer.packNavigationData();
-    writer.end();
+  while (sent && sys_.isRunning()) {
+    sent = sendPacket(num_packages_sent);
+    if (!sent) { break; }
+    ++num_packages_sent;
+    utils::concurrent::Thread::sleep(client_.getConfig().period_millis);
+  }
 
+  if (!sent) {
     data::Telemetry telemetry_data = data_.getTelemetryData();
-    if (!client_.sendData(writer.getString())) {
-      telemetry_data.module_status = data::ModuleStatus::kCriticalFailure;
-      data_.setTelemetryData(telemetry_data);
-      break;
-    }
-    ++num_packages_sent;
-    utils::concurrent::Thread::sleep(100);
+    telemetry_data.module_status   = data::ModuleStatus::kCriticalFailure;
+    data_.setTelemetryData(telemetry_data);
   }
 
-  log_.debug("Exiting Telemetry Sender thread");
+  LOG_DEBUG(log_, "Exiting Telemetry Sender thread");
+}
+
+bool Sender::sendSchema()
+{
+  if (client_.getConfig().format == Client::Format::kJson) { return true; }
+  binary_writer_.packSchema();
+  // frames cannot be decoded without the schema, which is only sent once
+  return client_.sendFrame(binary_writer_.getData(), binary_writer_.getSize(), false);
+}
+
+bool Sender::sendPacket(const uint32_t id)
+{
+  const auto &config = client_.getConfig();
+  switch (config.format) {
+    case Client::Format::kJson:
+      writer_.reset();
+      writer_.start();
+      writer_.packTime();
+      writer_.packId(id);
+      writer_.packTelemetryData();
+      writer_.packSensorsData();
+      writer_.packMotorData();
+      writer_.packStateMachineData();
+      writer_.packNavigationData();
+      writer_.end();
+      return client_.sendData(writer_.getView());
+    case Client::Format::kDelta:
+      if (id % config.keyframe_interval != 0) {
+        binary_writer_.packDelta(id);
+        break;
+      }
+      [[fallthrough]];
+    case Client::Format::kBinary:
+      binary_writer_.packFull(id);
+      break;
+  }
+  return client_.sendFrame(binary_writer_.getData(), binary_writer_.getSize());
 }
 
 }  // namespace hyped::telemetry
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "binary_writer.hpp"
 #include "main.hpp"
+#include "writer.hpp"
 
 #include <string>
 
@@ -17,10 +19,23 @@ class Sender : public utils::concurrent::Thread {
   explicit Sender(data::Data &data, Client &client);
   void run() override;
 
+  /**
+   * @brief Sends the schema that binary frames need to be decoded. Does nothing for JSON.
+   */
+  bool sendSchema();
+
+  /**
+   * @brief Packs the current data into a packet of the configured format and sends it. Reuses
+   *        the writers and their buffers, so no memory is allocated once the first packet is sent.
+   */
+  bool sendPacket(const uint32_t id);
+
  private:
   utils::System &sys_;
   data::Data &data_;
   Client &client_;
+  Writer writer_;
+  BinaryWriter binary_writer_;
   std::string convertStateMachineState(data::State state);
   std::string convertModuleStatus(data::ModuleStatus module_status);
 };
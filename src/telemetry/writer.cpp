@@ -10,6 +10,13 @@ namespace hyped::telemetry {
 
 Writer::Writer() : json_writer_(string_buffer_), data_(data::Data::getInstance())
 {
+  string_buffer_.Reserve(kReservedSize);
+}
+
+void Writer::reset()
+{
+  string_buffer_.Clear();
+  json_writer_.Reset(string_buffer_);
 }
 
 // The current time in milliseconds
@@ -51,7 +58,7 @@ void Writer::packTelemetryData()
 
   // Module status
   json_writer_.Key("telemetry_status");
-  json_writer_.String(convertModuleStatus(telemetry_data.module_status).c_str());
+  json_writer_.String(getModuleStatusName(telemetry_data.module_status));
   json_writer_.EndObject();
 }
 
@@ -74,7 +81,7 @@ void Writer::packNavigationData()
 
   // Module status
   json_writer_.Key("navigation_status");
-  json_writer_.String(convertModuleStatus(nav_data.module_status).c_str());
+  json_writer_.String(getModuleStatusName(nav_data.module_status));
   json_writer_.EndObject();
 }
 
@@ -117,11 +124,11 @@ void Writer::packSensorsData()
 
   // Module statuses
   json_writer_.Key("brakes_status");
-  json_writer_.String(convertModuleStatus(brakes_data.module_status).c_str());
+  json_writer_.String(getModuleStatusName(brakes_data.module_status));
   json_writer_.Key("sensors_status");
-  json_writer_.String(convertModuleStatus(sensors_data.module_status).c_str());
+  json_writer_.String(getModuleStatusName(sensors_data.module_status));
   json_writer_.Key("batteries_status");
-  json_writer_.String(convertModuleStatus(batteries_data.module_status).c_str());
+  json_writer_.String(getModuleStatusName(batteries_data.module_status));
   json_writer_.EndObject();
 }
 
@@ -141,7 +148,7 @@ void Writer::packMotorData()
 
   // Module status
   json_writer_.Key("motors_status");
-  json_writer_.String(convertModuleStatus(motor_data.module_status).c_str());
+  json_writer_.String(getModuleStatusName(motor_data.module_status));
   json_writer_.EndObject();
 }
 
@@ -154,7 +161,7 @@ void Writer::packStateMachineData()
   json_writer_.Key("critical_failure");
   json_writer_.Bool(sm_data.critical_failure);
   json_writer_.Key("current_state");
-  json_writer_.String(convertStateMachineState(sm_data.current_state).c_str());  // Crucial
+  json_writer_.String(getStateName(sm_data.current_state));  // Crucial
   json_writer_.EndObject();
 }
 
@@ -183,6 +190,16 @@ void Writer::packBattery(const data::BatteryData &battery)
 }
 
 const std::string Writer::convertStateMachineState(data::State state)
+{
+  return getStateName(state);
+}
+
+const std::string Writer::convertModuleStatus(data::ModuleStatus module_status)
+{
+  return getModuleStatusName(module_status);
+}
+
+const char *Writer::getStateName(data::State state)
 {
   switch (state) {
     case data::State::kInvalid:
@@ -218,7 +235,7 @@ const std::string Writer::convertStateMachineState(data::State state)
   }
 }
 
-const std::string Writer::convertModuleStatus(data::ModuleStatus module_status)
+const char *Writer::getModuleStatusName(data::ModuleStatus module_status)
 {
   switch (module_status) {
     case data::ModuleStatus::kStart:
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 
+#include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
 #include <data/data.hpp>
@@ -27,8 +30,14 @@ namespace hyped::telemetry {
 */
 class Writer {
  public:
+  // room for a complete packet, so that reused writers do not grow their buffer
+  static constexpr std::size_t kReservedSize = 4096;
+
   explicit Writer();
 
+  // discards the packed data so the writer can pack the next packet, keeping its buffer
+  void reset();
+
   // functions to pack timestamp and number of packages
   void packTime();
   void packId(const uint32_t id);
@@ -53,6 +62,12 @@ class Writer {
   // returns the main JSON object as a string, that is ready to be sent to GUI
   std::string getString() { return string_buffer_.GetString(); }
 
+  // same as getString() without the copy; valid until the writer is reset or destroyed
+  std::string_view getView() const
+  {
+    return std::string_view(string_buffer_.GetString(), string_buffer_.GetSize());
+  }
+
   // converts Enum to String values with required formatting for GUI
   static const std::string convertStateMachineState(data::State state);
   static const std::string convertModuleStatus(data::ModuleStatus module_status);
@@ -61,6 +76,10 @@ class Writer {
   // functions to pack internal CDS structs/types
   void packBattery(const data::BatteryData &battery);
 
+  // same as the conversions above without constructing strings
+  static const char *getStateName(data::State state);
+  static const char *getModuleStatusName(data::ModuleStatus module_status);
+
   rapidjson::StringBuffer string_buffer_;
   rapidjson::Writer<rapidjson::StringBuffer> json_writer_;
   data::Data &data_;
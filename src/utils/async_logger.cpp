@@ -0,0 +1,405 @@
+#include "utils/async_logger.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+namespace hyped::utils {
+
+AsyncLogger::AsyncLogger(FILE *output, FILE *error_output)
+    : id_(next_id_.fetch_add(1)),
+      output_(output),
+      error_output_(error_output)
+{
+}
+
+AsyncLogger::~AsyncLogger()
+{
+  AsyncLogger *expected = this;
+  Logger::async_logger_.compare_exchange_strong(expected, nullptr);
+  stop();
+}
+
+void AsyncLogger::start()
+{
+  if (is_running_.exchange(true)) { return; }
+  thread_ = std::thread(&AsyncLogger::run, this);
+}
+
+void AsyncLogger::stop()
+{
+  is_running_.store(false);
+  if (thread_.joinable()) { thread_.join(); }
+  flush();
+}
+
+void AsyncLogger::flush()
+{
+  drain();
+}
+
+bool AsyncLogger::push(const Logger::Level level, const char *module, const char *format,
+                       va_list args)
+{
+  ProducerRing &ring   = getRing();
+  Record *const record = ring.records.tryReserve();
+  if (record == nullptr) {
+    ring.num_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  record->time  = std::chrono::system_clock::now();
+  record->level = level;
+  std::strncpy(record->module, module, kMaxModuleLength - 1);
+  record->module[kMaxModuleLength - 1] = '\0';
+  va_list captured_args;
+  va_copy(captured_args, args);
+  record->is_formatted = !capture(*record, format, captured_args);
+  va_end(captured_args);
+  if (record->is_formatted) { vsnprintf(record->text, kMaxMessageLength, format, args); }
+  ring.records.publish();
+  return true;
+}
+
+std::size_t AsyncLogger::parseConversion(const char *spec, ArgumentType &type)
+{
+  std::size_t length = 1;
+  while (std::strchr("-+ #0'", spec[length]) != nullptr && spec[length] != '\0') {
+    ++length;
+  }
+  while (std::isdigit(static_cast<unsigned char>(spec[length]))) {
+    ++length;
+  }
+  if (spec[length] == '.') {
+    ++length;
+    while (std::isdigit(static_cast<unsigned char>(spec[length]))) {
+      ++length;
+    }
+  }
+  // length modifier, as the number of 'h' or 'l' or the single other modifier character
+  char modifier           = '\0';
+  std::size_t num_repeats = 0;
+  while (std::strchr("hljzt", spec[length]) != nullptr && spec[length] != '\0') {
+    if (modifier != '\0' && modifier != spec[length]) { return 0; }
+    modifier = spec[length];
+    ++num_repeats;
+    ++length;
+  }
+  if (num_repeats > (modifier == 'h' || modifier == 'l' ? 2u : 1u)) { return 0; }
+  const bool is_long      = modifier == 'l' && num_repeats == 1;
+  const bool is_long_long = modifier == 'l' && num_repeats == 2;
+  switch (spec[length]) {
+    case '%':
+      if (length != 1) { return 0; }
+      type = ArgumentType::kNone;
+      break;
+    case 'd':
+    case 'i':
+      if (modifier == 'j') {
+        type = ArgumentType::kIntMax;
+      } else if (modifier == 'z') {
+        type = ArgumentType::kSize;
+      } else if (modifier == 't') {
+        type = ArgumentType::kPtrdiff;
+      } else if (is_long_long) {
+        type = ArgumentType::kLongLong;
+      } else if (is_long) {
+        type = ArgumentType::kLong;
+      } else {
+        type = ArgumentType::kInt;
+      }
+      break;
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+      if (modifier == 'j') {
+        type = ArgumentType::kUnsignedIntMax;
+      } else if (modifier == 'z') {
+        type = ArgumentType::kSize;
+      } else if (modifier == 't') {
+        type = ArgumentType::kPtrdiff;
+      } else if (is_long_long) {
+        type = ArgumentType::kUnsignedLongLong;
+      } else if (is_long) {
+        type = ArgumentType::kUnsignedLong;
+      } else {
+        type = ArgumentType::kUnsigned;
+      }
+      break;
+    case 'c':
+      if (modifier != '\0') { return 0; }
+      type = ArgumentType::kInt;
+      break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      if (modifier != '\0' && !is_long) { return 0; }
+      type = ArgumentType::kDouble;
+      break;
+    case 'p':
+      if (modifier != '\0') { return 0; }
+      type = ArgumentType::kPointer;
+      break;
+    case 's':
+      if (modifier != '\0') { return 0; }
+      type = ArgumentType::kString;
+      break;
+    default:
+      // %n, '*' widths and precisions, long double and anything unknown
+      return 0;
+  }
+  ++length;
+  return length < kMaxConversionLength ? length : 0;
+}
+
+bool AsyncLogger::capture(Record &record, const char *format, va_list args)
+{
+  const std::size_t format_size = std::strlen(format) + 1;
+  if (format_size > kMaxMessageLength) { return false; }
+  std::memcpy(record.text, format, format_size);
+  std::size_t text_size = format_size;
+  record.num_arguments  = 0;
+  const char *spec      = std::strchr(record.text, '%');
+  for (; spec != nullptr; spec = std::strchr(spec, '%')) {
+    ArgumentType type;
+    const std::size_t length = parseConversion(spec, type);
+    if (length == 0) { return false; }
+    spec += length;
+    if (type == ArgumentType::kNone) { continue; }
+    if (record.num_arguments == kMaxArguments) { return false; }
+    Argument &argument = record.arguments[record.num_arguments];
+    record.argument_types[record.num_arguments] = type;
+    ++record.num_arguments;
+    switch (type) {
+      case ArgumentType::kNone:
+        break;
+      case ArgumentType::kInt:
+        argument.int_value = va_arg(args, int);
+        break;
+      case ArgumentType::kUnsigned:
+        argument.unsigned_value = va_arg(args, unsigned);
+        break;
+      case ArgumentType::kLong:
+        argument.long_value = va_arg(args, long);
+        break;
+      case ArgumentType::kUnsignedLong:
+        argument.unsigned_long_value = va_arg(args, unsigned long);
+        break;
+      case ArgumentType::kLongLong:
+        argument.long_long_value = va_arg(args, long long);
+        break;
+      case ArgumentType::kUnsignedLongLong:
+        argument.unsigned_long_long_value = va_arg(args, unsigned long long);
+        break;
+      case ArgumentType::kIntMax:
+        argument.int_max_value = va_arg(args, intmax_t);
+        break;
+      case ArgumentType::kUnsignedIntMax:
+        argument.unsigned_int_max_value = va_arg(args, uintmax_t);
+        break;
+      case ArgumentType::kSize:
+        argument.size_value = va_arg(args, std::size_t);
+        break;
+      case ArgumentType::kPtrdiff:
+        argument.ptrdiff_value = va_arg(args, std::ptrdiff_t);
+        break;
+      case ArgumentType::kDouble:
+        argument.double_value = va_arg(args, double);
+        break;
+      case ArgumentType::kPointer:
+        argument.pointer_value = va_arg(args, const void *);
+        break;
+      case ArgumentType::kString: {
+        // the characters are copied, as the string need not outlive the call
+        const char *string       = va_arg(args, const char *);
+        const char *const copied = string != nullptr ? string : "(null)";
+        const std::size_t size   = std::strlen(copied) + 1;
+        if (size > kMaxMessageLength - text_size) { return false; }
+        std::memcpy(record.text + text_size, copied, size);
+        argument.string_offset = text_size;
+        text_size += size;
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+void AsyncLogger::format(const Record &record, char (&message)[kMaxMessageLength])
+{
+  std::size_t size         = 0;
+  std::size_t num_captured = 0;
+  const char *position     = record.text;
+  // each conversion is formatted on its own so that it reads its argument with the right type
+  while (*position != '\0' && size < kMaxMessageLength - 1) {
+    if (*position != '%') {
+      message[size++] = *position++;
+      continue;
+    }
+    ArgumentType type;
+    const std::size_t length = parseConversion(position, type);
+    if (type == ArgumentType::kNone) {
+      message[size++] = '%';
+      position += length;
+      continue;
+    }
+    char spec[kMaxConversionLength];
+    std::memcpy(spec, position, length);
+    spec[length]             = '\0';
+    position                 = position + length;
+    const Argument &argument = record.arguments[num_captured++];
+    char *const output       = message + size;
+    const std::size_t space  = kMaxMessageLength - size;
+    int num_written          = 0;
+    switch (type) {
+      case ArgumentType::kNone:
+        break;
+      case ArgumentType::kInt:
+        num_written = snprintf(output, space, spec, argument.int_value);
+        break;
+      case ArgumentType::kUnsigned:
+        num_written = snprintf(output, space, spec, argument.unsigned_value);
+        break;
+      case ArgumentType::kLong:
+        num_written = snprintf(output, space, spec, argument.long_value);
+        break;
+      case ArgumentType::kUnsignedLong:
+        num_written = snprintf(output, space, spec, argument.unsigned_long_value);
+        break;
+      case ArgumentType::kLongLong:
+        num_written = snprintf(output, space, spec, argument.long_long_value);
+        break;
+      case ArgumentType::kUnsignedLongLong:
+        num_written = snprintf(output, space, spec, argument.unsigned_long_long_value);
+        break;
+      case ArgumentType::kIntMax:
+        num_written = snprintf(output, space, spec, argument.int_max_value);
+        break;
+      case ArgumentType::kUnsignedIntMax:
+        num_written = snprintf(output, space, spec, argument.unsigned_int_max_value);
+        break;
+      case ArgumentType::kSize:
+        num_written = snprintf(output, space, spec, argument.size_value);
+        break;
+      case ArgumentType::kPtrdiff:
+        num_written = snprintf(output, space, spec, argument.ptrdiff_value);
+        break;
+      case ArgumentType::kDouble:
+        num_written = snprintf(output, space, spec, argument.double_value);
+        break;
+      case ArgumentType::kPointer:
+        num_written = snprintf(output, space, spec, argument.pointer_value);
+        break;
+      case ArgumentType::kString:
+        num_written = snprintf(output, space, spec, record.text + argument.string_offset);
+        break;
+    }
+    if (num_written > 0) {
+      size = std::min(size + static_cast<std::size_t>(num_written), kMaxMessageLength - 1);
+    }
+  }
+  message[size] = '\0';
+}
+
+uint64_t AsyncLogger::getNumDropped() const
+{
+  concurrent::ScopedLock scoped_lock(&rings_lock_);
+  uint64_t num_dropped = 0;
+  for (const auto &ring : rings_) {
+    num_dropped += ring->num_dropped.load(std::memory_order_relaxed);
+  }
+  return num_dropped;
+}
+
+AsyncLogger::ProducerRing &AsyncLogger::getRing()
+{
+  static constexpr uint64_t kNoLogger = std::numeric_limits<uint64_t>::max();
+  struct Ownership {
+    uint64_t logger_id = kNoLogger;
+    std::shared_ptr<ProducerRing> ring;
+    ~Ownership()
+    {
+      if (ring) { ring->is_owned.store(false, std::memory_order_release); }
+    }
+  };
+  thread_local Ownership ownership;
+  if (ownership.logger_id == id_) { return *ownership.ring; }
+
+  // first message of this thread to this logger; take over a ring left behind by an exited thread
+  // if there is one, otherwise register a new ring
+  if (ownership.ring) { ownership.ring->is_owned.store(false, std::memory_order_release); }
+  concurrent::ScopedLock scoped_lock(&rings_lock_);
+  ownership.ring.reset();
+  for (const auto &ring : rings_) {
+    bool is_owned = false;
+    if (ring->is_owned.compare_exchange_strong(is_owned, true, std::memory_order_acquire)) {
+      ownership.ring = ring;
+      break;
+    }
+  }
+  if (!ownership.ring) {
+    ownership.ring = std::make_shared<ProducerRing>();
+    rings_.push_back(ownership.ring);
+  }
+  ownership.logger_id = id_;
+  return *ownership.ring;
+}
+
+std::size_t AsyncLogger::drain()
+{
+  concurrent::ScopedLock drain_lock(&drain_lock_);
+  std::vector<std::shared_ptr<ProducerRing>> rings;
+  {
+    concurrent::ScopedLock rings_lock(&rings_lock_);
+    rings = rings_;
+  }
+  std::size_t num_written = 0;
+  char message[kMaxMessageLength];
+  for (const auto &ring : rings) {
+    while (const Record *record = ring->records.front()) {
+      FILE *const file = record->level == Logger::Level::kError ? error_output_ : output_;
+      Logger::printHead(file, Logger::getTitle(record->level), record->module, record->time);
+      if (record->is_formatted) {
+        fprintf(file, "%s\n", record->text);
+      } else {
+        format(*record, message);
+        fprintf(file, "%s\n", message);
+      }
+      ring->records.pop();
+      ++num_written;
+    }
+    const uint64_t num_dropped = ring->num_dropped.load(std::memory_order_relaxed);
+    if (num_dropped != ring->num_reported_dropped) {
+      Logger::printHead(error_output_, Logger::getTitle(Logger::Level::kError), "LOGGER",
+                        std::chrono::system_clock::now());
+      fprintf(error_output_, "dropped %" PRIu64 " messages because a thread logged too fast\n",
+              num_dropped - ring->num_reported_dropped);
+      ring->num_reported_dropped = num_dropped;
+      ++num_written;
+    }
+  }
+  if (num_written > 0) {
+    fflush(output_);
+    fflush(error_output_);
+  }
+  return num_written;
+}
+
+void AsyncLogger::run()
+{
+  while (is_running_.load()) {
+    if (drain() == 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(kIdlePollingMicros));
+    }
+  }
+}
+
+}  // namespace hyped::utils
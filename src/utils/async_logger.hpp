@@ -0,0 +1,194 @@
+#pragma once
+
+#include "logger.hpp"
+
+#include <stdio.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <utils/concurrent/lock.hpp>
+#include <utils/concurrent/spsc_ring.hpp>
+
+namespace hyped::utils {
+
+/**
+ * @brief Logging backend that takes formatting, the output lock and the write to stdout/stderr
+ *        off the calling thread.
+ *
+ *        Every thread that logs gets its own single-producer single-consumer ring of fixed-size
+ *        records. `push` copies the format string into the next free record together with the
+ *        arguments, reading each one with the type its conversion specifies and copying the
+ *        characters of strings, and publishes it. It never takes a lock, never allocates (except
+ *        for the first message of a thread, which registers its ring), never blocks and never
+ *        formats, so its cost is bounded by copying at most kMaxMessageLength bytes and
+ *        kMaxArguments arguments. If the ring is full the message is dropped and counted instead.
+ *        A background thread started by `start` drains all rings, formats the messages, adds the
+ *        timestamp and module header and writes them out, reporting any drops as errors.
+ *
+ *        Messages that cannot be captured this way are formatted on the calling thread instead:
+ *        conversions taking the width or precision as an argument, `%n`, wide characters and
+ *        strings, `long double`, more than kMaxArguments arguments, or a format and strings that
+ *        do not fit into kMaxMessageLength bytes together.
+ *
+ *        Messages of a single thread are written in order; messages of different threads are
+ *        only ordered up to the polling interval of the background thread.
+ */
+class AsyncLogger {
+ public:
+  static constexpr std::size_t kRingCapacity     = 256;
+  static constexpr std::size_t kMaxMessageLength = 192;
+  static constexpr std::size_t kMaxModuleLength  = 32;
+  static constexpr std::size_t kMaxArguments     = 8;
+  static constexpr uint32_t kIdlePollingMicros   = 1000;
+
+  /**
+   * @param output where info and debug messages are written
+   * @param error_output where error messages and drop reports are written
+   */
+  explicit AsyncLogger(FILE *output = stdout, FILE *error_output = stderr);
+  ~AsyncLogger();
+
+  /**
+   * @brief Spawns the background thread that writes out the messages.
+   */
+  void start();
+
+  /**
+   * @brief Stops the background thread after it has written out every pending message.
+   */
+  void stop();
+
+  /**
+   * @brief Writes out every pending message on the calling thread. May be used with or without
+   *        the background thread running.
+   */
+  void flush();
+
+  /**
+   * @brief Records a message of the calling thread. See the class description for guarantees.
+   *        Messages longer than kMaxMessageLength - 1 characters are truncated.
+   *
+   * @return false iff the message was dropped because the thread's ring was full
+   */
+  bool push(Logger::Level level, const char *module, const char *format, va_list args);
+
+  /**
+   * @brief Total number of messages dropped so far across all threads.
+   */
+  uint64_t getNumDropped() const;
+
+ private:
+  // the type a conversion specification reads its argument as, see parseConversion
+  enum class ArgumentType : uint8_t {
+    kNone,  // "%%" takes no argument
+    kInt,
+    kUnsigned,
+    kLong,
+    kUnsignedLong,
+    kLongLong,
+    kUnsignedLongLong,
+    kIntMax,
+    kUnsignedIntMax,
+    kSize,
+    kPtrdiff,
+    kDouble,
+    kPointer,
+    kString,  // stored as the offset of the copied characters in Record::text
+  };
+
+  union Argument {
+    int int_value;
+    unsigned unsigned_value;
+    long long_value;
+    unsigned long unsigned_long_value;
+    long long long_long_value;
+    unsigned long long unsigned_long_long_value;
+    intmax_t int_max_value;
+    uintmax_t unsigned_int_max_value;
+    std::size_t size_value;
+    std::ptrdiff_t ptrdiff_value;
+    double double_value;
+    const void *pointer_value;
+    std::size_t string_offset;
+  };
+
+  struct Record {
+    std::chrono::system_clock::time_point time;
+    Logger::Level level;
+    char module[kMaxModuleLength];
+    // whether `text` holds the formatted message rather than the format and the strings
+    bool is_formatted;
+    std::size_t num_arguments;
+    std::array<ArgumentType, kMaxArguments> argument_types;
+    std::array<Argument, kMaxArguments> arguments;
+    char text[kMaxMessageLength];
+  };
+
+  // longest conversion specification that is captured, e.g. "%-08.3llx" is 9 characters
+  static constexpr std::size_t kMaxConversionLength = 16;
+
+  /**
+   * @brief Parses the conversion specification starting at the '%' `spec` points to.
+   *
+   * @return the length of the specification, 0 if it cannot be captured
+   */
+  static std::size_t parseConversion(const char *spec, ArgumentType &type);
+
+  /**
+   * @brief Copies the format and the arguments into `record`.
+   *
+   * @return false if the message cannot be captured and has to be formatted by the caller
+   */
+  static bool capture(Record &record, const char *format, va_list args);
+
+  /**
+   * @brief Formats the message captured in `record` into `message`, truncating it like
+   *        `snprintf` would.
+   */
+  static void format(const Record &record, char (&message)[kMaxMessageLength]);
+
+  struct ProducerRing {
+    concurrent::SpscRing<Record, kRingCapacity> records;
+    std::atomic<uint64_t> num_dropped = 0;
+    // only accessed while holding drain_lock_
+    uint64_t num_reported_dropped = 0;
+    // cleared when the owning thread exits so that another thread can take the ring over
+    std::atomic<bool> is_owned = true;
+  };
+
+  /**
+   * @brief Returns the calling thread's ring, registering one on first use.
+   */
+  ProducerRing &getRing();
+
+  /**
+   * @brief Writes out everything currently in the rings.
+   *
+   * @return number of records written
+   */
+  std::size_t drain();
+
+  void run();
+
+  inline static std::atomic<uint64_t> next_id_ = 0;
+  const uint64_t id_;
+  FILE *const output_;
+  FILE *const error_output_;
+
+  mutable concurrent::Lock rings_lock_;
+  std::vector<std::shared_ptr<ProducerRing>> rings_;
+  concurrent::Lock drain_lock_;
+
+  std::atomic<bool> is_running_ = false;
+  std::thread thread_;
+};
+
+}  // namespace hyped::utils
@@ -1,6 +1,8 @@
 #include "condition_variable.hpp"
 #include "lock.hpp"
 
+#include <chrono>
+
 namespace hyped {
 namespace utils {
 namespace concurrent {
@@ -30,6 +32,12 @@ void ConditionVariable::wait(Lock *lock)
   cond_var_->wait(*lock->mutex_);
 }
 
+bool ConditionVariable::waitFor(Lock *lock, uint64_t micros)
+{
+  return cond_var_->wait_for(*lock->mutex_, std::chrono::microseconds(micros))
+         == std::cv_status::no_timeout;
+}
+
 }  // namespace concurrent
 }  // namespace utils
 }  // namespace hyped
@@ -3,6 +3,7 @@
 #define CV condition_variable_any
 
 #include <condition_variable>
+#include <cstdint>
 
 namespace hyped {
 namespace utils {
@@ -35,6 +36,13 @@ class ConditionVariable {
    */
   void wait(Lock *lock);
 
+  /**
+   * @brief      Same as wait() but gives up after `micros` microseconds.
+   *
+   * @return     False iff the wait timed out.
+   */
+  bool waitFor(Lock *lock, uint64_t micros);
+
  private:
   std::CV *cond_var_;
 };
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace hyped::utils::concurrent {
+
+/**
+ * @brief Bounded lock-free queue for any number of producer and consumer threads. Neither side
+ *        ever blocks or allocates: pushing fails if the queue is full and popping fails if it is
+ *        empty.
+ *
+ *        Every cell carries a sequence number that tells producers and consumers whether it is
+ *        free to be written or ready to be read in the current lap around the ring, so that a
+ *        position is claimed with a single compare-and-swap on the shared index. Elements are
+ *        copied in and out, so T should be small and trivially copyable.
+ *
+ * @tparam T Element type
+ * @tparam kCapacity Number of elements, must be a power of two
+ */
+template<typename T, std::size_t kCapacity>
+class MpmcQueue {
+ public:
+  static_assert(kCapacity > 1 && (kCapacity & (kCapacity - 1)) == 0,
+                "capacity must be a power of two greater than one");
+
+  MpmcQueue()
+  {
+    for (std::size_t i = 0; i < kCapacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Copies `value` into the queue unless it is full.
+   */
+  bool tryPush(const T &value)
+  {
+    std::size_t position = push_index_.load(std::memory_order_relaxed);
+    Cell *cell;
+    while (true) {
+      cell                       = &cells_[position & kMask];
+      const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto difference
+        = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+      if (difference == 0) {
+        // the cell is free in this lap, try to claim it
+        if (push_index_.compare_exchange_weak(position, position + 1,
+                                              std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        // the cell still holds the element of the previous lap
+        return false;
+      } else {
+        position = push_index_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = value;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Moves the oldest element into `value` unless the queue is empty.
+   */
+  bool tryPop(T &value)
+  {
+    std::size_t position = pop_index_.load(std::memory_order_relaxed);
+    Cell *cell;
+    while (true) {
+      cell                       = &cells_[position & kMask];
+      const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto difference
+        = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+      if (difference == 0) {
+        // the cell has been written in this lap, try to claim it
+        if (pop_index_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        // the cell has not been written yet
+        return false;
+      } else {
+        position = pop_index_.load(std::memory_order_relaxed);
+      }
+    }
+    value = cell->value;
+    cell->sequence.store(position + kCapacity, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Number of elements in the queue. Only approximate while other threads are using it.
+   */
+  std::size_t size() const
+  {
+    const std::size_t pop_index  = pop_index_.load(std::memory_order_acquire);
+    const std::size_t push_index = push_index_.load(std::memory_order_acquire);
+    return push_index > pop_index ? push_index - pop_index : 0;
+  }
+
+  static constexpr std::size_t capacity() { return kCapacity; }
+
+ private:
+  static constexpr std::size_t kMask           = kCapacity - 1;
+  static constexpr std::size_t kCacheLineBytes = 64;
+
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  alignas(kCacheLineBytes) std::atomic<std::size_t> push_index_ = 0;
+  alignas(kCacheLineBytes) std::atomic<std::size_t> pop_index_  = 0;
+  alignas(kCacheLineBytes) std::array<Cell, kCapacity> cells_;
+};
+
+}  // namespace hyped::utils::concurrent
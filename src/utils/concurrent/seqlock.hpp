@@ -0,0 +1,99 @@
+#pragma once
+
+#include "lock.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+namespace hyped {
+namespace utils {
+namespace concurrent {
+
+/**
+ * @brief Guards a value of type T with a sequence lock. Writers are serialised by an internal
+ *        Lock and bump the sequence number before and after modifying the value. Readers never
+ *        take the lock; they copy the value and retry if the sequence number was odd or changed
+ *        while they were reading, so a reader can never block a writer.
+ *
+ *        Optimistic reads are only safe for trivially copyable types. For any other type (e.g. one
+ *        owning heap memory) reads fall back to taking the writer lock.
+ *
+ * @tparam T Underlying value type
+ */
+template<typename T>
+class SeqLock {
+ public:
+  static constexpr bool kHasOptimisticReads = std::is_trivially_copyable_v<T>;
+
+  SeqLock() : sequence_(0) {}
+
+  /**
+   * @brief Returns a consistent copy of the whole value.
+   */
+  T load() const
+  {
+    return read([](const T &value) { return value; });
+  }
+
+  /**
+   * @brief Replaces the whole value.
+   */
+  void store(const T &value)
+  {
+    write([&value](T &current) { current = value; });
+  }
+
+  /**
+   * @brief Returns the number of completed writes. Monotonically increasing.
+   */
+  uint64_t getVersion() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+  /**
+   * @brief Applies `reader` to a consistent view of the value and returns its result. The reader
+   *        may be invoked more than once and must therefore be free of side effects.
+   */
+  template<typename Reader>
+  auto read(Reader reader) const
+  {
+    if constexpr (!kHasOptimisticReads) {
+      ScopedLock L(&write_lock_);
+      return reader(value_);
+    } else {
+      while (true) {
+        const uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+          // a writer is mid-update; give it the core rather than spinning on a single-core target
+          std::this_thread::yield();
+          continue;
+        }
+        const auto result = reader(value_);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == before) { return result; }
+      }
+    }
+  }
+
+  /**
+   * @brief Applies `writer` to the value while holding the writer lock.
+   */
+  template<typename Writer>
+  void write(Writer writer)
+  {
+    ScopedLock L(&write_lock_);
+    sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    writer(value_);
+    sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+ private:
+  T value_;
+  std::atomic<uint64_t> sequence_;
+  mutable Lock write_lock_;
+};
+
+}  // namespace concurrent
+}  // namespace utils
+}  // namespace hyped
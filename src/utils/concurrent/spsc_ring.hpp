@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace hyped::utils::concurrent {
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread. Neither
+ *        side ever blocks or allocates: the producer fails if the ring is full and the consumer
+ *        finds nothing if it is empty.
+ *
+ *        Elements are written and read in place (`tryReserve`/`publish` and `front`/`pop`) so
+ *        that large records need not be copied through temporaries. The read and write indices
+ *        live on separate cache lines, and the producer caches the last read index it has seen so
+ *        that it only touches the consumer's cache line when the ring appears to be full.
+ *
+ * @tparam T Element type
+ * @tparam kCapacity Number of elements, must be a power of two
+ */
+template<typename T, std::size_t kCapacity>
+class SpscRing {
+ public:
+  static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0,
+                "capacity must be a power of two");
+
+  /**
+   * @brief Producer only. Returns the slot the next element should be written to, or nullptr if
+   *        the ring is full. The element becomes visible to the consumer on `publish`.
+   */
+  T *tryReserve()
+  {
+    const std::size_t write = write_index_.load(std::memory_order_relaxed);
+    if (write - cached_read_index_ == kCapacity) {
+      cached_read_index_ = read_index_.load(std::memory_order_acquire);
+      if (write - cached_read_index_ == kCapacity) { return nullptr; }
+    }
+    return &slots_[write & kMask];
+  }
+
+  /**
+   * @brief Producer only. Hands the slot returned by the last `tryReserve` to the consumer.
+   */
+  void publish()
+  {
+    write_index_.store(write_index_.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_release);
+  }
+
+  /**
+   * @brief Producer only. Copies `value` into the ring unless it is full.
+   */
+  bool tryPush(const T &value)
+  {
+    T *const slot = tryReserve();
+    if (slot == nullptr) { return false; }
+    *slot = value;
+    publish();
+    return true;
+  }
+
+  /**
+   * @brief Consumer only. Returns the oldest element, or nullptr if the ring is empty.
+   */
+  const T *front() const
+  {
+    const std::size_t read = read_index_.load(std::memory_order_relaxed);
+    if (read == write_index_.load(std::memory_order_acquire)) { return nullptr; }
+    return &slots_[read & kMask];
+  }
+
+  /**
+   * @brief Consumer only. Releases the element returned by `front` back to the producer.
+   */
+  void pop()
+  {
+    read_index_.store(read_index_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Number of elements in the ring. Exact only when called by one of the two threads while
+   *        the other is idle.
+   */
+  std::size_t size() const
+  {
+    return write_index_.load(std::memory_order_acquire)
+           - read_index_.load(std::memory_order_acquire);
+  }
+
+  static constexpr std::size_t capacity() { return kCapacity; }
+
+ private:
+  static constexpr std::size_t kMask           = kCapacity - 1;
+  static constexpr std::size_t kCacheLineBytes = 64;
+
+  // written by the producer
+  alignas(kCacheLineBytes) std::atomic<std::size_t> write_index_ = 0;
+  std::size_t cached_read_index_                                 = 0;
+  // written by the consumer
+  alignas(kCacheLineBytes) std::atomic<std::size_t> read_index_ = 0;
+  alignas(kCacheLineBytes) std::array<T, kCapacity> slots_;
+};
+
+}  // namespace hyped::utils::concurrent
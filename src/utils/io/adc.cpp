@@ -1,8 +1,14 @@
 #include "adc.hpp"
 
+#include <errno.h>
 #include <fcntl.h>   // define O_WONLY and O_RDONLY
 #include <unistd.h>  // close()
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 #include <utils/logger.hpp>
 #include <utils/system.hpp>
 
@@ -10,33 +16,244 @@ namespace hyped {
 namespace utils {
 namespace io {
 namespace adc {
+namespace {
+
+static constexpr char kSysfsDirectory[] = "sys/bus/iio/devices/iio:device0";
+static constexpr char kDeviceNode[]     = "dev/iio:device0";
+
+std::string joinPath(const std::string &root, const std::string &relative)
+{
+  if (!root.empty() && root.back() == '/') { return root + relative; }
+  return root + "/" + relative;
+}
+
+/**
+ * @brief Reads a sysfs attribute from its start without moving the file offset, so an open file
+ *        can be sampled repeatedly with one system call per sample.
+ */
+bool readAttribute(const int fd, char *buffer, const size_t size)
+{
+  const ssize_t num_read = pread(fd, buffer, size - 1, 0);
+  if (num_read <= 0) { return false; }
+  buffer[num_read] = '\0';
+  return true;
+}
+
+bool readFile(const std::string &path, std::string &content)
+{
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) { return false; }
+  char buffer[64];
+  const bool success = readAttribute(fd, buffer, sizeof(buffer));
+  close(fd);
+  if (!success) { return false; }
+  content = buffer;
+  while (!content.empty() && (content.back() == '\n' || content.back() == ' ')) {
+    content.pop_back();
+  }
+  return true;
+}
 
-uint16_t readHelper(int fd)
+bool writeFile(const std::string &path, const std::string &content)
 {
-  char buf[4];                 // buffer size 4 for fs value
-  lseek(fd, 0, SEEK_SET);      // reset file pointer
-  read(fd, buf, sizeof(buf));  // actually consume new data, changes value in buffer
-  return std::atoi(buf);
+  const int fd = open(path.c_str(), O_WRONLY | O_TRUNC);
+  if (fd < 0) { return false; }
+  const ssize_t num_written = write(fd, content.data(), content.size());
+  close(fd);
+  return num_written == static_cast<ssize_t>(content.size());
 }
 
+}  // namespace
 }  // namespace adc
 
-Adc::Adc(const uint32_t pin) : log_("ADC", utils::System::getSystem().config_.log_level), pin_(pin)
+Adc::Adc(const uint32_t pin, const std::string &root)
+    : log_("ADC", utils::System::getSystem().config_.log_level),
+      pin_(pin),
+      path_(adc::joinPath(root, adc::kSysfsDirectory) + "/in_voltage" + std::to_string(pin)
+            + "_raw"),
+      file_(open(path_.c_str(), O_RDONLY))
 {
+  if (file_ < 0) { log_.error("could not open %s", path_.c_str()); }
 }
+
+Adc::~Adc()
+{
+  if (file_ >= 0) { close(file_); }
+}
+
 uint16_t Adc::read()
 {
-  char buf[100];
-  snprintf(buf, sizeof(buf), "/sys/bus/iio/devices/iio:device0/in_voltage%i_raw", pin_);
-  file_ = open(buf, O_RDONLY);
-  if (file_ < 0) { log_.error("problem reading pin %d raw voltage", pin_); }
-  log_.debug("fd: %d", file_);
-  uint16_t val = adc::readHelper(file_);
-  log_.debug("val: %d", val);
-  close(file_);
+  if (file_ < 0) {
+    // the channel may have appeared since, e.g. once the ADC overlay has been loaded
+    file_ = open(path_.c_str(), O_RDONLY);
+    if (file_ < 0) { return 0; }
+  }
+  char buf[8];
+  if (!adc::readAttribute(file_, buf, sizeof(buf))) {
+    log_.error("problem reading pin %d raw voltage", pin_);
+    return 0;
+  }
+  const uint16_t val = static_cast<uint16_t>(std::strtoul(buf, nullptr, 10));
+  LOG_DEBUG(log_, "val: %d", val);
   return val;
 }
 
+AdcBuffer::AdcBuffer(const std::vector<uint32_t> &channels, const std::string &root)
+    : log_("ADC-BUFFER", utils::System::getSystem().config_.log_level),
+      sysfs_path_(adc::joinPath(root, adc::kSysfsDirectory)),
+      device_path_(adc::joinPath(root, adc::kDeviceNode)),
+      file_(-1),
+      scan_size_(0),
+      values_{}
+{
+  if (!configure(channels)) {
+    log_.error("failed to set up buffered sampling on %s", sysfs_path_.c_str());
+    return;
+  }
+  read_buffer_.resize(scan_size_ * kMaxScansPerRead);
+  file_ = open(device_path_.c_str(), O_RDONLY | O_NONBLOCK);
+  if (file_ < 0) { log_.error("could not open %s", device_path_.c_str()); }
+}
+
+AdcBuffer::~AdcBuffer()
+{
+  if (file_ >= 0) { close(file_); }
+  if (scan_size_ > 0) { adc::writeFile(sysfs_path_ + "/buffer/enable", "0"); }
+}
+
+bool AdcBuffer::isOpen() const
+{
+  return file_ >= 0;
+}
+
+std::size_t AdcBuffer::getScanSize() const
+{
+  return scan_size_;
+}
+
+bool AdcBuffer::configure(const std::vector<uint32_t> &channels)
+{
+  if (channels.empty()) {
+    log_.error("no channels to sample");
+    return false;
+  }
+  for (const uint32_t channel : channels) {
+    if (channel >= adc::kNumChannels) {
+      log_.error("channel %u does not exist", channel);
+      return false;
+    }
+  }
+  // scan elements may only be changed while the buffer is disabled
+  adc::writeFile(sysfs_path_ + "/buffer/enable", "0");
+  for (uint32_t channel = 0; channel < adc::kNumChannels; ++channel) {
+    const std::string prefix = sysfs_path_ + "/scan_elements/in_voltage" + std::to_string(channel);
+    if (std::find(channels.begin(), channels.end(), channel) == channels.end()) {
+      // channels of the device that are not sampled must not take up space in the scans
+      adc::writeFile(prefix + "_en", "0");
+      continue;
+    }
+    ScanElement element;
+    element.channel = channel;
+    std::string index;
+    std::string type;
+    if (!adc::writeFile(prefix + "_en", "1") || !adc::readFile(prefix + "_index", index)
+        || !adc::readFile(prefix + "_type", type)) {
+      log_.error("could not enable scan element of channel %u", channel);
+      return false;
+    }
+    element.index = static_cast<uint32_t>(std::strtoul(index.c_str(), nullptr, 10));
+    if (!parseType(type, element)) { return false; }
+    scan_elements_.push_back(element);
+  }
+
+  // within a scan, elements are ordered by index and each is aligned to its own size
+  std::sort(scan_elements_.begin(), scan_elements_.end(),
+            [](const ScanElement &lhs, const ScanElement &rhs) { return lhs.index < rhs.index; });
+  std::size_t offset            = 0;
+  std::size_t largest_alignment = 1;
+  for (auto &element : scan_elements_) {
+    const std::size_t alignment = element.storage_bytes;
+    element.offset              = (offset + alignment - 1) / alignment * alignment;
+    offset                      = element.offset + alignment;
+    largest_alignment           = std::max(largest_alignment, alignment);
+  }
+  // and the whole scan is padded to the alignment of its largest element
+  const std::size_t scan_size
+    = (offset + largest_alignment - 1) / largest_alignment * largest_alignment;
+
+  if (!adc::writeFile(sysfs_path_ + "/buffer/length", std::to_string(kBufferLength))
+      || !adc::writeFile(sysfs_path_ + "/buffer/enable", "1")) {
+    log_.error("could not enable buffer");
+    return false;
+  }
+  scan_size_ = scan_size;
+  return true;
+}
+
+bool AdcBuffer::parseType(const std::string &type, ScanElement &element)
+{
+  // [be|le]:[s|u]bits/storagebits>>shift, repeated elements are not supported
+  char endianness[3]    = {};
+  char sign             = 0;
+  unsigned int bits     = 0;
+  unsigned int storage  = 0;
+  unsigned int shift    = 0;
+  const int num_matched = std::sscanf(type.c_str(), "%2[bel]:%c%u/%u>>%u", endianness, &sign,
+                                      &bits, &storage, &shift);
+  const bool is_known_endianness
+    = std::strcmp(endianness, "be") == 0 || std::strcmp(endianness, "le") == 0;
+  const bool is_known_storage = storage == 8 || storage == 16 || storage == 32;
+  // values are handed out as uint16_t
+  const bool fits_value = bits > 0 && bits <= 16 && shift + bits <= storage;
+  if (num_matched != 5 || !is_known_endianness || !is_known_storage || !fits_value) {
+    log_.error("unsupported scan element type \"%s\" of channel %u", type.c_str(),
+               element.channel);
+    return false;
+  }
+  element.is_big_endian = endianness[0] == 'b';
+  element.bits          = static_cast<uint8_t>(bits);
+  element.storage_bytes = static_cast<uint8_t>(storage / 8);
+  element.shift         = static_cast<uint8_t>(shift);
+  return true;
+}
+
+bool AdcBuffer::read()
+{
+  if (file_ < 0) { return false; }
+  // drain everything the kernel has buffered so that the values kept are the most recent ones
+  std::size_t num_scans = 0;
+  while (true) {
+    const ssize_t num_read = ::read(file_, read_buffer_.data(), read_buffer_.size());
+    if (num_read < 0) {
+      if (errno != EAGAIN) { log_.error("could not read %s", device_path_.c_str()); }
+      break;
+    }
+    if (static_cast<std::size_t>(num_read) < scan_size_) { break; }
+    num_scans = static_cast<std::size_t>(num_read) / scan_size_;
+    if (num_scans < kMaxScansPerRead) { break; }
+  }
+  if (num_scans == 0) { return false; }
+
+  const uint8_t *scan = &read_buffer_[(num_scans - 1) * scan_size_];
+  for (const auto &element : scan_elements_) {
+    const uint8_t *bytes = scan + element.offset;
+    uint32_t raw         = 0;
+    for (std::size_t i = 0; i < element.storage_bytes; ++i) {
+      const std::size_t byte = element.is_big_endian ? i : element.storage_bytes - 1 - i;
+      raw                    = (raw << 8) | bytes[byte];
+    }
+    values_[element.channel]
+      = static_cast<uint16_t>((raw >> element.shift) & ((1u << element.bits) - 1));
+  }
+  return true;
+}
+
+uint16_t AdcBuffer::getValue(const uint32_t channel) const
+{
+  if (channel >= adc::kNumChannels) { return 0; }
+  return values_[channel];
+}
+
 }  // namespace io
 }  // namespace utils
 }  // namespace hyped
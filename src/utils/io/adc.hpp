@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include <utils/logger.hpp>
@@ -13,29 +16,118 @@ class Logger;
 namespace io {
 
 namespace adc {
+// file system root under which the IIO sysfs directory and device node are found
+static constexpr char kDefaultRoot[]   = "/";
+static constexpr uint32_t kNumChannels = 8;
 }  // namespace adc
 
 class Adc {
  public:
   /**
-   * @brief Construct a new ADC object when logger no initialised
+   * @brief Construct a new ADC object and open the channel's sysfs file, which stays open for the
+   *        lifetime of the object.
    *
    * @param pin
+   * @param root file system root, tests point this at a mock directory tree
    */
-  explicit Adc(const uint32_t pin);
+  explicit Adc(const uint32_t pin, const std::string &root = adc::kDefaultRoot);
+  ~Adc();
+
+  NO_COPY_ASSIGN(Adc)
 
   /**
-   * @brief reads AIN value from file system
+   * @brief reads AIN value from file system with a single pread on the open file
    *
-   * @return uint16_t return two bytes for [0,4095] range
+   * @return uint16_t return two bytes for [0,4095] range, 0 if the channel cannot be read
    */
   uint16_t read();
 
  private:
   Logger log_;
   uint32_t pin_;
+  std::string path_;
   int file_;
 };
+
+/**
+ * @brief Samples several ADC channels at once through the IIO buffered interface. The channels are
+ *        enabled as scan elements and the kernel fills a buffer with scans, i.e. one value of
+ *        every enabled channel per conversion, which are read from the device node in blocks.
+ *        Note that while the buffer is enabled the in_voltage*_raw files of the device cannot be
+ *        read, so this replaces rather than complements Adc for the channels of that device.
+ */
+class AdcBuffer {
+ public:
+  // length of the kernel buffer, in scans
+  static constexpr uint32_t kBufferLength = 64;
+  // most scans consumed by a single read
+  static constexpr std::size_t kMaxScansPerRead = 16;
+
+  /**
+   * @param channels channels to sample, every other channel of the device is disabled
+   * @param root file system root, tests point this at a mock directory tree
+   */
+  explicit AdcBuffer(const std::vector<uint32_t> &channels,
+                     const std::string &root = adc::kDefaultRoot);
+  ~AdcBuffer();
+
+  NO_COPY_ASSIGN(AdcBuffer)
+
+  /**
+   * @return true iff the scan elements were configured and the device node could be opened
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Reads the scans buffered since the last call, kMaxScansPerRead at a time and without
+   *        blocking, and keeps the values of the most recent one.
+   *
+   * @return true iff at least one new scan was read
+   */
+  bool read();
+
+  /**
+   * @return value of `channel` in the most recent scan, 0 if there is none or the channel is not
+   *         sampled
+   */
+  uint16_t getValue(const uint32_t channel) const;
+
+  /**
+   * @return number of bytes of one scan
+   */
+  std::size_t getScanSize() const;
+
+ private:
+  struct ScanElement {
+    uint32_t channel;
+    uint32_t index;
+    bool is_big_endian;
+    uint8_t bits;
+    uint8_t storage_bytes;
+    uint8_t shift;
+    std::size_t offset;
+  };
+
+  /**
+   * @brief Enables exactly the requested scan elements, reads their layout and enables the buffer.
+   */
+  bool configure(const std::vector<uint32_t> &channels);
+
+  /**
+   * @brief Parses an IIO scan element type such as "le:u12/16>>0".
+   */
+  bool parseType(const std::string &type, ScanElement &element);
+
+  Logger log_;
+  std::string sysfs_path_;
+  std::string device_path_;
+  int file_;
+  std::vector<ScanElement> scan_elements_;
+  std::size_t scan_size_;
+  std::vector<uint8_t> read_buffer_;
+  std::array<uint16_t, adc::kNumChannels> values_;
+};
+
 }  // namespace io
 }  // namespace utils
 }  // namespace hyped
@@ -5,11 +5,18 @@
 
 #include <net/if.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+
+#include <utils/io/virtual_can_bus.hpp>
 #include <utils/system.hpp>
 
 #if LINUX
 #include <linux/can.h>
+#include <linux/can/raw.h>
 #else
 #define CAN_MAX_DLEN 8
 
@@ -45,8 +52,183 @@ namespace hyped {
 namespace utils {
 namespace io {
 
-Can::Can()
-    : utils::concurrent::Thread(utils::Logger("CAN", utils::System::getSystem().config_.log_level))
+namespace {
+
+void toRaw(const can::Frame &frame, can_frame &raw)
+{
+  raw.can_id = frame.id;
+  raw.can_id |= frame.extended ? can::Frame::kExtendedMask : 0;  // add extended id flag
+  raw.can_dlc = frame.len;
+  for (size_t i = 0; i < frame.len; ++i) {
+    raw.data[i] = frame.data[i];
+  }
+}
+
+void fromRaw(const can_frame &raw, can::Frame &frame)
+{
+  frame.id       = raw.can_id & ~can::Frame::kExtendedMask;
+  frame.extended = raw.can_id & can::Frame::kExtendedMask;
+  frame.len      = raw.can_dlc;
+  for (size_t i = 0; i < frame.len; ++i) {
+    frame.data[i] = raw.data[i];
+  }
+}
+
+}  // namespace
+
+namespace can {
+
+std::vector<Filter> toFilters(const IdRange &ids)
+{
+  std::vector<Filter> filters;
+  if (!ids.isValid()) { return filters; }
+  const uint32_t id_mask = ids.extended ? IdRange::kMaxExtendedId : IdRange::kMaxStandardId;
+  const uint32_t flags   = ids.extended ? Frame::kExtendedMask : 0;
+  // 64 bits so that the end of the largest extended range does not overflow
+  uint64_t first     = ids.first;
+  const uint64_t end = static_cast<uint64_t>(ids.last) + 1;
+  while (first < end) {
+    // largest block aligned at `first` that does not extend past `end`
+    uint64_t size = first == 0 ? static_cast<uint64_t>(id_mask) + 1 : first & -first;
+    while (first + size > end) {
+      size /= 2;
+    }
+    const uint32_t block_mask = id_mask & ~static_cast<uint32_t>(size - 1);
+    filters.push_back({static_cast<uint32_t>(first) | flags,
+                       block_mask | Frame::kExtendedMask | Filter::kRemoteMask});
+    first += size;
+  }
+  return filters;
+}
+
+DispatchTable::DispatchTable() : processor_lists_(1)
+{
+  standard_.fill(0);
+}
+
+bool DispatchTable::add(ICanProcessor *processor, const IdRange &ids)
+{
+  if (!ids.isValid()) { return false; }
+  registrations_.push_back({processor, ids});
+  rebuild();
+  return true;
+}
+
+bool DispatchTable::remove(ICanProcessor *processor, const IdRange &ids)
+{
+  const auto registration
+    = std::find_if(registrations_.begin(), registrations_.end(), [&](const Registration &other) {
+        return other.processor == processor && other.ids.first == ids.first
+               && other.ids.last == ids.last && other.ids.extended == ids.extended;
+      });
+  if (registration == registrations_.end()) { return false; }
+  registrations_.erase(registration);
+  rebuild();
+  return true;
+}
+
+std::size_t DispatchTable::dispatch(Frame &frame) const
+{
+  uint16_t index = 0;
+  if (!frame.extended) {
+    if (frame.id > IdRange::kMaxStandardId) { return 0; }
+    index = standard_[frame.id];
+  } else {
+    // first entry starting after the id, the one before it is the only candidate
+    const auto entry = std::upper_bound(
+      extended_.begin(), extended_.end(), frame.id,
+      [](const uint32_t id, const ExtendedEntry &other) { return id < other.first; });
+    if (entry == extended_.begin() || std::prev(entry)->last < frame.id) { return 0; }
+    index = std::prev(entry)->processors;
+  }
+  const Processors &processors = processor_lists_[index];
+  for (ICanProcessor *processor : processors) {
+    processor->processNewData(frame);
+  }
+  return processors.size();
+}
+
+std::vector<IdRange> DispatchTable::getRanges() const
+{
+  std::vector<IdRange> ranges;
+  for (uint32_t id = 0; id <= IdRange::kMaxStandardId; ++id) {
+    if (standard_[id] == 0) { continue; }
+    if (!ranges.empty() && ranges.back().last + 1 == id) {
+      ranges.back().last = id;
+    } else {
+      ranges.push_back(IdRange::exact(id, false));
+    }
+  }
+  for (const auto &entry : extended_) {
+    if (!ranges.empty() && ranges.back().extended && ranges.back().last + 1 == entry.first) {
+      ranges.back().last = entry.last;
+    } else {
+      ranges.push_back({entry.first, entry.last, true});
+    }
+  }
+  return ranges;
+}
+
+uint16_t DispatchTable::intern(const Processors &processors)
+{
+  const auto existing = std::find(processor_lists_.begin(), processor_lists_.end(), processors);
+  if (existing != processor_lists_.end()) {
+    return static_cast<uint16_t>(existing - processor_lists_.begin());
+  }
+  processor_lists_.push_back(processors);
+  return static_cast<uint16_t>(processor_lists_.size() - 1);
+}
+
+void DispatchTable::rebuild()
+{
+  processor_lists_.resize(1);
+  extended_.clear();
+
+  Processors processors;
+  for (uint32_t id = 0; id <= IdRange::kMaxStandardId; ++id) {
+    processors.clear();
+    for (const auto &registration : registrations_) {
+      const auto &ids = registration.ids;
+      if (!ids.extended && ids.first <= id && id <= ids.last) {
+        processors.push_back(registration.processor);
+      }
+    }
+    standard_[id] = intern(processors);
+  }
+
+  // split the extended ranges at every boundary so that the resulting entries are disjoint
+  std::vector<uint32_t> boundaries;
+  for (const auto &registration : registrations_) {
+    if (!registration.ids.extended) { continue; }
+    boundaries.push_back(registration.ids.first);
+    boundaries.push_back(registration.ids.last + 1);
+  }
+  std::sort(boundaries.begin(), boundaries.end());
+  boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+  for (std::size_t i = 0; i + 1 < boundaries.size(); ++i) {
+    const uint32_t first = boundaries[i];
+    const uint32_t last  = boundaries[i + 1] - 1;
+    processors.clear();
+    for (const auto &registration : registrations_) {
+      const auto &ids = registration.ids;
+      if (ids.extended && ids.first <= first && last <= ids.last) {
+        processors.push_back(registration.processor);
+      }
+    }
+    if (processors.empty()) { continue; }
+    const uint16_t index = intern(processors);
+    if (!extended_.empty() && extended_.back().last + 1 == first
+        && extended_.back().processors == index) {
+      extended_.back().last = last;
+    } else {
+      extended_.push_back({first, last, index});
+    }
+  }
+}
+
+SocketBus::SocketBus(const std::string &interface_name)
+    : log_("CAN", utils::System::getSystem().config_.log_level),
+      timeout_micros_(0)
 {
   if ((socket_ = socket(PF_CAN, SOCK_RAW, CAN_RAW)) < 0) {
     log_.error("Could not open can socket");
@@ -55,10 +237,10 @@ Can::Can()
 
   sockaddr_can addr;
   addr.can_family  = AF_CAN;
-  addr.can_ifindex = if_nametoindex("can0");  // ifr.ifr_ifindex;
+  addr.can_ifindex = if_nametoindex(interface_name.c_str());  // ifr.ifr_ifindex;
 
   if (addr.can_ifindex == 0) {
-    log_.error("Could not find can0 network interface");
+    log_.error("Could not find %s network interface", interface_name.c_str());
     close(socket_);
     socket_ = -1;
     return;
@@ -74,9 +256,142 @@ Can::Can()
   log_.info("socket successfully created");  // TODO(Gregor): log this only if successful
 }
 
+SocketBus::~SocketBus()
+{
+  if (socket_ >= 0) close(socket_);
+}
+
+std::size_t SocketBus::send(const Frame *frames, const std::size_t num_frames)
+{
+  if (socket_ < 0) { return 0; }
+  const std::size_t batch_size = std::min(num_frames, kMaxBatchSize);
+  std::array<can_frame, kMaxBatchSize> raw_frames;
+  for (std::size_t i = 0; i < batch_size; ++i) {
+    toRaw(frames[i], raw_frames[i]);
+  }
+  concurrent::ScopedLock L(&socket_lock_);
+  if (batch_size == 1) { return write(socket_, &raw_frames[0], CAN_MTU) == CAN_MTU ? 1 : 0; }
+#if LINUX
+  std::array<iovec, kMaxBatchSize> buffers;
+  std::array<mmsghdr, kMaxBatchSize> messages{};
+  for (std::size_t i = 0; i < batch_size; ++i) {
+    buffers[i].iov_base            = &raw_frames[i];
+    buffers[i].iov_len             = CAN_MTU;
+    messages[i].msg_hdr.msg_iov    = &buffers[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+  const int num_sent = sendmmsg(socket_, messages.data(), batch_size, 0);
+  return num_sent > 0 ? num_sent : 0;
+#else
+  std::size_t num_sent = 0;
+  while (num_sent < batch_size && write(socket_, &raw_frames[num_sent], CAN_MTU) == CAN_MTU) {
+    ++num_sent;
+  }
+  return num_sent;
+#endif
+}
+
+std::size_t SocketBus::receive(Frame *frames, const std::size_t max_num_frames,
+                               const uint32_t timeout_micros)
+{
+  if (socket_ < 0) { return 0; }
+  if (timeout_micros != timeout_micros_) {
+    timeval timeout;
+    timeout.tv_sec  = timeout_micros / 1000000;
+    timeout.tv_usec = timeout_micros % 1000000;
+    setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    timeout_micros_ = timeout_micros;
+  }
+
+  const std::size_t batch_size = std::min(max_num_frames, kMaxBatchSize);
+  std::array<can_frame, kMaxBatchSize> raw_frames;
+#if LINUX
+  std::array<iovec, kMaxBatchSize> buffers;
+  std::array<mmsghdr, kMaxBatchSize> messages{};
+  for (std::size_t i = 0; i < batch_size; ++i) {
+    buffers[i].iov_base            = &raw_frames[i];
+    buffers[i].iov_len             = CAN_MTU;
+    messages[i].msg_hdr.msg_iov    = &buffers[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+  // blocks for the first frame only
+  const int num_received = recvmmsg(socket_, messages.data(), batch_size, MSG_WAITFORONE, nullptr);
+#else
+  const int num_received = read(socket_, &raw_frames[0], CAN_MTU) == CAN_MTU ? 1 : -1;
+#endif
+  if (num_received < 0) {
+    // timeouts only give the caller a chance to stop
+    if (errno != EAGAIN && errno != EWOULDBLOCK) { log_.error("cannot read from socket"); }
+    return 0;
+  }
+
+  std::size_t num_frames = 0;
+  for (int i = 0; i < num_received; ++i) {
+#if LINUX
+    if (messages[i].msg_len != CAN_MTU) {
+      log_.error("cannot read from socket");
+      continue;
+    }
+#endif
+    Frame &frame = frames[num_frames++];
+    fromRaw(raw_frames[i], frame);
+    LOG_DEBUG(log_, "received %u %u, extended %d", raw_frames[i].can_id, frame.id,
+              frame.extended);
+  }
+  return num_frames;
+}
+
+void SocketBus::setFilters(const std::vector<IdRange> &ranges)
+{
+  if (socket_ < 0) return;
+#if LINUX
+  std::vector<can_filter> filters;
+  for (const auto &ids : ranges) {
+    for (const auto &filter : toFilters(ids)) {
+      filters.push_back({filter.id, filter.mask});
+    }
+  }
+  if (filters.size() > kMaxNumKernelFilters) {
+    // receive everything and leave the filtering to the dispatch table
+    log_.error("%zu kernel filters needed, more than the maximum %zu; not filtering",
+               filters.size(), kMaxNumKernelFilters);
+    filters = {{0, 0}};
+  }
+  if (setsockopt(socket_, SOL_CAN_RAW, CAN_RAW_FILTER, filters.data(),
+                 filters.size() * sizeof(can_filter))
+      < 0) {
+    log_.error("could not install kernel filters");
+  }
+#endif
+}
+
+}  // namespace can
+
+Can &Can::getInstance()
+{
+  static Can can(utils::System::getSystem().config_.use_virtual_can
+                   ? can::VirtualBus::getInstance().attach()
+                   : std::make_unique<can::SocketBus>("can0"));
+  return can;
+}
+
+Can::Can(const std::string &interface_name)
+    : Can(std::make_unique<can::SocketBus>(interface_name))
+{
+}
+
+Can::Can(std::unique_ptr<can::IBus> bus)
+    : utils::concurrent::Thread(utils::Logger("CAN", utils::System::getSystem().config_.log_level)),
+      bus_(std::move(bus))
+{
+}
+
 Can::~Can()
 {
-  running_ = false;
+  if (running_) {
+    running_ = false;
+    join();
+  }
 }
 
 void Can::start()
@@ -89,92 +404,96 @@ void Can::start()
 
 int Can::send(const can::Frame &frame)
 {
-  if (socket_ < 0) {
+  return send(&frame, 1) == 1 ? 1 : 0;
+}
+
+std::size_t Can::send(const can::Frame *frames, const std::size_t num_frames)
+{
+  if (!bus_->isOpen()) {
     log_.error("tried to send message but no CAN device was found");
     return 0;
   }
-
-  can_frame can;
-  log_.debug("trying to send something");
   // checks, id <= ID_MAX, len <= LEN_MAX
-  if (frame.len > 8) {
-    log_.error("trying to send message of more than 8 bytes, bytes: %d", frame.len);
-    return 0;
-  }
-
-  can.can_id = frame.id;
-  can.can_id |= frame.extended ? can::Frame::kExtendedMask : 0;  // add extended id flag
-  can.can_dlc = frame.len;
-  for (size_t i = 0; i < frame.len; ++i) {
-    can.data[i] = frame.data[i];
+  for (std::size_t i = 0; i < num_frames; ++i) {
+    if (frames[i].len > 8) {
+      log_.error("trying to send message of more than 8 bytes, bytes: %d", frames[i].len);
+      return 0;
+    }
   }
 
-  {
-    concurrent::ScopedLock L(&socket_lock_);
-    if (write(socket_, &can, CAN_MTU) != CAN_MTU) {
+  std::size_t num_sent = 0;
+  while (num_sent < num_frames) {
+    const std::size_t batch_size = std::min(num_frames - num_sent, kBatchSize);
+    num_send_calls_.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t num_batch_sent = bus_->send(frames + num_sent, batch_size);
+    num_sent += num_batch_sent;
+    num_frames_sent_.fetch_add(num_batch_sent, std::memory_order_relaxed);
+    if (num_batch_sent < batch_size) {
       log_.error("cannot write to socket");
-      return 0;
+      return num_sent;
     }
   }
-
-  log_.debug("message with id %d sent, extended:%d", frame.id, frame.extended);
-  return 1;
+  LOG_DEBUG(log_, "%zu messages sent, first id %d, extended:%d", num_sent, frames[0].id,
+            frames[0].extended);
+  return num_sent;
 }
 
 void Can::run()
 {
   log_.info("starting continuous reading");
-  while (running_ && socket_ >= 0) {
-    can::Frame data;
-    const auto success = receive(&data);
-    if (!success) {
-      log_.error("failed to receive data; trying again");
-      continue;
+  std::array<can::Frame, kBatchSize> frames;
+  while (running_ && bus_->isOpen()) {
+    num_receive_calls_.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t num_frames = bus_->receive(frames.data(), kBatchSize, kReceiveTimeoutMicros);
+    num_frames_received_.fetch_add(num_frames, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < num_frames; ++i) {
+      processNewData(&frames[i]);
     }
-    processNewData(&data);
   }
   log_.info("stopped continuous reading");
-
-  if (socket_ >= 0) close(socket_);
 }
 
-int Can::receive(can::Frame *frame)
+void Can::processNewData(can::Frame *message)
 {
-  size_t nBytes;
-  can_frame raw_data;
+  concurrent::ScopedLock L(&dispatch_lock_);
+  dispatch_table_.dispatch(*message);
+}
 
-  nBytes = read(socket_, &raw_data, CAN_MTU);
-  if (nBytes != CAN_MTU) {
-    // perror("read");
-    log_.error("cannot read from socket");
-    return 0;
+void Can::registerProcessor(ICanProcessor *processor, const can::IdRange &ids)
+{
+  if (!processor) {
+    log_.error("tried to register a nullptr as a processor");
+    utils::System::getSystem().stop();
+    return;
   }
-
-  frame->id       = raw_data.can_id & ~can::Frame::kExtendedMask;
-  frame->extended = raw_data.can_id & can::Frame::kExtendedMask;
-  frame->len      = raw_data.can_dlc;
-  for (size_t i = 0; i < frame->len; ++i) {
-    frame->data[i] = raw_data.data[i];
+  concurrent::ScopedLock L(&dispatch_lock_);
+  if (!dispatch_table_.add(processor, ids)) {
+    log_.error("tried to register invalid ids 0x%x to 0x%x, extended:%d", ids.first, ids.last,
+               ids.extended);
+    return;
   }
-  log_.debug("received %u %u, extended %d", raw_data.can_id, frame->id, frame->extended);
-  return 1;
+  bus_->setFilters(dispatch_table_.getRanges());
 }
 
-void Can::processNewData(can::Frame *message)
+void Can::unregisterProcessor(ICanProcessor *processor, const can::IdRange &ids)
 {
-  for (auto &processor : processors_) {
-    if (processor->hasId(message->id, message->extended)) { processor->processNewData(*message); }
+  concurrent::ScopedLock L(&dispatch_lock_);
+  if (!dispatch_table_.remove(processor, ids)) {
+    log_.error("tried to unregister ids 0x%x to 0x%x that were not registered", ids.first,
+               ids.last);
+    return;
   }
+  bus_->setFilters(dispatch_table_.getRanges());
 }
 
-void Can::registerProcessor(ICanProcessor *processor)
+Can::Statistics Can::getStatistics() const
 {
-  if (!processor) {
-    log_.error("tried to register a nullptr as a processor");
-    utils::System::getSystem().stop();
-    return;
-  }
-  processors_.push_back(std::move(processor));
+  Statistics statistics;
+  statistics.num_frames_received = num_frames_received_.load(std::memory_order_relaxed);
+  statistics.num_receive_calls   = num_receive_calls_.load(std::memory_order_relaxed);
+  statistics.num_frames_sent     = num_frames_sent_.load(std::memory_order_relaxed);
+  statistics.num_send_calls      = num_send_calls_.load(std::memory_order_relaxed);
+  return statistics;
 }
 
 }  // namespace io
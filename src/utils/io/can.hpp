@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <utils/concurrent/lock.hpp>
@@ -12,6 +16,8 @@ namespace hyped {
 namespace utils {
 namespace io {
 
+class ICanProcessor;
+
 namespace can {
 
 struct Frame {
@@ -22,6 +28,111 @@ struct Frame {
   uint8_t data[8];
 };
 
+/**
+ * @brief Contiguous set of CAN ids, `first` and `last` inclusive.
+ */
+struct IdRange {
+  static constexpr uint32_t kMaxStandardId = (1U << 11) - 1;
+  static constexpr uint32_t kMaxExtendedId = (1U << 29) - 1;
+
+  uint32_t first;
+  uint32_t last;
+  bool extended;
+
+  static constexpr IdRange exact(const uint32_t id, const bool extended)
+  {
+    return {id, id, extended};
+  }
+
+  constexpr bool isValid() const
+  {
+    return first <= last && last <= (extended ? kMaxExtendedId : kMaxStandardId);
+  }
+};
+
+/**
+ * @brief Acceptance filter in the format of the kernel's CAN_RAW_FILTER: a received frame passes
+ *        iff `(received_id & mask) == (id & mask)`, where ids include the extended flag.
+ */
+struct Filter {
+  static constexpr uint32_t kRemoteMask = 0x40000000U;
+  uint32_t id;
+  uint32_t mask;
+};
+
+/**
+ * @brief Splits `ids` into the fewest filters that accept exactly the data frames in the range,
+ *        each covering an aligned block of a power of two ids.
+ */
+std::vector<Filter> toFilters(const IdRange &ids);
+
+/**
+ * @brief Maps received frames to the processors that registered their ids, in constant time for
+ *        standard ids and logarithmic time in the number of registered ranges for extended ids.
+ *
+ *        Standard ids index a flat table of 2^11 entries; extended ids are looked up by binary
+ *        search in a sorted list of disjoint ranges. Each entry refers to a list of processors,
+ *        which are called in the order in which they were registered. Changing the registrations
+ *        rebuilds both tables and is meant to happen rarely, e.g. during start up.
+ */
+class DispatchTable {
+ public:
+  DispatchTable();
+
+  /**
+   * @return false iff `ids` is not a valid range, in which case nothing is registered
+   */
+  bool add(ICanProcessor *processor, const IdRange &ids);
+
+  /**
+   * @brief Removes a registration previously made by `add` with the same arguments.
+   *
+   * @return false iff there was no such registration
+   */
+  bool remove(ICanProcessor *processor, const IdRange &ids);
+
+  /**
+   * @brief Hands `frame` to every processor registered for its id.
+   *
+   * @return number of processors the frame was handed to
+   */
+  std::size_t dispatch(Frame &frame) const;
+
+  /**
+   * @brief Returns the fewest disjoint ranges that cover every registered id, in ascending order
+   *        with the standard ids first.
+   */
+  std::vector<IdRange> getRanges() const;
+
+ private:
+  using Processors = std::vector<ICanProcessor *>;
+
+  struct Registration {
+    ICanProcessor *processor;
+    IdRange ids;
+  };
+
+  struct ExtendedEntry {
+    uint32_t first;
+    uint32_t last;
+    uint16_t processors;
+  };
+
+  void rebuild();
+
+  /**
+   * @brief Returns the index of `processors` in processor_lists_, adding it if necessary.
+   */
+  uint16_t intern(const Processors &processors);
+
+  std::vector<Registration> registrations_;
+  // index 0 is the empty list so that unregistered ids need no special case
+  std::vector<Processors> processor_lists_;
+  std::array<uint16_t, IdRange::kMaxStandardId + 1> standard_;
+  // sorted by id and disjoint
+  std::vector<ExtendedEntry> extended_;
+};
+
 }  // namespace can
 
 class ICanProcessor {
@@ -33,31 +144,112 @@ class ICanProcessor {
    * @param message received CAN message to be processed
    */
   virtual void processNewData(can::Frame &message) = 0;
+};
+
+namespace can {
+
+/**
+ * @brief Transport that frames are sent to and received from, i.e. a socket on a network interface
+ *        or a node of an in-process VirtualBus.
+ */
+class IBus {
+ public:
+  virtual ~IBus() = default;
+
+  /**
+   * @return true iff frames can be sent and received
+   */
+  virtual bool isOpen() const = 0;
+
+  /**
+   * @brief Sends the frames in order in a single operation.
+   *
+   * @return number of frames sent, which is less than `num_frames` iff an error occurred
+   */
+  virtual std::size_t send(const Frame *frames, std::size_t num_frames) = 0;
 
   /**
-   * @brief To be called by CAN receive side to find owner of receinve can::Frame
+   * @brief Waits up to `timeout_micros` for a frame, then takes all frames that are already
+   *        available, up to `max_num_frames`.
    *
-   * @param id        - of the received can::Frame
-   * @param extended  - is the id extended?
-   * @return true     - iff this CanProcessor owns the corresponding message
+   * @return number of frames received
    */
-  virtual bool hasId(uint32_t id, bool extended) = 0;
+  virtual std::size_t receive(Frame *frames, std::size_t max_num_frames, uint32_t timeout_micros)
+    = 0;
+
+  /**
+   * @brief Tells the transport that frames with ids outside of `ranges` need not be received.
+   */
+  virtual void setFilters(const std::vector<IdRange> &ranges) = 0;
 };
 
 /**
- * Can implements singleton pattern to encapsulate one can interface, namely can0.
- * During object construction, can intereface is mapped onto socket_ member variable.
+ * @brief Raw CAN socket on a network interface. Sending and receiving take one system call each,
+ *        and filters are installed in the kernel so that irrelevant frames never reach the socket.
+ */
+class SocketBus : public IBus {
+ public:
+  static constexpr std::size_t kMaxNumKernelFilters = 512;
+
+  explicit SocketBus(const std::string &interface_name);
+  ~SocketBus();
+
+  NO_COPY_ASSIGN(SocketBus)
+
+  bool isOpen() const override { return socket_ >= 0; }
+  std::size_t send(const Frame *frames, std::size_t num_frames) override;
+  std::size_t receive(Frame *frames, std::size_t max_num_frames, uint32_t timeout_micros) override;
+  void setFilters(const std::vector<IdRange> &ranges) override;
+
+ private:
+  static constexpr std::size_t kMaxBatchSize = 64;
+
+  Logger log_;
+  int socket_;
+  uint32_t timeout_micros_;
+  concurrent::Lock socket_lock_;
+};
+
+}  // namespace can
+
+/**
+ * Can implements singleton pattern to encapsulate one can interface, namely can0, or a node of the
+ * in-process can::VirtualBus if the system is configured to use_virtual_can.
  * Furthermore, constructor spawns reading thread which waits on incoming can messages.
- * These messages are put into one of consuming queues based on configured id spaces.
- * The reading itself is performed in overriden run() method.
+ * These messages are handed to the processors that registered their ids, see can::DispatchTable.
+ * The reading itself is performed in overriden run() method, which drains up to kBatchSize frames
+ * per call into the bus. The bus is told which ids are registered so that it can drop all other
+ * frames early.
  */
 class Can : public concurrent::Thread {
  public:
-  static Can &getInstance()
-  {
-    static Can can;
-    return can;
-  }
+  static constexpr std::size_t kBatchSize         = 32;
+  static constexpr uint32_t kReceiveTimeoutMicros = 100000;
+
+  /**
+   * @brief Number of frames moved and calls into the bus made so far, to judge the effect of
+   *        batching. For a socket every call is one system call.
+   */
+  struct Statistics {
+    uint64_t num_frames_received;
+    uint64_t num_receive_calls;
+    uint64_t num_frames_sent;
+    uint64_t num_send_calls;
+  };
+
+  static Can &getInstance();
+
+  /**
+   * @brief Opens a socket on the given network interface. Apart from tests against virtual
+   *        interfaces such as vcan0, use getInstance.
+   */
+  explicit Can(const std::string &interface_name = "can0");
+
+  /**
+   * @brief Sends and receives through `bus`, e.g. a node of a can::VirtualBus.
+   */
+  explicit Can(std::unique_ptr<can::IBus> bus);
+  ~Can();
 
   NO_COPY_ASSIGN(Can)
 
@@ -68,22 +260,36 @@ class Can : public concurrent::Thread {
   int send(const can::Frame &frame);
 
   /**
-   * @brief Called by any Can-enabled device implementing CanProcessor interface
+   * @brief Sends the frames in order with one call into the bus per kBatchSize frames.
+   *
+   * @return number of frames sent, which is less than `num_frames` iff an error occurred
    */
-  void registerProcessor(ICanProcessor *processor);
+  std::size_t send(const can::Frame *frames, std::size_t num_frames);
+
+  /**
+   * @brief Called by any Can-enabled device implementing CanProcessor interface, once for every
+   *        id or range of ids it wants to receive.
+   */
+  void registerProcessor(ICanProcessor *processor, const can::IdRange &ids);
+
+  /**
+   * @brief Undoes a registerProcessor call with the same arguments.
+   */
+  void unregisterProcessor(ICanProcessor *processor, const can::IdRange &ids);
 
   /**
    * @brief To be called for starting the receive thread
    */
   void start();
 
- private:
   /**
-   * @param  frame output pointer to data to be filled
-   * @return 1     iff data received successfully
+   * @return true iff the bus was opened successfully
    */
-  int receive(can::Frame *frame);
+  bool isOpen() const { return bus_->isOpen(); }
 
+  Statistics getStatistics() const;
+
+ private:
   /**
    * @brief Process received message. Check whom does it belong to.
    * Send message to owner for processing.
@@ -97,14 +303,15 @@ class Can : public concurrent::Thread {
    */
   void run() override;
 
-  Can();
-  ~Can();
-
  private:
-  int socket_;
-  bool running_;
-  std::vector<ICanProcessor *> processors_;
-  concurrent::Lock socket_lock_;
+  std::unique_ptr<can::IBus> bus_;
+  std::atomic<bool> running_                 = false;
+  std::atomic<uint64_t> num_frames_received_ = 0;
+  std::atomic<uint64_t> num_receive_calls_   = 0;
+  std::atomic<uint64_t> num_frames_sent_     = 0;
+  std::atomic<uint64_t> num_send_calls_      = 0;
+  can::DispatchTable dispatch_table_;
+  concurrent::Lock dispatch_lock_;
 };
 
 }  // namespace io
@@ -100,6 +100,13 @@ void Gpio::initialise()
   initialised_ = true;
 }
 
+volatile uint32_t *Gpio::getBankMapping(const uint8_t bank)
+{
+  if (!initialised_) initialise();
+  if (!initialised_ || bank >= kBankNum) { return nullptr; }
+  return static_cast<volatile uint32_t *>(base_mapping_[bank]);
+}
+
 void Gpio::uninitialise()
 {
   kLog.error("uninitialising");
@@ -177,7 +184,7 @@ void Gpio::attach()
   const uint8_t pin_id = pin_ % 32;
   // corresponds to desired data of pin by indicating specific bit within byte of pin data
   pin_mask_ = 1 << pin_id;
-  log_.debug("gpio %u resolved as bank,pin %u, %u", pin_, bank, pin_id);
+  LOG_DEBUG(log_, "gpio %u resolved as bank,pin %u, %u", pin_, bank, pin_id);
 
   // hacking compilation compatibility for 64bit systems
 #ifdef ARCH_64
@@ -219,7 +226,7 @@ void Gpio::setupWait()
     log_.error("could not open /sys/.../value for gpio %d", pin_);
     return;
   } else {
-    log_.debug("gpio %d setup for waiting", pin_);
+    LOG_DEBUG(log_, "gpio %d setup for waiting", pin_);
   }
   fd_ = fd;
 }
@@ -232,7 +239,7 @@ int8_t Gpio::wait()
   int rc       = poll(&fdset, 1, -1);
   if (rc > 0) {
     if (fdset.revents & POLLPRI) {
-      log_.debug("success Wait on gpio %d", pin_);
+      LOG_DEBUG(log_, "success Wait on gpio %d", pin_);
       readHelper(fd_);
       return read();  // assume register access is faster than parsing data from value file
     }
@@ -262,7 +269,7 @@ void Gpio::set()
   write(fd_, "1", 2);
 #else
   *set_               = pin_mask_;
-  log_.debug("gpio %d set", pin_);
+  LOG_DEBUG(log_, "gpio %d set", pin_);
 #endif
 }
 
@@ -281,7 +288,7 @@ void Gpio::clear()
   write(fd_, "0", 2);
 #else
   *clear_ = pin_mask_;
-  log_.debug("gpio %d cleared", pin_);
+  LOG_DEBUG(log_, "gpio %d cleared", pin_);
 #endif
 }
 
@@ -302,7 +309,7 @@ uint8_t Gpio::read()
 #else
   // compares data and pin mask whether data is zero or one
   uint8_t val = *data_ & pin_mask_ ? 1 : 0;
-  log_.debug("gpio %d read %d", pin_, val);
+  LOG_DEBUG(log_, "gpio %d read %d", pin_, val);
   return val;
 #endif
 }
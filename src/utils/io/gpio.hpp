@@ -12,6 +12,10 @@ namespace hyped::utils::io {
 class Gpio {
  public:
   static constexpr uint8_t kBankNum = 4;
+  // offsets of the data in, clear data out and set data out registers within a bank
+  static constexpr uint32_t kData  = 0x138;
+  static constexpr uint32_t kClear = 0x190;
+  static constexpr uint32_t kSet   = 0x194;
   enum class Direction { kIn = 0, kOut = 1 };
   /**
    * @brief to be called on when logger is not initialized
@@ -34,6 +38,16 @@ class Gpio {
   void clear();    // set low
   uint8_t read();  // read pin value
 
+  uint32_t getPin() const { return pin_; }
+  Direction getDirection() const { return direction_; }
+
+  /**
+   * @brief Returns the memory-mapped registers of a bank, mapping all banks on first use.
+   *
+   * @return nullptr if /dev/mem could not be mapped or the bank does not exist
+   */
+  static volatile uint32_t *getBankMapping(const uint8_t bank);
+
   /**
    * @brief Block caller until value of gpio pin has changed
    * @return int8_t the new gpio value, -1 in case of an error
@@ -44,9 +58,6 @@ class Gpio {
   static constexpr std::array<off_t, kBankNum> kBases
     = {0x44e07000, 0x4804c000, 0x481ac000, 0x481ae000};
   static constexpr uint32_t kMmapSize = 0x1000;
-  static constexpr uint32_t kData     = 0x138;
-  static constexpr uint32_t kClear    = 0x190;
-  static constexpr uint32_t kSet      = 0x194;
   Gpio()                              = delete;
 
   // GPIO system configuration
@@ -0,0 +1,74 @@
+#include "gpio_bank.hpp"
+
+namespace hyped::utils::io {
+
+MappedGpioRegisters::MappedGpioRegisters()
+{
+  for (uint8_t bank = 0; bank < Gpio::kBankNum; ++bank) {
+    banks_[bank] = Gpio::getBankMapping(bank);
+  }
+}
+
+bool MappedGpioRegisters::isMapped(const uint8_t bank) const
+{
+  return bank < Gpio::kBankNum && banks_[bank] != nullptr;
+}
+
+uint32_t MappedGpioRegisters::read(const uint8_t bank, const uint32_t offset) const
+{
+  return banks_[bank][offset / sizeof(uint32_t)];
+}
+
+void MappedGpioRegisters::write(const uint8_t bank, const uint32_t offset, const uint32_t value)
+{
+  banks_[bank][offset / sizeof(uint32_t)] = value;
+}
+
+GpioBank::GpioBank(const uint8_t bank, std::shared_ptr<IGpioRegisters> registers)
+    : bank_(bank),
+      registers_(registers ? std::move(registers) : std::make_shared<MappedGpioRegisters>())
+{
+}
+
+std::optional<uint32_t> GpioBank::getMask(const std::vector<uint32_t> &pins) const
+{
+  uint32_t mask = 0;
+  for (const uint32_t pin : pins) {
+    if (getBank(pin) != bank_) { return std::nullopt; }
+    mask |= getMask(pin);
+  }
+  return mask;
+}
+
+bool GpioBank::isMapped() const
+{
+  return registers_->isMapped(bank_);
+}
+
+void GpioBank::set(const uint32_t mask)
+{
+  if (!isMapped()) { return; }
+  registers_->write(bank_, Gpio::kSet, mask);
+}
+
+void GpioBank::clear(const uint32_t mask)
+{
+  if (!isMapped()) { return; }
+  registers_->write(bank_, Gpio::kClear, mask);
+}
+
+void GpioBank::write(const uint32_t mask, const uint32_t values)
+{
+  const uint32_t high = mask & values;
+  const uint32_t low  = mask & ~values;
+  if (high != 0) { set(high); }
+  if (low != 0) { clear(low); }
+}
+
+uint32_t GpioBank::read() const
+{
+  if (!isMapped()) { return 0; }
+  return registers_->read(bank_, Gpio::kData);
+}
+
+}  // namespace hyped::utils::io
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "gpio.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace hyped::utils::io {
+
+/**
+ * @brief Access to the 32 bit registers of the GPIO banks. Offsets are those of Gpio, e.g.
+ *        Gpio::kSet.
+ */
+class IGpioRegisters {
+ public:
+  virtual ~IGpioRegisters() {}
+  virtual bool isMapped(const uint8_t bank) const                                     = 0;
+  virtual uint32_t read(const uint8_t bank, const uint32_t offset) const              = 0;
+  virtual void write(const uint8_t bank, const uint32_t offset, const uint32_t value) = 0;
+};
+
+/**
+ * @brief The registers of the BBB's GPIO banks as mapped from /dev/mem by Gpio.
+ */
+class MappedGpioRegisters : public IGpioRegisters {
+ public:
+  MappedGpioRegisters();
+  bool isMapped(const uint8_t bank) const override;
+  uint32_t read(const uint8_t bank, const uint32_t offset) const override;
+  void write(const uint8_t bank, const uint32_t offset, const uint32_t value) override;
+
+ private:
+  std::array<volatile uint32_t *, Gpio::kBankNum> banks_;
+};
+
+/**
+ * @brief Drives or reads any set of pins of one GPIO bank with a single register access, e.g. to
+ *        switch several outputs at the same instant or to sample every input of a bank at once.
+ *        Pins are addressed by masks with bit i standing for pin 32 * bank + i.
+ *
+ *        The bank does not export pins or set their direction; that is still done by creating a
+ *        Gpio for every pin involved.
+ */
+class GpioBank {
+ public:
+  static constexpr uint32_t kPinsPerBank = 32;
+
+  /**
+   * @param bank index of the bank, see Gpio::kBankNum
+   * @param registers backend, defaults to the memory-mapped registers; tests inject a fake
+   */
+  explicit GpioBank(const uint8_t bank, std::shared_ptr<IGpioRegisters> registers = nullptr);
+
+  static uint8_t getBank(const uint32_t pin) { return static_cast<uint8_t>(pin / kPinsPerBank); }
+  static uint32_t getMask(const uint32_t pin) { return 1u << (pin % kPinsPerBank); }
+
+  /**
+   * @return mask of `pins`, or nullopt if any of them is not part of this bank
+   */
+  std::optional<uint32_t> getMask(const std::vector<uint32_t> &pins) const;
+
+  uint8_t getIndex() const { return bank_; }
+  bool isMapped() const;
+
+  /**
+   * @brief Drives every pin in `mask` high with one write; other pins are unaffected.
+   */
+  void set(const uint32_t mask);
+
+  /**
+   * @brief Drives every pin in `mask` low with one write; other pins are unaffected.
+   */
+  void clear(const uint32_t mask);
+
+  /**
+   * @brief Drives the pins in `mask` to the corresponding bits of `values`. Takes one write for
+   *        the pins going high followed by one for those going low.
+   */
+  void write(const uint32_t mask, const uint32_t values);
+
+  /**
+   * @return levels of all pins of the bank, read with one access
+   */
+  uint32_t read() const;
+
+ private:
+  const uint8_t bank_;
+  std::shared_ptr<IGpioRegisters> registers_;
+};
+
+}  // namespace hyped::utils::io
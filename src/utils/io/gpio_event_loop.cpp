@@ -0,0 +1,231 @@
+#include "gpio_event_loop.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <utils/system.hpp>
+
+namespace hyped::utils::io {
+
+namespace gpio {
+namespace {
+
+std::string joinPath(const std::string &root, const std::string &relative)
+{
+  if (!root.empty() && root.back() == '/') { return root + relative; }
+  return root + "/" + relative;
+}
+
+uint64_t getMonotonicNanos()
+{
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<uint64_t>(now.tv_sec) * 1000000000 + static_cast<uint64_t>(now.tv_nsec);
+}
+
+}  // namespace
+}  // namespace gpio
+
+GpioEventLoop::GpioEventLoop(const std::string &root)
+    : log_("GPIO-EVENTS", utils::System::getSystem().config_.log_level),
+      root_(root),
+      epoll_fd_(epoll_create1(EPOLL_CLOEXEC))
+{
+  if (epoll_fd_ < 0) { log_.error("could not create epoll set: %s", strerror(errno)); }
+}
+
+GpioEventLoop::~GpioEventLoop()
+{
+  for (const auto &source : sources_) {
+    close(source->fd);
+  }
+  if (epoll_fd_ >= 0) { close(epoll_fd_); }
+}
+
+bool GpioEventLoop::isOpen() const
+{
+  return epoll_fd_ >= 0;
+}
+
+std::size_t GpioEventLoop::getNumSources() const
+{
+  return sources_.size();
+}
+
+bool GpioEventLoop::addPin(const uint32_t pin, Callback callback)
+{
+  const std::string directory = gpio::joinPath(root_, "sys/class/gpio/gpio" + std::to_string(pin));
+  const std::string edge_path = directory + "/edge";
+  const int edge_fd           = open(edge_path.c_str(), O_WRONLY | O_TRUNC);
+  if (edge_fd < 0) {
+    log_.error("could not open %s, is gpio %u exported as an input?", edge_path.c_str(), pin);
+    return false;
+  }
+  const bool is_edge_set = write(edge_fd, "both", 4) == 4;
+  close(edge_fd);
+  if (!is_edge_set) {
+    log_.error("could not enable edges of gpio %u", pin);
+    return false;
+  }
+
+  const std::string value_path = directory + "/value";
+  const int fd                 = open(value_path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0) {
+    log_.error("could not open %s", value_path.c_str());
+    return false;
+  }
+  // sysfs reports a pending change until the value has been read, so the initial state is
+  // consumed here rather than dispatched as an edge
+  char buffer[4];
+  pread(fd, buffer, sizeof(buffer), 0);
+  return add(fd, Kind::kSysfs, pin, std::move(callback));
+}
+
+bool GpioEventLoop::addGpio(const Gpio &gpio, Callback callback)
+{
+  if (gpio.getDirection() != Gpio::Direction::kIn) {
+    log_.error("gpio %u is not an input", gpio.getPin());
+    return false;
+  }
+  return addPin(gpio.getPin(), std::move(callback));
+}
+
+bool GpioEventLoop::addLine(const uint32_t chip, const uint32_t line, Callback callback)
+{
+  const std::string chip_path = gpio::joinPath(root_, "dev/gpiochip" + std::to_string(chip));
+  const int chip_fd           = open(chip_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (chip_fd < 0) {
+    log_.error("could not open %s", chip_path.c_str());
+    return false;
+  }
+  gpioevent_request request = {};
+  request.lineoffset        = line;
+  request.handleflags       = GPIOHANDLE_REQUEST_INPUT;
+  request.eventflags        = GPIOEVENT_REQUEST_BOTH_EDGES;
+  std::strncpy(request.consumer_label, "hyped", sizeof(request.consumer_label) - 1);
+  const int result = ioctl(chip_fd, GPIO_GET_LINEEVENT_IOCTL, &request);
+  close(chip_fd);
+  if (result < 0 || request.fd < 0) {
+    log_.error("could not request events of line %u of %s: %s", line, chip_path.c_str(),
+               strerror(errno));
+    return false;
+  }
+  return addLineEventFd(request.fd, chip, line, std::move(callback));
+}
+
+bool GpioEventLoop::addLineEventFd(const int fd, const uint32_t chip, const uint32_t line,
+                                   Callback callback)
+{
+  if (line >= kLinesPerChip) {
+    log_.error("line %u of chip %u does not exist", line, chip);
+    close(fd);
+    return false;
+  }
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  return add(fd, Kind::kLineEvents, chip * kLinesPerChip + line, std::move(callback));
+}
+
+bool GpioEventLoop::addValueStreamFd(const int fd, const uint32_t pin, Callback callback)
+{
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  return add(fd, Kind::kValueStream, pin, std::move(callback));
+}
+
+bool GpioEventLoop::add(const int fd, const Kind kind, const uint32_t pin, Callback callback)
+{
+  const auto is_pin
+    = [pin](const std::unique_ptr<Source> &source) { return source->pin == pin; };
+  if (epoll_fd_ < 0 || std::any_of(sources_.begin(), sources_.end(), is_pin)) {
+    log_.error("could not watch gpio %u, it is already watched or there is no epoll set", pin);
+    close(fd);
+    return false;
+  }
+  auto source       = std::make_unique<Source>(Source{fd, kind, pin, std::move(callback)});
+  epoll_event event = {};
+  // sysfs signals a change with an exceptional condition, everything else by becoming readable
+  event.events   = kind == Kind::kSysfs ? EPOLLPRI | EPOLLERR : EPOLLIN;
+  event.data.ptr = source.get();
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+    log_.error("could not add gpio %u to the epoll set: %s", pin, strerror(errno));
+    close(fd);
+    return false;
+  }
+  sources_.push_back(std::move(source));
+  return true;
+}
+
+bool GpioEventLoop::remove(const uint32_t pin)
+{
+  const auto it = std::find_if(
+    sources_.begin(), sources_.end(),
+    [pin](const std::unique_ptr<Source> &source) { return source->pin == pin; });
+  if (it == sources_.end()) { return false; }
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, (*it)->fd, nullptr);
+  close((*it)->fd);
+  sources_.erase(it);
+  return true;
+}
+
+int GpioEventLoop::poll(const int timeout_millis)
+{
+  if (epoll_fd_ < 0) { return -1; }
+  std::array<epoll_event, kMaxEventsPerWait> ready;
+  const int num_ready = epoll_wait(epoll_fd_, ready.data(), ready.size(), timeout_millis);
+  if (num_ready < 0) {
+    if (errno == EINTR) { return 0; }
+    log_.error("could not wait for gpio events: %s", strerror(errno));
+    return -1;
+  }
+  const uint64_t wake_up_nanos = gpio::getMonotonicNanos();
+  int num_dispatched           = 0;
+  for (int i = 0; i < num_ready; ++i) {
+    num_dispatched += dispatch(*static_cast<Source *>(ready[i].data.ptr), wake_up_nanos);
+  }
+  return num_dispatched;
+}
+
+int GpioEventLoop::dispatch(Source &source, const uint64_t wake_up_nanos)
+{
+  Event event;
+  event.pin = source.pin;
+  if (source.kind == Kind::kLineEvents) {
+    std::array<gpioevent_data, kMaxEventsPerRead> line_events;
+    const ssize_t num_read = read(source.fd, line_events.data(), sizeof(line_events));
+    if (num_read <= 0) { return 0; }
+    const std::size_t num_events = static_cast<std::size_t>(num_read) / sizeof(gpioevent_data);
+    for (std::size_t i = 0; i < num_events; ++i) {
+      event.value           = line_events[i].id == GPIOEVENT_EVENT_RISING_EDGE ? 1 : 0;
+      event.timestamp_nanos = line_events[i].timestamp;
+      source.callback(event);
+    }
+    return static_cast<int>(num_events);
+  }
+
+  char buffer[64];
+  const ssize_t num_read = source.kind == Kind::kSysfs
+                             ? pread(source.fd, buffer, sizeof(buffer), 0)
+                             : read(source.fd, buffer, sizeof(buffer));
+  if (num_read <= 0) { return 0; }
+  event.timestamp_nanos = wake_up_nanos;
+  int num_events        = 0;
+  for (ssize_t i = 0; i < num_read; ++i) {
+    if (buffer[i] != '0' && buffer[i] != '1') { continue; }
+    event.value = buffer[i] == '1' ? 1 : 0;
+    source.callback(event);
+    ++num_events;
+    // a sysfs value file holds the current value only
+    if (source.kind == Kind::kSysfs) { break; }
+  }
+  return num_events;
+}
+
+}  // namespace hyped::utils::io
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "gpio.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <utils/logger.hpp>
+#include <utils/utils.hpp>
+
+namespace hyped::utils::io {
+
+namespace gpio {
+// file system root under which sysfs and the GPIO character devices are found
+static constexpr char kDefaultRoot[] = "/";
+}  // namespace gpio
+
+/**
+ * @brief Waits for edges on any number of GPIO inputs with a single epoll set, so that one thread
+ *        can serve every input pin instead of one thread blocking in Gpio::wait per pin.
+ *
+ *        Pins can be watched through sysfs (`/sys/class/gpio/gpioN/value`, the pin must have been
+ *        exported as an input, e.g. by a Gpio) or through the GPIO character device
+ *        (`/dev/gpiochipN` line events). The latter is preferable where the kernel supports it:
+ *        the kernel timestamps every edge when it happens and queues edges, so several are
+ *        delivered with one read and none are lost between polls. Sysfs only reports that the
+ *        value changed, so such edges are stamped when the wait returns and quick successive
+ *        edges collapse into one.
+ *
+ *        Registration and polling must happen on the same thread; callbacks run on that thread
+ *        from within `poll` and must not add or remove pins themselves.
+ */
+class GpioEventLoop {
+ public:
+  struct Event {
+    uint32_t pin;  // numbered as for Gpio, i.e. 32 * chip + line
+    uint8_t value;
+    // CLOCK_MONOTONIC, or as reported by the kernel for character device lines
+    uint64_t timestamp_nanos;
+  };
+  using Callback = std::function<void(const Event &)>;
+
+  static constexpr uint32_t kLinesPerChip        = 32;
+  static constexpr std::size_t kMaxEventsPerWait = 16;
+  static constexpr std::size_t kMaxEventsPerRead = 16;
+
+  /**
+   * @param root file system root, tests point this at a mock directory tree
+   */
+  explicit GpioEventLoop(const std::string &root = gpio::kDefaultRoot);
+  ~GpioEventLoop();
+
+  NO_COPY_ASSIGN(GpioEventLoop)
+
+  bool isOpen() const;
+
+  /**
+   * @brief Watches both edges of an exported sysfs input pin.
+   */
+  bool addPin(const uint32_t pin, Callback callback);
+
+  /**
+   * @brief Watches both edges of the pin of an input Gpio through sysfs.
+   */
+  bool addGpio(const Gpio &gpio, Callback callback);
+
+  /**
+   * @brief Requests edge events for a line of `/dev/gpiochip<chip>` and watches them.
+   */
+  bool addLine(const uint32_t chip, const uint32_t line, Callback callback);
+
+  /**
+   * @brief Watches a line event file descriptor that has already been requested, taking ownership
+   *        of it. Anything that delivers `gpioevent_data` records, such as a pipe, will do.
+   */
+  bool addLineEventFd(const int fd, const uint32_t chip, const uint32_t line, Callback callback);
+
+  /**
+   * @brief Watches a file descriptor that delivers the value of `pin` as one '0' or '1' per edge,
+   *        such as a pipe fed by a simulation, taking ownership of it. Edges are stamped when the
+   *        wait returns, as for sysfs, but successive edges do not collapse.
+   */
+  bool addValueStreamFd(const int fd, const uint32_t pin, Callback callback);
+
+  /**
+   * @brief Stops watching a pin, regardless of how it was added.
+   */
+  bool remove(const uint32_t pin);
+
+  std::size_t getNumSources() const;
+
+  /**
+   * @brief Waits up to `timeout_millis` (-1 for no limit) for edges on any watched pin and
+   *        dispatches them to their callbacks.
+   *
+   * @return number of events dispatched, -1 on error
+   */
+  int poll(const int timeout_millis);
+
+ private:
+  enum class Kind { kSysfs, kValueStream, kLineEvents };
+
+  struct Source {
+    int fd;
+    Kind kind;
+    uint32_t pin;
+    Callback callback;
+  };
+
+  bool add(const int fd, const Kind kind, const uint32_t pin, Callback callback);
+
+  /**
+   * @brief Reads what is pending on a source and dispatches it.
+   *
+   * @return number of events dispatched
+   */
+  int dispatch(Source &source, const uint64_t wake_up_nanos);
+
+  Logger log_;
+  std::string root_;
+  int epoll_fd_;
+  std::vector<std::unique_ptr<Source>> sources_;
+};
+
+}  // namespace hyped::utils::io
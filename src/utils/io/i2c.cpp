@@ -5,8 +5,13 @@
 
 #include <sys/ioctl.h>
 
+#include <array>
+#include <cstdio>
+#include <cstring>
+
 #if LINUX
 #include <linux/i2c-dev.h>
+#include <linux/i2c.h>
 #else
 #define I2C_SLAVE 0x0703
 #endif
@@ -16,46 +21,93 @@
 
 namespace hyped::utils::io {
 
-I2c::I2c(const uint8_t bus_address)
-    : log_(utils::Logger("I2C", utils::System::getSystem().config_.log_level)),
-      sensor_address_(0)
+namespace i2c {
+
+DeviceBus::DeviceBus(const uint8_t bus_number)
 {
   char path[13];  // up to "/dev/i2c-255"
-  sprintf(path, "/dev/i2c-%d", bus_address);
+  snprintf(path, sizeof(path), "/dev/i2c-%d", bus_number);
   fd_ = open(path, O_RDWR, 0);
-  if (fd_ < 0) { log_.error("Could not open i2c device"); };
 }
 
-I2c::~I2c()
+DeviceBus::~DeviceBus()
 {
-  close(fd_);
+  if (fd_ >= 0) { close(fd_); }
 }
 
-void I2c::setSensorAddress(const uint32_t address)
+bool DeviceBus::setAddress(const uint16_t address)
 {
-  if (fd_ < 0) {
-    log_.error("Could not find i2c device");
-    return;
+  return ioctl(fd_, I2C_SLAVE, address) >= 0;
+}
+
+int DeviceBus::read(uint8_t *data, const std::size_t len)
+{
+  return ::read(fd_, data, len);
+}
+
+int DeviceBus::write(const uint8_t *data, const std::size_t len)
+{
+  return ::write(fd_, data, len);
+}
+
+bool DeviceBus::transfer(Message *messages, const std::size_t num_messages)
+{
+#if LINUX
+  std::array<i2c_msg, I2c::kMaxMessages> raw_messages;
+  for (std::size_t i = 0; i < num_messages; ++i) {
+    raw_messages[i].addr  = messages[i].address;
+    raw_messages[i].flags = messages[i].is_read ? I2C_M_RD : 0;
+    raw_messages[i].buf   = messages[i].data;
+    raw_messages[i].len   = messages[i].len;
   }
+  i2c_rdwr_ioctl_data transaction;
+  transaction.msgs  = raw_messages.data();
+  transaction.nmsgs = static_cast<uint32_t>(num_messages);
+  // returns the number of messages transferred
+  return ioctl(fd_, I2C_RDWR, &transaction) == static_cast<int>(num_messages);
+#else
+  (void)messages;
+  (void)num_messages;
+  return false;
+#endif
+}
 
-  sensor_address_ = address;
-  const int ret   = ioctl(fd_, I2C_SLAVE, address);
-  if (ret < 0) {
+}  // namespace i2c
+
+I2c::I2c(const uint8_t bus_address) : I2c(std::make_unique<i2c::DeviceBus>(bus_address))
+{
+}
+
+I2c::I2c(std::unique_ptr<i2c::IBus> bus)
+    : log_(utils::Logger("I2C", utils::System::getSystem().config_.log_level)),
+      bus_(std::move(bus)),
+      sensor_address_(kNoAddress)
+{
+  if (!bus_->isOpen()) { log_.error("Could not open i2c device"); };
+}
+
+bool I2c::setSensorAddress(const uint32_t address)
+{
+  if (sensor_address_ == address) { return true; }
+  if (!bus_->setAddress(static_cast<uint16_t>(address))) {
     log_.error("Could not set sensor address");
-    return;
+    // the kernel may have rejected the address without deselecting the previous one
+    sensor_address_ = kNoAddress;
+    return false;
   }
+  sensor_address_ = address;
+  return true;
 }
 
 int I2c::readData(const uint32_t address, uint8_t *data, const size_t len)
 {
-  if (fd_ < 0) {
+  if (!bus_->isOpen()) {
     log_.error("Could not find i2c device");
     return -1;
   }
+  if (!setSensorAddress(address)) { return -1; }
 
-  if (sensor_address_ != address) { setSensorAddress(address); }
-
-  const auto ret = read(fd_, data, len);
+  const auto ret = bus_->read(data, len);
   if (ret != static_cast<int>(len)) {
     log_.error("Could not read from i2c device");
     return -1;
@@ -65,17 +117,62 @@ int I2c::readData(const uint32_t address, uint8_t *data, const size_t len)
 
 int I2c::writeData(const uint32_t address, uint8_t *data, const size_t len)
 {
-  if (fd_ < 0) {
+  if (!bus_->isOpen()) {
     log_.error("Could not find i2c device");
     return -1;
   }
-  if (sensor_address_ != address) { setSensorAddress(address); }
+  if (!setSensorAddress(address)) { return -1; }
 
-  const auto ret = write(fd_, data, len);
+  const auto ret = bus_->write(data, len);
   if (ret != static_cast<int>(len)) {
     log_.error("Could not write to i2c device");
     return -1;
   }
   return ret;
 }
-}  // namespace hyped::utils::io
\ No newline at end of file
+
+bool I2c::readRegisters(const uint16_t address, const uint8_t reg, uint8_t *data,
+                        const std::size_t len)
+{
+  if (len == 0 || len > UINT16_MAX) {
+    log_.error("Cannot read %zu registers in one transaction", len);
+    return false;
+  }
+  uint8_t register_address = reg;
+  std::array<i2c::Message, 2> messages;
+  messages[0] = {address, false, &register_address, 1};
+  messages[1] = {address, true, data, static_cast<uint16_t>(len)};
+  return transfer(messages.data(), messages.size());
+}
+
+bool I2c::writeRegisters(const uint16_t address, const uint8_t reg, const uint8_t *data,
+                         const std::size_t len)
+{
+  if (len == 0 || len > kMaxWriteLength) {
+    log_.error("Cannot write %zu registers in one message", len);
+    return false;
+  }
+  std::array<uint8_t, kMaxWriteLength + 1> buffer;
+  buffer[0] = reg;
+  std::memcpy(&buffer[1], data, len);
+  i2c::Message message = {address, false, buffer.data(), static_cast<uint16_t>(len + 1)};
+  return transfer(&message, 1);
+}
+
+bool I2c::transfer(i2c::Message *messages, const std::size_t num_messages)
+{
+  if (!bus_->isOpen()) {
+    log_.error("Could not find i2c device");
+    return false;
+  }
+  if (num_messages == 0 || num_messages > kMaxMessages) {
+    log_.error("Cannot transfer %zu messages in one transaction", num_messages);
+    return false;
+  }
+  if (!bus_->transfer(messages, num_messages)) {
+    log_.error("Could not transfer to i2c device 0x%x", messages[0].address);
+    return false;
+  }
+  return true;
+}
+}  // namespace hyped::utils::io
@@ -1,22 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
 #include <utils/logger.hpp>
+#include <utils/utils.hpp>
 
 namespace hyped::utils::io {
 
+namespace i2c {
+
+/**
+ * @brief One message of a combined transaction. Messages after the first are preceded by a
+ *        repeated start instead of a stop, so no other master can access the device in between.
+ */
+struct Message {
+  uint16_t address;
+  bool is_read;
+  uint8_t *data;
+  uint16_t len;
+};
+
+/**
+ * @brief Adapter that I2c talks to, i.e. a /dev/i2c-N character device or a fake in tests.
+ */
+class IBus {
+ public:
+  virtual ~IBus() = default;
+
+  /**
+   * @return true iff the bus can be accessed
+   */
+  virtual bool isOpen() const = 0;
+
+  /**
+   * @brief Selects the device that subsequent `read` and `write` calls address.
+   */
+  virtual bool setAddress(uint16_t address) = 0;
+
+  /**
+   * @return number of bytes read from the selected device, -1 on error
+   */
+  virtual int read(uint8_t *data, std::size_t len) = 0;
+
+  /**
+   * @return number of bytes written to the selected device, -1 on error
+   */
+  virtual int write(const uint8_t *data, std::size_t len) = 0;
+
+  /**
+   * @brief Performs the messages as one combined transaction in a single operation. Messages
+   *        carry their own addresses and do not change the selected device.
+   *
+   * @return true iff every message was acknowledged and transferred in full
+   */
+  virtual bool transfer(Message *messages, std::size_t num_messages) = 0;
+};
+
+/**
+ * @brief A bus of the SoC through its i2c-dev character device. Every method is one system call;
+ *        `transfer` uses I2C_RDWR.
+ */
+class DeviceBus : public IBus {
+ public:
+  explicit DeviceBus(const uint8_t bus_number);
+  ~DeviceBus();
+
+  NO_COPY_ASSIGN(DeviceBus)
+
+  bool isOpen() const override { return fd_ >= 0; }
+  bool setAddress(uint16_t address) override;
+  int read(uint8_t *data, std::size_t len) override;
+  int write(const uint8_t *data, std::size_t len) override;
+  bool transfer(Message *messages, std::size_t num_messages) override;
+
+ private:
+  int fd_;
+};
+
+}  // namespace i2c
+
 class I2c {
  public:
+  // most messages the kernel accepts in one I2C_RDWR transaction
+  static constexpr std::size_t kMaxMessages = 42;
+  // most register bytes written by one writeRegisters call
+  static constexpr std::size_t kMaxWriteLength = 64;
+
   I2c(const uint8_t bus_address);
-  ~I2c();
+  explicit I2c(std::unique_ptr<i2c::IBus> bus);
+
+  NO_COPY_ASSIGN(I2c)
 
   int readData(const uint32_t address, uint8_t *data, const size_t len);
   int writeData(const uint32_t address, uint8_t *data, const size_t len);
 
- private:
-  void setSensorAddress(uint32_t address);
+  /**
+   * @brief Reads `len` consecutive registers starting at `reg` in a single transaction: the
+   *        register address is written and the data read back after a repeated start. Relies on
+   *        the device incrementing its register pointer, as multi-register sensors do.
+   *
+   * @return true iff all registers were read
+   */
+  bool readRegisters(const uint16_t address, const uint8_t reg, uint8_t *data,
+                     const std::size_t len);
+
+  /**
+   * @brief Writes `len` consecutive registers starting at `reg` in a single message.
+   *
+   * @return true iff all registers were written
+   */
+  bool writeRegisters(const uint16_t address, const uint8_t reg, const uint8_t *data,
+                      const std::size_t len);
+
+  /**
+   * @brief Performs up to kMaxMessages messages as one combined transaction.
+   */
+  bool transfer(i2c::Message *messages, const std::size_t num_messages);
 
  private:
+  /**
+   * @brief Selects the device for readData/writeData, skipping the ioctl if it already is.
+   */
+  bool setSensorAddress(uint32_t address);
+
+  // no device is selected before the first readData/writeData
+  static constexpr uint32_t kNoAddress = UINT32_MAX;
+
   utils::Logger log_;
-  int fd_;
+  std::unique_ptr<i2c::IBus> bus_;
   uint32_t sensor_address_;
 };
 
-}  // namespace hyped::utils::io
\ No newline at end of file
+}  // namespace hyped::utils::io
@@ -9,6 +9,9 @@
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 
+#include <array>
+#include <utility>
+
 #if LINUX
 #include <linux/spi/spidev.h>
 #else
@@ -60,6 +63,15 @@ namespace io {
 constexpr uint32_t kSPIAddrBase = 0x481A0000;  // 0x48030000 for SPI0
 constexpr uint32_t kMmapSize    = 0x1000;
 
+// SPI_IOC_MESSAGE(N) encodes the size of N segments in the request and needs a constant N
+template<std::size_t... kIndices>
+constexpr std::array<unsigned long, sizeof...(kIndices)> messageRequests(
+  std::index_sequence<kIndices...>)
+{
+  return {SPI_IOC_MESSAGE(kIndices + 1)...};
+}
+constexpr auto kMessageRequests = messageRequests(std::make_index_sequence<Spi::kMaxSegments>());
+
 // define what the address space of SPI looks like
 #pragma pack(1)
 struct SPI_CH {   // offset
@@ -198,19 +210,14 @@ void Spi::transfer(uint8_t *tx, uint8_t *, uint16_t len)
   for (uint16_t x = 0; x < len; x++) {
     // log_.INFO("SPI_TEST","channel 0 status before: %d", 10);
     // while(!(ch0->status & 0x2));
-    log_.info("Status register: %x", ch_->stat);
     ch_->ctrl = ch_->ctrl | 0x1;
     ch_->conf = ch_->conf & 0xfffcffff;
     ch_->tx   = tx[x];
-    log_.info("Status register: %x", ch_->stat);
-    log_.info("Config register: %x", ch_->conf);
-    log_.info("Control register: %x", ch_->ctrl);
 
     while (!(ch_->stat & 0x1)) {
       utils::concurrent::Thread::sleep(1000);
-      log_.info("Status register: %d", ch_->stat);
     }
-    log_.info("Status register: %d", ch_->stat);
+    LOG_DEBUG(log_, "status: %x, config: %x, control: %x", ch_->stat, ch_->conf, ch_->ctrl);
     // log_.INFO("SPI_TEST","Read buffer: %d", ch0->rx_buf);
     // log_.INFO("SPI_TEST","channel 0 status after: %d", 10);
     // write_buffer++;
@@ -222,42 +229,56 @@ void Spi::transfer(uint8_t *tx, uint8_t *, uint16_t len)
 void Spi::read(uint8_t addr, uint8_t *rx, uint16_t len)
 {
   if (spi_fd_ < 0) return;  // early exit if no spi device present
-
-  spi_ioc_transfer message[2] = {};
-
-  // send address
-  message[0].tx_buf = reinterpret_cast<uint64_t>(&addr);
-  message[0].rx_buf = 0;
-  message[0].len    = 1;
-
-  // receive data
-  message[1].tx_buf = 0;
-  message[1].rx_buf = reinterpret_cast<uint64_t>(rx);
-  message[1].len    = len;
-
-  if (ioctl(spi_fd_, SPI_IOC_MESSAGE(2), message) < 0) {
-    log_.error("could not submit 2 TRANSFER messages");
-  }
+  // send address, then receive data
+  const Segment segments[2] = {{&addr, nullptr, 1, false}, {nullptr, rx, len, false}};
+  if (!transferBatch(segments, 2)) { log_.error("could not submit 2 TRANSFER messages"); }
 }
 
 void Spi::write(uint8_t addr, uint8_t *tx, uint16_t len)
 {
   if (spi_fd_ < 0) return;  // early exit if no spi device present
+  // send address, then write data
+  const Segment segments[2] = {{&addr, nullptr, 1, false}, {tx, nullptr, len, false}};
+  if (!transferBatch(segments, 2)) { log_.error("could not submit 2 TRANSFER messages"); }
+}
 
-  spi_ioc_transfer message[2] = {};
-  // send address
-  message[0].tx_buf = reinterpret_cast<uint64_t>(&addr);
-  message[0].rx_buf = 0;
-  message[0].len    = 1;
-
-  // write data
-  message[1].tx_buf = reinterpret_cast<uint64_t>(tx);
-  message[1].rx_buf = 0;
-  message[1].len    = len;
+bool Spi::transferBatch(const Segment *segments, const std::size_t num_segments)
+{
+  if (spi_fd_ < 0) return false;  // early exit if no spi device present
+  if (num_segments == 0) return true;
+  if (num_segments > kMaxSegments) {
+    log_.error("tried to transfer %zu segments, at most %zu are allowed", num_segments,
+               kMaxSegments);
+    return false;
+  }
+  // spidev reads cs_change on the last transfer as "keep the chip selected after the message"
+  if (segments[num_segments - 1].deselect_after) {
+    log_.error("tried to deselect after the last segment, which would keep the chip selected");
+    return false;
+  }
 
-  if (ioctl(spi_fd_, SPI_IOC_MESSAGE(2), message) < 0) {
-    log_.error("could not submit 2 TRANSFER messages");
+  spi_ioc_transfer messages[kMaxSegments] = {};
+  uint64_t num_bytes                      = 0;
+  for (std::size_t i = 0; i < num_segments; ++i) {
+    messages[i].tx_buf    = reinterpret_cast<uint64_t>(segments[i].tx);
+    messages[i].rx_buf    = reinterpret_cast<uint64_t>(segments[i].rx);
+    messages[i].len       = segments[i].len;
+    messages[i].cs_change = segments[i].deselect_after;
+    num_bytes += segments[i].len;
   }
+
+  num_transfers_.fetch_add(1, std::memory_order_relaxed);
+  if (ioctl(spi_fd_, kMessageRequests[num_segments - 1], messages) < 0) { return false; }
+  num_bytes_.fetch_add(num_bytes, std::memory_order_relaxed);
+  return true;
+}
+
+Spi::Statistics Spi::getStatistics() const
+{
+  Statistics statistics;
+  statistics.num_transfers = num_transfers_.load(std::memory_order_relaxed);
+  statistics.num_bytes     = num_bytes_.load(std::memory_order_relaxed);
+  return statistics;
 }
 
 Spi::~Spi()
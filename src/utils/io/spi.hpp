@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
 #include <utils/logger.hpp>
 #include <utils/utils.hpp>
 
@@ -17,6 +21,29 @@ class Spi {
 
   enum class Clock { k1MHz, k4MHz, k16MHz, k20MHz };
 
+  /**
+   * @brief One part of a transferBatch. Bytes are written from `tx` and read into `rx` at the same
+   *        time; either may be nullptr to only read or only write.
+   */
+  struct Segment {
+    const uint8_t *tx;
+    uint8_t *rx;
+    uint16_t len;
+    // toggle the hardware chip select between this and the next segment; must be false for the
+    // last segment of a batch, as the chip is always deselected after it
+    bool deselect_after;
+  };
+
+  /**
+   * @brief Number of transfers and bytes moved through spidev so far.
+   */
+  struct Statistics {
+    uint64_t num_transfers;
+    uint64_t num_bytes;
+  };
+
+  static constexpr std::size_t kMaxSegments = 16;
+
   void setClock(Clock clk);
 
   /**
@@ -43,6 +70,24 @@ class Spi {
    */
   void write(uint8_t addr, uint8_t *tx, uint16_t len);
 
+  /**
+   * @brief Submits up to kMaxSegments segments to spidev in a single ioctl, so that a whole
+   *        register access or burst read costs one system call. The hardware chip select stays
+   *        asserted across segments unless a segment asks to deselect after it; chip selects
+   *        driven through GPIO, as for the IMUs, have to be held by the caller around the batch.
+   *
+   * @return true iff all segments were transferred, false without transferring anything if there
+   *         is no spidev device or the last segment asks to deselect after it
+   */
+  bool transferBatch(const Segment *segments, std::size_t num_segments);
+
+  /**
+   * @return true iff the spidev device could be opened
+   */
+  bool isOpen() const { return spi_fd_ >= 0; }
+
+  Statistics getStatistics() const;
+
  private:
   explicit Spi(Logger &log);
   ~Spi();
@@ -57,6 +102,8 @@ class Spi {
   SPI_HW *hw_;
   SPI_CH *ch_;
   Logger &log_;
+  std::atomic<uint64_t> num_transfers_ = 0;
+  std::atomic<uint64_t> num_bytes_     = 0;
 
   NO_COPY_ASSIGN(Spi)
 };
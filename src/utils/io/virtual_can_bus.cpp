@@ -0,0 +1,112 @@
+#include "virtual_can_bus.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include <utils/concurrent/thread.hpp>
+
+namespace hyped::utils::io::can {
+
+VirtualBus::VirtualBus() : inboxes_(std::make_shared<const Inboxes>())
+{
+}
+
+std::unique_ptr<IBus> VirtualBus::attach()
+{
+  auto inbox = std::make_shared<Inbox>();
+  concurrent::ScopedLock L(&inboxes_lock_);
+  auto inboxes = std::make_shared<Inboxes>(*inboxes_.load());
+  inboxes->push_back(inbox);
+  inboxes_.store(std::move(inboxes));
+  return std::make_unique<Node>(*this, std::move(inbox));
+}
+
+void VirtualBus::detach(const Inbox &inbox)
+{
+  concurrent::ScopedLock L(&inboxes_lock_);
+  auto inboxes = std::make_shared<Inboxes>(*inboxes_.load());
+  inboxes->erase(std::remove_if(inboxes->begin(), inboxes->end(),
+                                [&inbox](const auto &other) { return other.get() == &inbox; }),
+                 inboxes->end());
+  inboxes_.store(std::move(inboxes));
+}
+
+std::size_t VirtualBus::getNumNodes() const
+{
+  return inboxes_.load()->size();
+}
+
+uint64_t VirtualBus::getNumDropped() const
+{
+  return num_dropped_.load(std::memory_order_relaxed);
+}
+
+bool VirtualBus::Inbox::accepts(const Frame &frame) const
+{
+  const auto ranges = filters.load();
+  if (!ranges) { return true; }
+  return std::any_of(ranges->begin(), ranges->end(), [&frame](const IdRange &ids) {
+    return ids.extended == frame.extended && ids.first <= frame.id && frame.id <= ids.last;
+  });
+}
+
+void VirtualBus::broadcast(const Inbox &sender, const Frame *frames, const std::size_t num_frames)
+{
+  const auto inboxes = inboxes_.load();
+  for (const auto &inbox : *inboxes) {
+    if (inbox.get() == &sender) { continue; }
+    std::ptrdiff_t num_pushed = 0;
+    for (std::size_t i = 0; i < num_frames; ++i) {
+      if (!inbox->accepts(frames[i])) { continue; }
+      if (inbox->frames.tryPush(frames[i])) {
+        ++num_pushed;
+      } else {
+        num_dropped_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    if (num_pushed > 0) { inbox->num_frames.release(num_pushed); }
+  }
+}
+
+VirtualBus::Node::Node(VirtualBus &bus, std::shared_ptr<Inbox> inbox)
+    : bus_(bus),
+      inbox_(std::move(inbox))
+{
+}
+
+VirtualBus::Node::~Node()
+{
+  bus_.detach(*inbox_);
+}
+
+std::size_t VirtualBus::Node::send(const Frame *frames, const std::size_t num_frames)
+{
+  bus_.broadcast(*inbox_, frames, num_frames);
+  return num_frames;
+}
+
+void VirtualBus::Node::setFilters(const std::vector<IdRange> &ranges)
+{
+  inbox_->filters.store(std::make_shared<const std::vector<IdRange>>(ranges));
+}
+
+std::size_t VirtualBus::Node::receive(Frame *frames, const std::size_t max_num_frames,
+                                      const uint32_t timeout_micros)
+{
+  if (max_num_frames == 0
+      || !inbox_->num_frames.try_acquire_for(std::chrono::microseconds(timeout_micros))) {
+    return 0;
+  }
+  // counts are only released for pushed frames, so a pop can only fail while another sender is
+  // still writing an earlier cell
+  std::size_t num_received = 0;
+  do {
+    while (!inbox_->frames.tryPop(frames[num_received])) {
+      concurrent::Thread::yield();
+    }
+    ++num_received;
+  } while (num_received < max_num_frames && inbox_->num_frames.try_acquire());
+  return num_received;
+}
+
+}  // namespace hyped::utils::io::can
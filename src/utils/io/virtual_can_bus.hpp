@@ -0,0 +1,98 @@
+#pragma once
+
+#include "can.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <semaphore>
+#include <vector>
+
+#include <utils/concurrent/lock.hpp>
+#include <utils/concurrent/mpmc_queue.hpp>
+#include <utils/utils.hpp>
+
+namespace hyped::utils::io::can {
+
+/**
+ * @brief In-process CAN bus for testing without hardware. Every attached node is an IBus that can
+ *        be handed to a `Can`, so the pod's Can singleton (if the system is configured to
+ *        use_virtual_can) and simulated motor controllers or BMS units run the same receive and
+ *        dispatch code as on the real bus.
+ *
+ *        Like on a real bus, a frame sent by one node is received by every other node but not by
+ *        the sender itself. Each node has a bounded lock-free queue of incoming frames that any
+ *        number of senders push into without taking a lock; if a node does not keep up, frames
+ *        addressed to it are dropped and counted. Like a socket, a node that has been given
+ *        filters only queues the frames whose ids they cover.
+ */
+class VirtualBus {
+ public:
+  static constexpr std::size_t kQueueCapacity = 1024;
+
+  static VirtualBus &getInstance()
+  {
+    static VirtualBus bus;
+    return bus;
+  }
+
+  VirtualBus();
+
+  NO_COPY_ASSIGN(VirtualBus)
+
+  /**
+   * @brief Adds a node that receives every frame other nodes send from now on. The node detaches
+   *        itself when it is destroyed, which must happen before the bus is destroyed.
+   */
+  std::unique_ptr<IBus> attach();
+
+  std::size_t getNumNodes() const;
+
+  /**
+   * @brief Total number of frames dropped so far because a node's queue was full.
+   */
+  uint64_t getNumDropped() const;
+
+ private:
+  struct Inbox {
+    concurrent::MpmcQueue<Frame, kQueueCapacity> frames;
+    // counts the frames in the queue so that a receiver can sleep until there is one
+    std::counting_semaphore<kQueueCapacity> num_frames{0};
+    // nullptr until filters are set, which accepts every frame
+    std::atomic<std::shared_ptr<const std::vector<IdRange>>> filters;
+
+    bool accepts(const Frame &frame) const;
+  };
+  using Inboxes = std::vector<std::shared_ptr<Inbox>>;
+
+  class Node : public IBus {
+   public:
+    Node(VirtualBus &bus, std::shared_ptr<Inbox> inbox);
+    ~Node();
+
+    bool isOpen() const override { return true; }
+    std::size_t send(const Frame *frames, std::size_t num_frames) override;
+    std::size_t receive(Frame *frames, std::size_t max_num_frames,
+                        uint32_t timeout_micros) override;
+    void setFilters(const std::vector<IdRange> &ranges) override;
+
+   private:
+    VirtualBus &bus_;
+    std::shared_ptr<Inbox> inbox_;
+  };
+
+  /**
+   * @brief Pushes the frames to every inbox apart from the sender's.
+   */
+  void broadcast(const Inbox &sender, const Frame *frames, std::size_t num_frames);
+
+  void detach(const Inbox &inbox);
+
+  // copied on every attach and detach so that senders can iterate a snapshot without locking
+  std::atomic<std::shared_ptr<const Inboxes>> inboxes_;
+  concurrent::Lock inboxes_lock_;
+  std::atomic<uint64_t> num_dropped_ = 0;
+};
+
+}  // namespace hyped::utils::io::can
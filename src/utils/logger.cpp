@@ -1,4 +1,5 @@
 #include "utils/logger.hpp"
+#include "utils/async_logger.hpp"
 
 #include <stdarg.h>
 
@@ -23,22 +24,55 @@ void Logger::print(FILE *file, const char *format, va_list args)
   fprintf(file, "\n");
 }
 
-void Logger::printHead(FILE *file, const char *title) const
+void Logger::printHead(FILE *file, const char *title, const char *module,
+                       const std::chrono::system_clock::time_point time)
 {
   using namespace std::chrono;
-  std::time_t t = std::time(nullptr);
-  tm *tt        = localtime(&t);
-  fprintf(file, "%02d:%02d:%02d", tt->tm_hour, tt->tm_min, tt->tm_sec);
+  const std::time_t t = system_clock::to_time_t(time);
+  tm tt;
+  localtime_r(&t, &tt);
+  fprintf(file, "%02d:%02d:%02d", tt.tm_hour, tt.tm_min, tt.tm_sec);
 
   static const bool print_micro = true;
   if (print_micro) {
-    auto now_time                       = high_resolution_clock::now().time_since_epoch();
-    duration<int, std::milli> time_span = duration_cast<std::chrono::milliseconds>(now_time);
-    fprintf(file, ".%03d ", static_cast<uint16_t>(time_span.count()) % 1000);
+    const auto millis = duration_cast<milliseconds>(time.time_since_epoch()).count() % 1000;
+    fprintf(file, ".%03d ", static_cast<int>(millis));
   } else {
     fprintf(file, " ");
   }
-  fprintf(file, "%s[%s]: ", title, module_);
+  fprintf(file, "%s[%s]: ", title, module);
+}
+
+const char *Logger::getTitle(const Level level)
+{
+  switch (level) {
+    case Level::kError:
+      return "ERROR";
+    case Level::kInfo:
+      return "INFO";
+    case Level::kDebug:
+      return "DEBUG";
+    default:
+      return "";
+  }
+}
+
+FILE *Logger::getFile(const Level level)
+{
+  return level == Level::kError ? stderr : stdout;
+}
+
+void Logger::log(const Level level, const char *format, va_list args) const
+{
+  AsyncLogger *const async_logger = async_logger_.load(std::memory_order_acquire);
+  if (async_logger != nullptr) {
+    async_logger->push(level, module_, format, args);
+    return;
+  }
+  FILE *const file = getFile(level);
+  utils::concurrent::ScopedLock scoped_lock(&output_lock_);
+  printHead(file, getTitle(level), module_, std::chrono::system_clock::now());
+  print(file, format, args);
 }
 
 Logger::Logger(const char *const module, const Level level) : module_(module), level_(level)
@@ -54,41 +88,37 @@ void Logger::setLevel(const Logger::Level level)
   level_ = level;
 }
 
+void Logger::setAsyncLogger(AsyncLogger *async_logger)
+{
+  async_logger_.store(async_logger, std::memory_order_release);
+}
+
 void Logger::error(const char *format, ...) const
 {
-  static FILE *file = stderr;
   if (level_ == Level::kDebug || level_ == Level::kInfo || level_ == Level::kError) {
-    utils::concurrent::ScopedLock scoped_lock(&output_lock_);
-    printHead(file, "ERROR");
     va_list args;
     va_start(args, format);
-    print(file, format, args);
+    log(Level::kError, format, args);
     va_end(args);
   }
 }
 
 void Logger::info(const char *format, ...) const
 {
-  static FILE *file = stdout;
   if (level_ == Level::kDebug || level_ == Level::kInfo) {
-    utils::concurrent::ScopedLock scoped_lock(&output_lock_);
-    printHead(file, "INFO");
     va_list args;
     va_start(args, format);
-    print(file, format, args);
+    log(Level::kInfo, format, args);
     va_end(args);
   }
 }
 
 void Logger::debug(const char *format, ...) const
 {
-  static FILE *file = stdout;
   if (level_ == Level::kDebug) {
-    utils::concurrent::ScopedLock scoped_lock(&output_lock_);
-    printHead(file, "DEBUG");
     va_list args;
     va_start(args, format);
-    print(file, format, args);
+    log(Level::kDebug, format, args);
     va_end(args);
   }
 }
@@ -2,13 +2,45 @@
 
 #include <stdio.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
 #include <cstdint>
 #include <optional>
 
 #include <utils/concurrent/lock.hpp>
 
+/**
+ * Compile-time upper bound on the level of messages a translation unit can emit, as the integer
+ * value of utils::Logger::Level. make_lib sets it per module from the MAX_LOG_LEVEL and
+ * MAX_LOG_LEVEL_<MODULE> CMake options; everything is compiled in by default.
+ */
+#ifndef HYPED_MAX_LOG_LEVEL
+#define HYPED_MAX_LOG_LEVEL 3
+#endif
+
+/**
+ * Logging front-end to be used instead of calling Logger::debug etc. directly. Statements above
+ * HYPED_MAX_LOG_LEVEL are still type checked but compile to nothing, and statements disabled at
+ * runtime do not evaluate their arguments or make the varargs call.
+ */
+#define HYPED_LOG(logger, level, method, ...)                                                      \
+  do {                                                                                             \
+    if constexpr (static_cast<int>(level) <= HYPED_MAX_LOG_LEVEL) {                                \
+      if ((logger).isEnabled(level)) { (logger).method(__VA_ARGS__); }                             \
+    }                                                                                              \
+  } while (false)
+#define LOG_ERROR(logger, ...)                                                                     \
+  HYPED_LOG(logger, ::hyped::utils::Logger::Level::kError, error, __VA_ARGS__)
+#define LOG_INFO(logger, ...)                                                                      \
+  HYPED_LOG(logger, ::hyped::utils::Logger::Level::kInfo, info, __VA_ARGS__)
+#define LOG_DEBUG(logger, ...)                                                                     \
+  HYPED_LOG(logger, ::hyped::utils::Logger::Level::kDebug, debug, __VA_ARGS__)
+
 namespace hyped::utils {
 
+class AsyncLogger;
+
 class Logger {
  public:
   enum class Level { kNone, kError, kInfo, kDebug };
@@ -19,6 +51,18 @@ class Logger {
 
   void setLevel(const Level level);
 
+  /**
+   * @brief Whether messages of the given level are printed at the current runtime level
+   */
+  bool isEnabled(const Level level) const { return level != Level::kNone && level <= level_; }
+
+  /**
+   * @brief Routes the messages of all loggers through `async_logger` instead of printing them on
+   *        the calling thread. Pass nullptr to print synchronously again. Should only be changed
+   *        while no other thread is logging, i.e. before starting or after joining the threads.
+   */
+  static void setAsyncLogger(AsyncLogger *async_logger);
+
   /**
    * @brief All debug messages have the same format. The arguments closely
    * follow the format-string signature of printf function.
@@ -44,11 +88,18 @@ class Logger {
   void debug(const char *format, ...) const;
 
  private:
+  friend class AsyncLogger;
+
   const char *const module_;
   Level level_;
   inline static concurrent::Lock output_lock_;
+  inline static std::atomic<AsyncLogger *> async_logger_ = nullptr;
+  void log(const Level level, const char *format, va_list args) const;
   static void print(FILE *file, const char *format, va_list args);
-  void printHead(FILE *file, const char *title) const;
+  static void printHead(FILE *file, const char *title, const char *module,
+                        std::chrono::system_clock::time_point time);
+  static const char *getTitle(const Level level);
+  static FILE *getFile(const Level level);
 };
 
 }  // namespace hyped::utils
@@ -1,14 +1,44 @@
 #pragma once
 
+#include <cstdint>
+#include <stdexcept>
+
 #include <Eigen/Dense>
 
 namespace hyped::utils::math {
 
 /**
  * @brief    This class is for filtering the data from sensors to smoothen it.
+ *
+ *           The dimensions are template parameters. With fixed dimensions, e.g.
+ *           `KalmanMultivariate<3, 1>`, all matrices are fixed-size Eigen types so filtering never
+ *           allocates, and the n = m = 1 case without control is computed on plain scalars. The
+ *           default `KalmanMultivariate<>` has its dimensions chosen at runtime.
+ *
+ * @tparam N                            state dimensionality or Eigen::Dynamic
+ * @tparam M                            measurement dimensionality or Eigen::Dynamic
+ * @tparam K                            control dimensionality (0 if not used) or Eigen::Dynamic
  */
+template<int N = Eigen::Dynamic, int M = Eigen::Dynamic,
+         int K = (N == Eigen::Dynamic ? Eigen::Dynamic : 0)>
 class KalmanMultivariate {
  public:
+  using StateVector                 = Eigen::Matrix<float, N, 1>;
+  using StateMatrix                 = Eigen::Matrix<float, N, N>;
+  using ControlVector               = Eigen::Matrix<float, K, 1>;
+  using ControlMatrix               = Eigen::Matrix<float, N, K>;
+  using MeasurementVector           = Eigen::Matrix<float, M, 1>;
+  using MeasurementMatrix           = Eigen::Matrix<float, M, N>;
+  using MeasurementCovarianceMatrix = Eigen::Matrix<float, M, M>;
+
+  static constexpr bool kIsScalar = N == 1 && M == 1 && K == 0;
+
+  /**
+   * @brief    Construct a new Kalman object with the dimensions given by the template parameters
+   */
+  KalmanMultivariate()
+    requires(N != Eigen::Dynamic && M != Eigen::Dynamic && K != Eigen::Dynamic);
+
   /**
    * @brief    Construct a new Kalman object with respective dimensions (with control)
    *
@@ -24,7 +54,7 @@ class KalmanMultivariate {
    * @param[in] A                       state transition matrix
    * @param[in] Q                       process noise covariance
    */
-  void setDynamicsModel(Eigen::MatrixXf &A, Eigen::MatrixXf &Q);
+  void setDynamicsModel(const StateMatrix &A, const StateMatrix &Q);
 
   /**
    * @brief    Set dynamics model matrices (with control)
@@ -33,7 +63,7 @@ class KalmanMultivariate {
    * @param[in] B                       control matrix
    * @param[in] Q                       process noise covariance
    */
-  void setDynamicsModel(Eigen::MatrixXf &A, Eigen::MatrixXf &B, Eigen::MatrixXf &Q);
+  void setDynamicsModel(const StateMatrix &A, const ControlMatrix &B, const StateMatrix &Q);
 
   /**
    * @brief    Set measurement model matrices
@@ -41,7 +71,7 @@ class KalmanMultivariate {
    * @param[in] H                       measurement matrix
    * @param[in] R                       measurement noise covariance
    */
-  void setMeasurementModel(Eigen::MatrixXf &H, Eigen::MatrixXf &R);
+  void setMeasurementModel(const MeasurementMatrix &H, const MeasurementCovarianceMatrix &R);
 
   /**
    * @brief    Set model matrices (without control)
@@ -51,7 +81,8 @@ class KalmanMultivariate {
    * @param[in] H                       measurement matrix
    * @param[in] R                       measurement noise covariance
    */
-  void setModels(Eigen::MatrixXf &A, Eigen::MatrixXf &Q, Eigen::MatrixXf &H, Eigen::MatrixXf &R);
+  void setModels(const StateMatrix &A, const StateMatrix &Q, const MeasurementMatrix &H,
+                 const MeasurementCovarianceMatrix &R);
 
   /**
    * @brief    Set model matrices (with control)
@@ -62,22 +93,22 @@ class KalmanMultivariate {
    * @param[in] H                       measurement matrix
    * @param[in] R                       measurement noise covariance
    */
-  void setModels(Eigen::MatrixXf &A, Eigen::MatrixXf &B, Eigen::MatrixXf &Q, Eigen::MatrixXf &H,
-                 Eigen::MatrixXf &R);
+  void setModels(const StateMatrix &A, const ControlMatrix &B, const StateMatrix &Q,
+                 const MeasurementMatrix &H, const MeasurementCovarianceMatrix &R);
 
   /**
    * @brief    Update state transition matrix
    *
    * @param[in] A                       state transition matrix
    */
-  void updateA(Eigen::MatrixXf &A);
+  void updateA(const StateMatrix &A);
 
   /**
    * @brief    Update measurement covariance matrix
    *
    * @param[in] R                       measurement covariance matrix
    */
-  void updateR(Eigen::MatrixXf &R);
+  void updateR(const MeasurementCovarianceMatrix &R);
 
   /**
    * @brief    Set initial beliefs
@@ -85,14 +116,14 @@ class KalmanMultivariate {
    * @param[in] x0                      initial state belief
    * @param[in] P0                      initial state covariance (uncertainty)
    */
-  void setInitial(Eigen::VectorXf &x0, Eigen::MatrixXf &P0);
+  void setInitial(const StateVector &x0, const StateMatrix &P0);
 
   /**
    * @brief    Filter measurement and update state belief with covariance (without control)
    *
    * @param[in] z                       measurement vector
    */
-  void filter(Eigen::VectorXf &z);
+  void filter(const MeasurementVector &z);
 
   /**
    * @brief    Filter measurement and update state belief with covariance (with control)
@@ -100,21 +131,21 @@ class KalmanMultivariate {
    * @param[in] u                       control vector
    * @param[in] z                       measurement vector
    */
-  void filter(Eigen::VectorXf &u, Eigen::VectorXf &z);
+  void filter(const ControlVector &u, const MeasurementVector &z);
 
   /**
    * @brief     Get the state estimate
    *
    * @return    Returns the current state estimate
    */
-  Eigen::VectorXf &getStateEstimate();
+  StateVector &getStateEstimate() { return x_; }
 
   /**
    * @brief     Get the state uncertainty
    *
    * @return    Returns the current state covariance
    */
-  Eigen::MatrixXf &getStateCovariance();
+  StateMatrix &getStateCovariance() { return P_; }
 
  private:
   /* problem dimensions */
@@ -123,18 +154,18 @@ class KalmanMultivariate {
   Eigen::Index k_;  // control dimension (0 if not set)
 
   /* dynamics model matrices */
-  Eigen::MatrixXf A_;  // state transition matrix: n x n
-  Eigen::MatrixXf B_;  // control matrix: n x k
-  Eigen::MatrixXf Q_;  // process noise covariance: n x n
+  StateMatrix A_;    // state transition matrix: n x n
+  ControlMatrix B_;  // control matrix: n x k
+  StateMatrix Q_;    // process noise covariance: n x n
 
   /* measurement model matrices */
-  Eigen::MatrixXf H_;  // measurement matrix: m x n
-  Eigen::MatrixXf R_;  // measurement noise covariance: m x m
+  MeasurementMatrix H_;            // measurement matrix: m x n
+  MeasurementCovarianceMatrix R_;  // measurement noise covariance: m x m
 
   /* state estimates */
-  Eigen::VectorXf x_;  // state vector: n x 1
-  Eigen::MatrixXf P_;  // state covariance: n x n
-  Eigen::MatrixXf I_;  // identity matrix: n x n
+  StateVector x_;  // state vector: n x 1
+  StateMatrix P_;  // state covariance: n x n
+  StateMatrix I_;  // identity matrix: n x n
 
   /**
    * @brief    Predict state belief with covariance based on dynamics (without control)
@@ -146,13 +177,174 @@ class KalmanMultivariate {
    *
    * @param[in] u                       control vector
    */
-  void predict(Eigen::VectorXf &u);
+  void predict(const ControlVector &u);
 
   /**
    * @brief    Correct state belief with covariance based on measurement
    *
    * @param[in] z                       measurement vector
    */
-  void correct(Eigen::VectorXf &z);
+  void correct(const MeasurementVector &z);
 };
+
+template<int N, int M, int K>
+KalmanMultivariate<N, M, K>::KalmanMultivariate()
+  requires(N != Eigen::Dynamic && M != Eigen::Dynamic && K != Eigen::Dynamic)
+    : n_(N),
+      m_(M),
+      k_(K)
+{
+}
+
+template<int N, int M, int K>
+KalmanMultivariate<N, M, K>::KalmanMultivariate(uint32_t n, uint32_t m, uint32_t k)
+    : n_(n),
+      m_(m),
+      k_(k)
+{
+  if ((N != Eigen::Dynamic && n_ != N) || (M != Eigen::Dynamic && m_ != M)
+      || (K != Eigen::Dynamic && k_ != K)) {
+    throw std::invalid_argument("Dimensions do not match the template parameters");
+  }
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::setDynamicsModel(const StateMatrix &A, const StateMatrix &Q)
+{
+  if (A.cols() != n_ || A.rows() != n_ || Q.cols() != n_ || Q.rows() != n_) {
+    throw std::invalid_argument("Wrong dimension of the Matrices");
+  } else {
+    A_ = A;
+    Q_ = Q;
+  }
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::setDynamicsModel(const StateMatrix &A, const ControlMatrix &B,
+                                                   const StateMatrix &Q)
+{
+  if (A.cols() != n_ || A.rows() != n_ || Q.cols() != n_ || Q.rows() != n_ || B.rows() != n_
+      || B.cols() != k_) {
+    throw std::invalid_argument("Wrong dimension of the Matrices");
+  } else {
+    A_ = A;
+    B_ = B;
+    Q_ = Q;
+  }
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::setMeasurementModel(const MeasurementMatrix &H,
+                                                      const MeasurementCovarianceMatrix &R)
+{
+  if (R.cols() != m_ || R.rows() != m_ || H.rows() != m_ || H.cols() != n_) {
+    throw std::invalid_argument("Wrong dimension of the Matrices");
+  } else {
+    H_ = H;
+    R_ = R;
+  }
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::setModels(const StateMatrix &A, const StateMatrix &Q,
+                                            const MeasurementMatrix &H,
+                                            const MeasurementCovarianceMatrix &R)
+{
+  setDynamicsModel(A, Q);
+  setMeasurementModel(H, R);
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::setModels(const StateMatrix &A, const ControlMatrix &B,
+                                            const StateMatrix &Q, const MeasurementMatrix &H,
+                                            const MeasurementCovarianceMatrix &R)
+{
+  setDynamicsModel(A, B, Q);
+  setMeasurementModel(H, R);
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::updateA(const StateMatrix &A)
+{
+  if (A.cols() != n_ || A.rows() != n_) {
+    throw std::invalid_argument("Wrong dimension of the Matrices");
+  } else {
+    A_ = A;
+  }
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::updateR(const MeasurementCovarianceMatrix &R)
+{
+  if (R.cols() != m_ || R.rows() != m_) {
+    throw std::invalid_argument("Wrong dimension of the Matrices");
+  } else {
+    R_ = R;
+  }
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::setInitial(const StateVector &x0, const StateMatrix &P0)
+{
+  if (x0.rows() != n_ || P0.rows() != n_ || P0.cols() != n_) {
+    throw std::invalid_argument("Dimension of Matrices not correct");
+  } else {
+    x_ = x0;
+    P_ = P0;
+    I_ = StateMatrix::Identity(n_, n_);
+  }
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::predict()
+{
+  if constexpr (kIsScalar) {
+    // same operations in the same order as the matrix expressions below, so results are identical
+    x_(0) = A_(0) * x_(0);
+    P_(0) = A_(0) * P_(0) * A_(0) + Q_(0);
+  } else {
+    x_ = A_ * x_;
+    P_ = A_ * P_ * A_.transpose() + Q_;
+  }
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::predict(const ControlVector &u)
+{
+  x_ = A_ * x_ + B_ * u;
+  P_ = (A_ * P_ * A_.transpose()) + Q_;
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::correct(const MeasurementVector &z)
+{
+  if constexpr (kIsScalar) {
+    const float gain = (P_(0) * H_(0)) * (1.0f / (H_(0) * P_(0) * H_(0) + R_(0)));
+    x_(0)            = x_(0) + gain * (z(0) - H_(0) * x_(0));
+    P_(0)            = (1.0f - gain * H_(0)) * P_(0);
+  } else {
+    const Eigen::Matrix<float, N, M> gain
+      = (P_ * H_.transpose()) * (H_ * P_ * H_.transpose() + R_).inverse();
+    x_ = x_ + gain * (z - H_ * x_);
+    P_ = (I_ - gain * H_) * P_;
+  }
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::filter(const MeasurementVector &z)
+{
+  predict();
+  correct(z);
+}
+
+template<int N, int M, int K>
+void KalmanMultivariate<N, M, K>::filter(const ControlVector &u, const MeasurementVector &z)
+{
+  predict(u);
+  correct(z);
+}
+
+// the runtime-sized filter is compiled once in kalman_multivariate.cpp
+extern template class KalmanMultivariate<>;
+
 }  // namespace hyped::utils::math
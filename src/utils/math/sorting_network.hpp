@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace hyped::utils::math {
+
+/**
+ * @brief Orders two elements so that `lhs <= rhs`. Uses min/max rather than a swap under a
+ *        condition, which compiles to branch-free instructions for arithmetic types.
+ */
+template<typename T>
+constexpr void compareExchange(T &lhs, T &rhs)
+{
+  const T lower = std::min(lhs, rhs);
+  const T upper = std::max(lhs, rhs);
+  lhs           = lower;
+  rhs           = upper;
+}
+
+/**
+ * @brief Sorts a fixed-size array in ascending order with a sorting network, i.e. a sequence of
+ *        compare-exchange operations that does not depend on the data. For four elements the
+ *        optimal network of five comparators is used; other sizes use odd-even transposition sort,
+ *        which needs N rounds and is intended for the handful of elements of redundant sensors.
+ *
+ * @tparam T Element type, must be ordered by `<`
+ * @tparam N Number of elements
+ */
+template<typename T, std::size_t N>
+constexpr void sortingNetwork(std::array<T, N> &values)
+{
+  if constexpr (N == 4) {
+    compareExchange(values[0], values[1]);
+    compareExchange(values[2], values[3]);
+    compareExchange(values[0], values[2]);
+    compareExchange(values[1], values[3]);
+    compareExchange(values[1], values[2]);
+  } else {
+    for (std::size_t round = 0; round < N; ++round) {
+      for (std::size_t i = round % 2; i + 1 < N; i += 2) {
+        compareExchange(values[i], values[i + 1]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Returns a sorted copy of `values`. See `sortingNetwork`.
+ */
+template<typename T, std::size_t N>
+constexpr std::array<T, N> sorted(std::array<T, N> values)
+{
+  sortingNetwork(values);
+  return values;
+}
+
+}  // namespace hyped::utils::math
@@ -2,9 +2,12 @@
 
 #include <cmath>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
-#include <list>
-#include <queue>
+#include <cstddef>
+#include <utility>
+#include <vector>
 
 namespace hyped {
 namespace utils {
@@ -70,57 +73,93 @@ void OnlineStatistics<T>::update(T new_value)
 }
 
 /**
- * @brief Computes stats (mean, variance, etc.) of a rolling window of numbers. Memory usage is
- *        linear in `window_size`.
+ * @brief Computes stats (mean, variance, etc.) of a rolling window of numbers. The window is kept
+ *        in a ring buffer of type `Window` (`std::vector` or `std::array`) so `update()` never
+ *        allocates. Until the window is full the stats are computed as by `OnlineStatistics`;
+ *        afterwards every new value replaces the oldest one and the mean and the sum of squared
+ *        differences from the mean are updated in constant time using the numerically stable
+ *        method described here:
+ *        http://jonisalonen.com/2014/efficient-and-accurate-rolling-standard-deviation/
  *
  * @tparam T Underlying numeric type
+ * @tparam Window Random access container of T holding exactly `window_size` elements
  */
-template<typename T>
-class RollingStatistics : public Statistics<T> {
+template<typename T, typename Window>
+class RingStatistics : public Statistics<T> {
  public:
-  explicit RollingStatistics(std::size_t window_size);
   void update(T new_value) override;
+  std::size_t getWindowSize() const { return window_.size(); }
+
+ protected:
+  explicit RingStatistics(Window window);
 
  private:
-  const std::size_t window_size_;
-  std::queue<T, std::list<T>> window_;
-  OnlineStatistics<T> online_;
+  Window window_;
+  std::size_t next_;  // position of the oldest value, i.e. the one replaced next
+  int n_;             // number of values in the window
+  T s_;               // sum of squared differences from mean
 };
 
-template<typename T>
-RollingStatistics<T>::RollingStatistics(std::size_t window_size) : window_size_(window_size)
+template<typename T, typename Window>
+RingStatistics<T, Window>::RingStatistics(Window window) : window_(std::move(window)),
+                                                           next_(0),
+                                                           n_(0),
+                                                           s_(0)
+{
+  assert(!window_.empty());
+}
+
+template<typename T, typename Window>
+void RingStatistics<T, Window>::update(T new_value)
 {
+  if (static_cast<std::size_t>(n_) < window_.size()) {
+    T delta = new_value - this->mean_;
+    n_++;
+    this->sum_ += new_value;
+    this->mean_ = this->sum_ / n_;
+    s_ += delta * (new_value - this->mean_);
+  } else {
+    const T old_value = window_[next_];
+    this->sum_        = this->sum_ + new_value - old_value;
+    T new_mean        = this->sum_ / n_;
+    s_ += (new_value - old_value) * (new_value - new_mean + old_value - this->mean_);
+    this->mean_ = new_mean;
+  }
+  if (n_ > 1) { this->variance_ = s_ / (n_ - 1); }
+  window_[next_] = new_value;
+  next_          = (next_ + 1) % window_.size();
 }
 
 /**
- * @brief Advances the window by one position, updating the outputs accordingly. Running time is
- *        constant. Implemented using a numerically stable method described here:
- *        http://jonisalonen.com/2014/efficient-and-accurate-rolling-standard-deviation/
+ * @brief Rolling stats over a window whose size is chosen at runtime. Memory is allocated once on
+ *        construction and is linear in `window_size`.
  *
  * @tparam T Underlying numeric type
- * @param new_value New value entering the window
  */
 template<typename T>
-void RollingStatistics<T>::update(T new_value)
-{
-  if (window_.size() < window_size_) {
-    window_.push(new_value);
-    online_.update(new_value);
-    this->sum_      = online_.getSum();
-    this->mean_     = online_.getMean();
-    this->variance_ = online_.getVariance();
-  } else {
-    assert(window_.size() == window_size_);
-    this->sum_ = this->sum_ + new_value - window_.front();
-    T new_mean = this->sum_ / window_size_;
-    this->variance_ += (new_value - window_.front())
-                       * (new_value - new_mean + window_.front() - this->mean_)
-                       / (window_size_ - 1);
-    this->mean_ = new_mean;
-    window_.pop();
-    window_.push(new_value);
+class RollingStatistics : public RingStatistics<T, std::vector<T>> {
+ public:
+  // a window of zero values is widened to one, so that update always has a slot to write to
+  explicit RollingStatistics(std::size_t window_size)
+      : RingStatistics<T, std::vector<T>>(std::vector<T>(std::max<std::size_t>(window_size, 1)))
+  {
   }
-}
+};
+
+/**
+ * @brief Rolling stats over a window whose size is known at compile time. The window is stored
+ *        inline, so this never allocates.
+ *
+ * @tparam T Underlying numeric type
+ * @tparam kWindowSize Number of values in the window
+ */
+template<typename T, std::size_t kWindowSize>
+class FixedRollingStatistics : public RingStatistics<T, std::array<T, kWindowSize>> {
+ public:
+  static_assert(kWindowSize > 0, "window must hold at least one value");
+
+  FixedRollingStatistics() : RingStatistics<T, std::array<T, kWindowSize>>({}) {}
+};
 
 }  // namespace math
 }  // namespace utils
@@ -313,6 +313,25 @@ void System::parseArgs(const int argc, const char *const *const argv)
       argv[0]);
     config.use_fake_controller = false;
   }
+  // Log asynchronously?
+  if (config_object.HasMember("use_async_logging")) {
+    config.use_async_logging = config_object["use_async_logging"].GetBool();
+  } else {
+    kInitialisationErrorLogger.info(
+      "could not find field 'system.use_async_logging' in config file at %s; using default "
+      "value",
+      argv[1]);
+    config.use_async_logging = false;
+  }
+  // Use in-process CAN bus?
+  if (config_object.HasMember("use_virtual_can")) {
+    config.use_virtual_can = config_object["use_virtual_can"].GetBool();
+  } else {
+    kInitialisationErrorLogger.info(
+      "could not find field 'system.use_virtual_can' in config file at %s; using default value",
+      argv[1]);
+    config.use_virtual_can = false;
+  }
   // Axis
   if (config_object.HasMember("axis")) {
     config.axis = static_cast<std::uint8_t>(config_object["axis"].GetUint());
@@ -42,6 +42,8 @@ class System {
     bool use_fake_brake_pressure_fail;
     bool use_fake_brakes;
     bool use_fake_controller;
+    bool use_async_logging;
+    bool use_virtual_can;
     std::uint8_t axis;
     std::uint64_t run_id;
   };
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hyped::testing {
+
+/**
+ * Number of heap allocations made by the calling thread so far. Counted by the allocation hooks
+ * defined in main.test.cpp.
+ */
+uint64_t getNumAllocations();
+
+}  // namespace hyped::testing
@@ -0,0 +1,89 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <data/data.hpp>
+#include <utils/timer.hpp>
+
+namespace hyped::testing {
+
+class DataTest : public ::testing::Test {
+ protected:
+  data::Data &data_ = data::Data::getInstance();
+};
+
+TEST_F(DataTest, versionIncreasesOnUpdate)
+{
+  const auto version       = data_.getVersion(data::Substructure::kTelemetry);
+  const auto total_version = data_.getVersion();
+  data_.setTelemetryData(data_.getTelemetryData());
+  ASSERT_EQ(version + 1, data_.getVersion(data::Substructure::kTelemetry));
+  ASSERT_EQ(total_version + 1, data_.getVersion());
+}
+
+TEST_F(DataTest, partialUpdatesIncreaseVersion)
+{
+  const auto version = data_.getVersion(data::Substructure::kSensors);
+  data_.setSensorsWheelEncoderData(data_.getSensorsWheelEncoderData());
+  ASSERT_EQ(version + 1, data_.getVersion(data::Substructure::kSensors));
+}
+
+TEST_F(DataTest, waitForUpdateTimesOut)
+{
+  const auto version = data_.getVersion(data::Substructure::kBrakes);
+  const auto before  = utils::Timer::getTimeMicros();
+  ASSERT_EQ(version, data_.waitForUpdate(data::Substructure::kBrakes, version, 20));
+  ASSERT_GE(utils::Timer::getTimeMicros() - before, 20000u);
+}
+
+TEST_F(DataTest, waitForUpdateReturnsImmediatelyIfAlreadyUpdated)
+{
+  const auto version = data_.getVersion(data::Substructure::kMotors);
+  data_.setMotorData(data_.getMotorData());
+  ASSERT_EQ(version + 1, data_.waitForUpdate(data::Substructure::kMotors, version, 1000000));
+}
+
+TEST_F(DataTest, waitForUpdateWakesOnUpdate)
+{
+  const auto version                  = data_.getVersion(data::Substructure::kStateMachine);
+  std::atomic<uint64_t> woken_version = 0;
+  std::thread waiter([&]() {
+    woken_version = data_.waitForUpdate(data::Substructure::kStateMachine, version, 10000);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  const auto before = utils::Timer::getTimeMicros();
+  data_.setStateMachineData(data_.getStateMachineData());
+  waiter.join();
+  ASSERT_LT(utils::Timer::getTimeMicros() - before, 1000000u);
+  ASSERT_EQ(version + 1, woken_version);
+}
+
+TEST_F(DataTest, waitForUpdateIgnoresOtherSubstructures)
+{
+  const auto version           = data_.getVersion(data::Substructure::kBrakes);
+  std::atomic<bool> is_waiting = true;
+  std::thread writer([&]() {
+    while (is_waiting) {
+      data_.setSensorsImuData(data_.getSensorsImuData());
+    }
+  });
+  const auto woken_version = data_.waitForUpdate(data::Substructure::kBrakes, version, 20);
+  is_waiting               = false;
+  writer.join();
+  ASSERT_EQ(version, woken_version);
+}
+
+TEST_F(DataTest, waitForAnyUpdateWakesOnUpdate)
+{
+  const auto version                  = data_.getVersion();
+  std::atomic<uint64_t> woken_version = 0;
+  std::thread waiter([&]() { woken_version = data_.waitForUpdate(version, 10000); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  data_.setBatteriesData(data_.getBatteriesData());
+  waiter.join();
+  ASSERT_LT(version, woken_version);
+}
+
+}  // namespace hyped::testing
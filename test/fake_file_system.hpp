@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdlib.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace hyped::testing {
+
+/**
+ * @brief Temporary directory tree standing in for the parts of the file system, such as sysfs and
+ *        /dev, that drivers in utils::io read from. Pass `getRoot()` as the driver's root. The
+ *        tree is removed when the object is destroyed.
+ */
+class FakeFileSystem {
+ public:
+  FakeFileSystem()
+  {
+    char path[] = "/tmp/hyped-fake-fs-XXXXXX";
+    if (mkdtemp(path) != nullptr) { root_ = path; }
+  }
+
+  ~FakeFileSystem()
+  {
+    if (!root_.empty()) {
+      std::error_code error;
+      std::filesystem::remove_all(root_, error);
+    }
+  }
+
+  FakeFileSystem(const FakeFileSystem &) = delete;
+  FakeFileSystem &operator=(const FakeFileSystem &) = delete;
+
+  /**
+   * @return path of the root of the tree, empty if it could not be created
+   */
+  const std::string &getRoot() const { return root_; }
+
+  /**
+   * @return absolute path of `relative_path` within the tree
+   */
+  std::string getPath(const std::string &relative_path) const
+  {
+    return root_ + "/" + relative_path;
+  }
+
+  /**
+   * @brief Replaces the contents of a file in place, creating it and its parent directories if
+   *        need be. Files that a driver keeps open see the new contents.
+   */
+  bool write(const std::string &relative_path, const std::string &content) const
+  {
+    const std::filesystem::path path = getPath(relative_path);
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+    return static_cast<bool>(file);
+  }
+
+  /**
+   * @return contents of a file, empty if it does not exist
+   */
+  std::string read(const std::string &relative_path) const
+  {
+    std::ifstream file(getPath(relative_path), std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+  }
+
+ private:
+  std::string root_;
+};
+
+}  // namespace hyped::testing
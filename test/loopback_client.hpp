@@ -0,0 +1,62 @@
+#pragma once
+
+#include "loopback_server.hpp"
+#include "test.hpp"
+
+#include <memory>
+#include <utility>
+
+#include <telemetry/client.hpp>
+#include <telemetry/io_thread.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Base fixture for tests of the telemetry client and what sends through it, with a loopback server
+ * as the ground station
+ */
+class LoopbackClientTest : public Test {
+ protected:
+  void TearDown() override { disconnect(); }
+
+  /**
+   * @brief Connects a client configured by `config` to the server and starts an I/O thread for it.
+   *        The server address is filled in, so tests only set the fields they care about. The
+   *        client is owned by the fixture, as the I/O thread uses it until it is stopped.
+   *
+   * @return the client, nullptr if it could not connect
+   */
+  telemetry::Client *connect(telemetry::Client::Config config = {})
+  {
+    config.server_ip   = LoopbackServer::kAddress;
+    config.server_port = server_.getPortString();
+    client_            = std::make_unique<telemetry::Client>(log_, config);
+    if (!client_->connect() || !server_.accept()) { return nullptr; }
+    auto io_thread = std::make_unique<telemetry::IoThread>();
+    if (!io_thread->add(*client_)) { return nullptr; }
+    io_thread_ = std::move(io_thread);
+    io_thread_->start();
+    return client_.get();
+  }
+
+  /**
+   * @brief Stops the I/O thread and closes both ends of the connection, so that `connect` can be
+   *        called again.
+   */
+  void disconnect()
+  {
+    if (io_thread_) {
+      io_thread_->stop();
+      io_thread_->join();
+      io_thread_.reset();
+    }
+    client_.reset();
+    server_.closeConnection();
+  }
+
+  LoopbackServer server_;
+  std::unique_ptr<telemetry::Client> client_;
+  std::unique_ptr<telemetry::IoThread> io_thread_;
+};
+
+}  // namespace hyped::testing
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hyped::testing {
+
+/**
+ * @brief TCP server on the loopback interface standing in for the ground station. Listens on a
+ *        port chosen by the kernel; connect a telemetry::Client to "127.0.0.1" and `getPort()`,
+ *        then call `accept()`. Sockets are closed when the object is destroyed.
+ */
+class LoopbackServer {
+ public:
+  static constexpr const char *kAddress = "127.0.0.1";
+
+  LoopbackServer()
+  {
+    listen_socket_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family      = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port        = 0;
+    socklen_t length        = sizeof(address);
+    if (bind(listen_socket_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0
+        || listen(listen_socket_, 1) != 0
+        || getsockname(listen_socket_, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+      return;
+    }
+    port_ = ntohs(address.sin_port);
+  }
+
+  ~LoopbackServer()
+  {
+    closeConnection();
+    if (listen_socket_ >= 0) { close(listen_socket_); }
+  }
+
+  LoopbackServer(const LoopbackServer &) = delete;
+  LoopbackServer &operator=(const LoopbackServer &) = delete;
+
+  /**
+   * @return the port to connect to, 0 if the server could not be set up
+   */
+  uint16_t getPort() const { return port_; }
+  std::string getPortString() const { return std::to_string(port_); }
+
+  /**
+   * @brief Accepts the pending connection. Blocks until a client connects.
+   */
+  bool accept()
+  {
+    socket_ = ::accept(listen_socket_, nullptr, nullptr);
+    return socket_ >= 0;
+  }
+
+  void closeConnection()
+  {
+    if (socket_ >= 0) { close(socket_); }
+    socket_ = -1;
+  }
+
+  /**
+   * @brief Reads whatever has arrived without waiting for more.
+   *
+   * @return number of bytes read
+   */
+  std::size_t drain()
+  {
+    std::size_t total = 0;
+    uint8_t buffer[4096];
+    ssize_t received;
+    while ((received = recv(socket_, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+      total += received;
+    }
+    return total;
+  }
+
+  /**
+   * @brief Reads exactly `len` bytes, waiting for them to arrive.
+   */
+  bool receive(uint8_t *data, std::size_t len)
+  {
+    while (len > 0) {
+      const ssize_t received = recv(socket_, data, len, 0);
+      if (received <= 0) { return false; }
+      data += received;
+      len -= received;
+    }
+    return true;
+  }
+
+  bool send(const std::vector<uint8_t> &data)
+  {
+    return ::send(socket_, data.data(), data.size(), MSG_NOSIGNAL)
+           == static_cast<ssize_t>(data.size());
+  }
+
+  int getSocket() const { return socket_; }
+
+ private:
+  int listen_socket_ = -1;
+  int socket_        = -1;
+  uint16_t port_     = 0;
+};
+
+}  // namespace hyped::testing
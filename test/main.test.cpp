@@ -1,9 +1,62 @@
+#include "allocations.hpp"
+
+#include <cstdlib>
 #include <iostream>
+#include <new>
 
 #include <gtest/gtest.h>
 
 #include <utils/system.hpp>
 
+namespace hyped::testing {
+
+static thread_local uint64_t num_allocations = 0;
+
+uint64_t getNumAllocations()
+{
+  return num_allocations;
+}
+
+}  // namespace hyped::testing
+
+#ifdef __GLIBC__
+// Wrapping the C allocator itself also catches allocations that bypass operator new, e.g. Eigen's
+// or those of the C library. Aligned allocations, e.g. posix_memalign, are not counted.
+extern "C" void *__libc_malloc(std::size_t size);
+extern "C" void *__libc_calloc(std::size_t num, std::size_t size);
+extern "C" void *__libc_realloc(void *pointer, std::size_t size);
+
+extern "C" void *malloc(std::size_t size)
+{
+  ++hyped::testing::num_allocations;
+  return __libc_malloc(size);
+}
+
+extern "C" void *calloc(std::size_t num, std::size_t size)
+{
+  ++hyped::testing::num_allocations;
+  return __libc_calloc(num, size);
+}
+
+extern "C" void *realloc(void *pointer, std::size_t size)
+{
+  ++hyped::testing::num_allocations;
+  return __libc_realloc(pointer, size);
+}
+#else
+void *operator new(std::size_t size)
+{
+  ++hyped::testing::num_allocations;
+  if (void *pointer = std::malloc(size == 0 ? 1 : size)) { return pointer; }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+  std::free(pointer);
+}
+#endif
+
 int main(int argc, char **argv)
 {
   std::cout << "running\n";
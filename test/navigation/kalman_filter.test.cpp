@@ -0,0 +1,183 @@
+#include "allocations.hpp"
+#include "test.hpp"
+
+#include <array>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include <navigation/kalman_filter.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Regression tests for the filter applied to every IMU. The expected values were recorded from the
+ * runtime-sized filter, i.e. `utils::math::KalmanMultivariate<>`, and must be reproduced exactly.
+ */
+class KalmanFilterTest : public Test {
+ protected:
+  static constexpr size_t kNumInputs = 96;
+
+  // measurement covariance is replaced halfway through, as after gravity calibration
+  static constexpr size_t kCalibrationInput         = 48;
+  static constexpr data::nav_t kCalibrationVariance = 0.0123f;
+
+  // accelerations while stationary, accelerating, cruising and braking, with noise and one spike
+  static constexpr std::array<data::nav_t, kNumInputs> kInputs = {{
+    -0.3710f, -0.0747f, -0.0457f, 0.1152f, 0.2081f, -0.9702f,
+    -0.4229f, 0.2597f, 0.2596f, -0.6452f, 0.0208f, -0.3000f,
+    -0.3121f, -0.3131f, -0.0967f, -0.0119f, -0.0086f, -0.2745f,
+    0.5928f, -0.3994f, -0.2410f, 0.2634f, 0.3321f, 0.1481f,
+    9.4452f, 9.5211f, 9.5524f, 9.8986f, 9.6561f, 9.5736f,
+    9.7731f, 9.7154f, 9.7815f, 9.4947f, 10.4921f, 9.6986f,
+    9.2471f, 9.2230f, 9.4670f, 10.3344f, 9.4242f, 9.5345f,
+    9.4860f, 9.1341f, 9.2663f, 9.0102f, 9.3394f, 9.8297f,
+    0.4387f, 0.3914f, 0.5403f, 0.8381f, -0.2091f, 0.6082f,
+    0.8863f, 0.1417f, 0.4938f, 0.4991f, 0.1108f, 0.3824f,
+    15.3631f, 0.4744f, 0.4641f, 0.3796f, 0.6556f, 0.5557f,
+    0.7233f, 0.0585f, -0.2846f, 0.5599f, 0.6895f, 0.7269f,
+    -24.1345f, -24.1960f, -24.6626f, -24.2010f, -24.1489f, -23.7346f,
+    -24.1621f, -24.0000f, -24.3534f, -23.9927f, -23.7011f, -24.3930f,
+    -24.3667f, -24.0935f, -23.9626f, -23.8078f, -24.1661f, -24.3527f,
+    -24.0565f, -23.7466f, -24.1312f, -24.4322f, -23.6515f, -23.1775f
+  }};
+
+  struct Output {
+    data::nav_t estimate;
+    data::nav_t variance;
+  };
+  static constexpr std::array<Output, kNumInputs> kExpectedOutputs = {{
+    {-0x1.7b2ccp-2f, 0x1.05a428p-10f},
+    {-0x1.69025p-4f, 0x1.f4745ap-11f},
+    {-0x1.863588p-5f, 0x1.f46852p-11f},
+    {0x1.b97adp-4f, 0x1.f46848p-11f},
+    {0x1.a0d4b2p-3f, 0x1.f46848p-11f},
+    {-0x1.d55eacp-1f, 0x1.f46848p-11f},
+    {-0x1.c8154cp-2f, 0x1.f46848p-11f},
+    {0x1.d2177p-3f, 0x1.f46848p-11f},
+    {0x1.08564cp-2f, 0x1.f46848p-11f},
+    {-0x1.35468cp-1f, 0x1.f46848p-11f},
+    {-0x1.f619p-8f, 0x1.f46848p-11f},
+    {-0x1.259094p-2f, 0x1.f46848p-11f},
+    {-0x1.3e67acp-2f, 0x1.f46848p-11f},
+    {-0x1.408386p-2f, 0x1.f46848p-11f},
+    {-0x1.b4702cp-4f, 0x1.f46848p-11f},
+    {-0x1.099b2p-6f, 0x1.f46848p-11f},
+    {-0x1.252a4p-7f, 0x1.f46848p-11f},
+    {-0x1.0cb3bap-2f, 0x1.f46848p-11f},
+    {0x1.1b91cp-1f, 0x1.f46848p-11f},
+    {-0x1.6c8634p-2f, 0x1.f46848p-11f},
+    {-0x1.f84b3ap-3f, 0x1.f46848p-11f},
+    {0x1.ebe6f6p-3f, 0x1.f46848p-11f},
+    {0x1.4fc88cp-2f, 0x1.f46848p-11f},
+    {0x1.401522p-3f, 0x1.f46848p-11f},
+    {0x1.20b50cp+3f, 0x1.f46848p-11f},
+    {0x1.2ff2a8p+3f, 0x1.f46848p-11f},
+    {0x1.31991ap+3f, 0x1.f46848p-11f},
+    {0x1.3c3f3ap+3f, 0x1.f46848p-11f},
+    {0x1.355356p+3f, 0x1.f46848p-11f},
+    {0x1.327d9p+3f, 0x1.f46848p-11f},
+    {0x1.38746p+3f, 0x1.f46848p-11f},
+    {0x1.36f6c4p+3f, 0x1.f46848p-11f},
+    {0x1.38ea36p+3f, 0x1.f46848p-11f},
+    {0x1.303e84p+3f, 0x1.f46848p-11f},
+    {0x1.4e4ffp+3f, 0x1.f46848p-11f},
+    {0x1.377248p+3f, 0x1.f46848p-11f},
+    {0x1.289d7p+3f, 0x1.f46848p-11f},
+    {0x1.27340ep+3f, 0x1.f46848p-11f},
+    {0x1.2e9768p+3f, 0x1.f46848p-11f},
+    {0x1.496ba4p+3f, 0x1.f46848p-11f},
+    {0x1.2ed7cp+3f, 0x1.f46848p-11f},
+    {0x1.310042p+3f, 0x1.f46848p-11f},
+    {0x1.2f9e36p+3f, 0x1.f46848p-11f},
+    {0x1.24ceap+3f, 0x1.f46848p-11f},
+    {0x1.285a38p+3f, 0x1.f46848p-11f},
+    {0x1.20b124p+3f, 0x1.f46848p-11f},
+    {0x1.2a65ccp+3f, 0x1.f46848p-11f},
+    {0x1.39d08ep+3f, 0x1.f46848p-11f},
+    {0x1.f3ac44p+1f, 0x1.fbf062p-8f},
+    {0x1.78566p+0f, 0x1.17441ap-7f},
+    {0x1.a4111ep-1f, 0x1.199b58p-7f},
+    {0x1.aa6358p-1f, 0x1.19d1a4p-7f},
+    {0x1.aaeaap-4f, 0x1.19d69p-7f},
+    {0x1.d39a12p-2f, 0x1.19d7p-7f},
+    {0x1.83a16ep-1f, 0x1.19d708p-7f},
+    {0x1.4e9b2ep-2f, 0x1.19d70ep-7f},
+    {0x1.c636aep-2f, 0x1.19d70cp-7f},
+    {0x1.edfa4ap-2f, 0x1.19d70cp-7f},
+    {0x1.c7c81cp-3f, 0x1.19d70cp-7f},
+    {0x1.565a52p-2f, 0x1.19d70cp-7f},
+    {0x1.5afe7ap+3f, 0x1.19d70cp-7f},
+    {0x1.cbdcbp+1f, 0x1.19d70cp-7f},
+    {0x1.67aa4p+0f, 0x1.19d70cp-7f},
+    {0x1.603a84p-1f, 0x1.19d70cp-7f},
+    {0x1.54a5ccp-1f, 0x1.19d70cp-7f},
+    {0x1.2d65dcp-1f, 0x1.19d70cp-7f},
+    {0x1.5d999ep-1f, 0x1.19d70cp-7f},
+    {0x1.f8503cp-3f, 0x1.19d70cp-7f},
+    {-0x1.ffd6ep-4f, 0x1.19d70cp-7f},
+    {0x1.6a7084p-2f, 0x1.19d70cp-7f},
+    {0x1.2d5baap-1f, 0x1.19d70cp-7f},
+    {0x1.5ee082p-1f, 0x1.19d70cp-7f},
+    {-0x1.0aba92p+4f, 0x1.19d70cp-7f},
+    {-0x1.5eed2cp+4f, 0x1.19d70cp-7f},
+    {-0x1.7d77a4p+4f, 0x1.19d70cp-7f},
+    {-0x1.817cbcp+4f, 0x1.19d70cp-7f},
+    {-0x1.821cfap+4f, 0x1.19d70cp-7f},
+    {-0x1.7daa84p+4f, 0x1.19d70cp-7f},
+    {-0x1.811c9cp+4f, 0x1.19d70cp-7f},
+    {-0x1.805596p+4f, 0x1.19d70cp-7f},
+    {-0x1.840df4p+4f, 0x1.19d70cp-7f},
+    {-0x1.81233cp+4f, 0x1.19d70cp-7f},
+    {-0x1.7cff76p+4f, 0x1.19d70cp-7f},
+    {-0x1.837e86p+4f, 0x1.19d70cp-7f},
+    {-0x1.85275p+4f, 0x1.19d70cp-7f},
+    {-0x1.82988ep+4f, 0x1.19d70cp-7f},
+    {-0x1.805cbap+4f, 0x1.19d70cp-7f},
+    {-0x1.7df562p+4f, 0x1.19d70cp-7f},
+    {-0x1.813e96p+4f, 0x1.19d70cp-7f},
+    {-0x1.845204p+4f, 0x1.19d70cp-7f},
+    {-0x1.81ee7p+4f, 0x1.19d70cp-7f},
+    {-0x1.7dbee4p+4f, 0x1.19d70cp-7f},
+    {-0x1.80ca3cp+4f, 0x1.19d70cp-7f},
+    {-0x1.8512bcp+4f, 0x1.19d70cp-7f},
+    {-0x1.7da062p+4f, 0x1.19d70cp-7f},
+    {-0x1.761572p+4f, 0x1.19d70cp-7f}
+  }};
+
+  static bool isBitwiseEqual(const data::nav_t lhs, const data::nav_t rhs)
+  {
+    return std::memcmp(&lhs, &rhs, sizeof(data::nav_t)) == 0;
+  }
+};
+
+TEST_F(KalmanFilterTest, reproducesRecordedOutputs)
+{
+  navigation::KalmanFilter filter;
+  filter.setup();
+  for (size_t i = 0; i < kNumInputs; ++i) {
+    if (i == kCalibrationInput) { filter.updateMeasurementCovarianceMatrix(kCalibrationVariance); }
+    const auto estimate = filter.filter(kInputs.at(i));
+    ASSERT_TRUE(isBitwiseEqual(kExpectedOutputs.at(i).estimate, estimate))
+      << "estimate " << i << ": expected " << kExpectedOutputs.at(i).estimate << ", got "
+      << estimate;
+    ASSERT_TRUE(isBitwiseEqual(kExpectedOutputs.at(i).variance, filter.getEstimateVariance()))
+      << "variance " << i << ": expected " << kExpectedOutputs.at(i).variance << ", got "
+      << filter.getEstimateVariance();
+  }
+}
+
+TEST_F(KalmanFilterTest, filterDoesNotAllocate)
+{
+  navigation::KalmanFilter filter;
+  filter.setup();
+  const uint64_t num_allocations_before = getNumAllocations();
+  for (const auto input : kInputs) {
+    filter.filter(input);
+  }
+  filter.updateMeasurementCovarianceMatrix(kCalibrationVariance);
+  filter.updateStateTransitionMatrix(0.001f);
+  ASSERT_EQ(num_allocations_before, getNumAllocations());
+}
+
+}  // namespace hyped::testing
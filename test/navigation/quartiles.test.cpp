@@ -0,0 +1,144 @@
+#include "allocations.hpp"
+#include "test.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <navigation/navigation.hpp>
+
+namespace hyped::testing {
+
+class QuartilesTest : public Test {
+ protected:
+  static constexpr std::size_t kNumSamples = 1000;
+  using QuartileBounds                     = navigation::Navigation::QuartileBounds;
+  using NavigationArray                    = navigation::Navigation::NavigationArray;
+  using EncoderArray                       = navigation::Navigation::EncoderArray;
+  using ImuMask                            = std::array<bool, data::Sensors::kNumImus>;
+  using EncoderMask                        = std::array<bool, data::Sensors::kNumEncoders>;
+
+  /**
+   * The previous implementation, which copied the reliable readings into a vector and sorted it.
+   */
+  template<typename T, std::size_t N>
+  static QuartileBounds referenceQuartiles(const std::array<T, N> &values,
+                                           const std::array<bool, N> &is_reliable)
+  {
+    std::vector<T> data_vector;
+    for (std::size_t i = 0; i < N; ++i) {
+      if (is_reliable.at(i)) { data_vector.push_back(values.at(i)); }
+    }
+    std::sort(data_vector.begin(), data_vector.end());
+    QuartileBounds quartile_bounds;
+    quartile_bounds.at(0) = (data_vector.at(0) + data_vector.at(1)) / 2.;
+    quartile_bounds.at(2)
+      = (data_vector.at(data_vector.size() - 2) + data_vector.at(data_vector.size() - 1)) / 2.;
+    if (data_vector.size() == N) {
+      quartile_bounds.at(1) = (data_vector.at(1) + data_vector.at(2)) / 2.;
+    } else {
+      quartile_bounds.at(1) = data_vector.at(1);
+    }
+    return quartile_bounds;
+  }
+
+  static NavigationArray randomAccelerations()
+  {
+    NavigationArray accelerations;
+    for (auto &acceleration : accelerations) {
+      acceleration = static_cast<data::nav_t>(rand() % 4000) / 100 - 20;
+    }
+    return accelerations;
+  }
+
+  static EncoderArray randomDisplacements()
+  {
+    EncoderArray displacements;
+    for (auto &displacement : displacements) {
+      displacement = static_cast<uint32_t>(rand() % 100000);
+    }
+    return displacements;
+  }
+
+  /**
+   * Keeps reporting a large outlier on the last IMU and encoder until both are deemed unreliable.
+   */
+  static void makeLastSensorsUnreliable(navigation::Navigation &navigation)
+  {
+    for (std::size_t i = 0; i <= 1000; ++i) {
+      NavigationArray accelerations = {1, 1, 1, 1000};
+      navigation.imuOutlierDetection(accelerations);
+      EncoderArray displacements = {1, 1, 1, 1000000};
+      navigation.wheelEncoderOutlierDetection(displacements);
+    }
+  }
+};
+
+TEST_F(QuartilesTest, matchesSortWithAllSensorsReliable)
+{
+  navigation::Navigation navigation;
+  const ImuMask is_imu_reliable         = {true, true, true, true};
+  const EncoderMask is_encoder_reliable = {true, true, true, true};
+  for (std::size_t i = 0; i < kNumSamples; ++i) {
+    const auto accelerations = randomAccelerations();
+    ASSERT_EQ(referenceQuartiles(accelerations, is_imu_reliable),
+              navigation.calculateImuQuartiles(accelerations));
+    const auto displacements = randomDisplacements();
+    ASSERT_EQ(referenceQuartiles(displacements, is_encoder_reliable),
+              navigation.calculateEncoderQuartiles(displacements));
+  }
+}
+
+TEST_F(QuartilesTest, matchesSortWithOneUnreliableSensor)
+{
+  navigation::Navigation navigation;
+  makeLastSensorsUnreliable(navigation);
+  const ImuMask is_imu_reliable         = {true, true, true, false};
+  const EncoderMask is_encoder_reliable = {true, true, true, false};
+  for (std::size_t i = 0; i < kNumSamples; ++i) {
+    const auto accelerations = randomAccelerations();
+    ASSERT_EQ(referenceQuartiles(accelerations, is_imu_reliable),
+              navigation.calculateImuQuartiles(accelerations));
+    const auto displacements = randomDisplacements();
+    ASSERT_EQ(referenceQuartiles(displacements, is_encoder_reliable),
+              navigation.calculateEncoderQuartiles(displacements));
+  }
+}
+
+TEST_F(QuartilesTest, failsWithFewerThanTwoReliableSensors)
+{
+  navigation::Navigation navigation;
+  auto &data = data::Data::getInstance();
+  // the first and last readings are outliers until they are deemed unreliable, after which the
+  // two remaining readings bound each other and are both outliers in turn
+  for (std::size_t i = 0; i <= 2002; ++i) {
+    NavigationArray accelerations = {0, 10, 20, 1000};
+    navigation.imuOutlierDetection(accelerations);
+    EncoderArray displacements = {0, 10, 20, std::numeric_limits<uint32_t>::max()};
+    navigation.wheelEncoderOutlierDetection(displacements);
+  }
+  ASSERT_EQ(data::ModuleStatus::kCriticalFailure, navigation.getModuleStatus());
+  ASSERT_EQ(data::ModuleStatus::kCriticalFailure, data.getNavigationData().module_status);
+  const QuartileBounds no_readings = {0, 0, 0};
+  ASSERT_EQ(no_readings, navigation.calculateImuQuartiles({1, 2, 3, 4}));
+  ASSERT_EQ(no_readings, navigation.calculateEncoderQuartiles({1, 2, 3, 4}));
+}
+
+TEST_F(QuartilesTest, outlierDetectionDoesNotAllocate)
+{
+  navigation::Navigation navigation;
+  const auto num_allocations_before = getNumAllocations();
+  for (std::size_t i = 0; i < kNumSamples; ++i) {
+    auto accelerations = randomAccelerations();
+    navigation.imuOutlierDetection(accelerations);
+    auto displacements = randomDisplacements();
+    navigation.wheelEncoderOutlierDetection(displacements);
+  }
+  ASSERT_EQ(num_allocations_before, getNumAllocations());
+}
+
+}  // namespace hyped::testing
@@ -0,0 +1,97 @@
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+
+#include <gtest/gtest.h>
+
+#include <navigation/vibration_statistics.hpp>
+
+namespace hyped::testing {
+
+class VibrationStatisticsTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kWindowSize = 50;
+  using Statistics                    = navigation::VibrationStatistics<kWindowSize>;
+  using ImuAxisData                   = Statistics::ImuAxisData;
+
+  static ImuAxisData randomReading()
+  {
+    ImuAxisData reading;
+    for (auto &axis : reading) {
+      for (auto &value : axis) {
+        value = static_cast<data::nav_t>(rand() % 2000) / 100 - 10;
+      }
+    }
+    return reading;
+  }
+
+  /**
+   * @brief Two-pass sample variance over the whole window, as computed before the statistics
+   *        were maintained incrementally.
+   */
+  static double bruteForceVariance(const std::deque<ImuAxisData> &window, const size_t axis)
+  {
+    double sum         = 0;
+    size_t num_samples = 0;
+    for (const auto &reading : window) {
+      for (const auto value : reading[axis]) {
+        sum += value;
+        ++num_samples;
+      }
+    }
+    const double mean  = sum / num_samples;
+    double squared_sum = 0;
+    for (const auto &reading : window) {
+      for (const auto value : reading[axis]) {
+        squared_sum += (value - mean) * (value - mean);
+      }
+    }
+    return squared_sum / (num_samples - 1);
+  }
+};
+
+TEST_F(VibrationStatisticsTest, fillsAfterWindowSizeUpdates)
+{
+  Statistics statistics;
+  for (size_t i = 0; i < kWindowSize - 1; ++i) {
+    statistics.update(randomReading());
+    ASSERT_FALSE(statistics.isFilled());
+  }
+  statistics.update(randomReading());
+  ASSERT_TRUE(statistics.isFilled());
+}
+
+TEST_F(VibrationStatisticsTest, constantSignalHasNoVariance)
+{
+  Statistics statistics;
+  ImuAxisData reading;
+  for (auto &axis : reading) {
+    axis.fill(9.81);
+  }
+  for (size_t i = 0; i < 3 * kWindowSize; ++i) {
+    statistics.update(reading);
+    for (size_t axis = 0; axis < 3; ++axis) {
+      ASSERT_FLOAT_EQ(0, statistics.getVariance(axis));
+    }
+  }
+}
+
+TEST_F(VibrationStatisticsTest, matchesBruteForceVariance)
+{
+  srand(time(0));
+  Statistics statistics;
+  std::deque<ImuAxisData> window;
+  for (size_t i = 0; i < 20 * kWindowSize; ++i) {
+    const auto reading = randomReading();
+    statistics.update(reading);
+    window.push_back(reading);
+    if (window.size() > kWindowSize) { window.pop_front(); }
+    if (window.size() < 2) { continue; }
+    for (size_t axis = 0; axis < 3; ++axis) {
+      const double expected = bruteForceVariance(window, axis);
+      ASSERT_NEAR(expected, statistics.getVariance(axis), 1e-4 * expected);
+    }
+  }
+}
+
+}  // namespace hyped::testing
@@ -0,0 +1,99 @@
+#include "test.hpp"
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <propulsion/can/sdo_client.hpp>
+
+namespace hyped::testing {
+
+class SdoClientTest : public Test {
+ protected:
+  static constexpr uint32_t kFirstCobId  = 0x581;
+  static constexpr uint32_t kSecondCobId = 0x582;
+
+  static utils::io::can::Frame makeFrame(const uint32_t id)
+  {
+    utils::io::can::Frame frame;
+    frame.id       = id;
+    frame.extended = false;
+    frame.len      = 8;
+    return frame;
+  }
+
+  static bool isReady(const std::future<bool> &future)
+  {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }
+
+  propulsion::SdoClient sdo_client_;
+};
+
+TEST_F(SdoClientTest, completesRequestOnResponse)
+{
+  auto response = sdo_client_.expectResponse(kFirstCobId);
+  ASSERT_TRUE(sdo_client_.isPending(kFirstCobId));
+  ASSERT_FALSE(isReady(response));
+  ASSERT_TRUE(sdo_client_.processResponse(makeFrame(kFirstCobId)));
+  ASSERT_FALSE(sdo_client_.isPending(kFirstCobId));
+  ASSERT_TRUE(isReady(response));
+  ASSERT_TRUE(response.get());
+}
+
+TEST_F(SdoClientTest, ignoresUnrelatedFrames)
+{
+  auto response = sdo_client_.expectResponse(kFirstCobId);
+  ASSERT_FALSE(sdo_client_.processResponse(makeFrame(kSecondCobId)));
+  ASSERT_TRUE(sdo_client_.isPending(kFirstCobId));
+  ASSERT_FALSE(isReady(response));
+}
+
+TEST_F(SdoClientTest, failsCancelledRequest)
+{
+  auto response = sdo_client_.expectResponse(kFirstCobId);
+  sdo_client_.cancel(kFirstCobId);
+  ASSERT_FALSE(sdo_client_.isPending(kFirstCobId));
+  ASSERT_TRUE(isReady(response));
+  ASSERT_FALSE(response.get());
+  ASSERT_FALSE(sdo_client_.processResponse(makeFrame(kFirstCobId)));
+}
+
+TEST_F(SdoClientTest, failsAbandonedRequest)
+{
+  auto first  = sdo_client_.expectResponse(kFirstCobId);
+  auto second = sdo_client_.expectResponse(kFirstCobId);
+  ASSERT_TRUE(isReady(first));
+  ASSERT_FALSE(first.get());
+  ASSERT_TRUE(sdo_client_.processResponse(makeFrame(kFirstCobId)));
+  ASSERT_TRUE(second.get());
+}
+
+TEST_F(SdoClientTest, completesNodesIndependently)
+{
+  auto first  = sdo_client_.expectResponse(kFirstCobId);
+  auto second = sdo_client_.expectResponse(kSecondCobId);
+  ASSERT_TRUE(sdo_client_.processResponse(makeFrame(kSecondCobId)));
+  ASSERT_TRUE(isReady(second));
+  ASSERT_FALSE(isReady(first));
+  ASSERT_TRUE(sdo_client_.isPending(kFirstCobId));
+  ASSERT_TRUE(sdo_client_.processResponse(makeFrame(kFirstCobId)));
+  ASSERT_TRUE(first.get());
+  ASSERT_TRUE(second.get());
+}
+
+TEST_F(SdoClientTest, completesRequestFromReceiveThread)
+{
+  auto response = sdo_client_.expectResponse(kFirstCobId);
+  std::thread receiver([this]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    sdo_client_.processResponse(makeFrame(kFirstCobId));
+  });
+  ASSERT_EQ(response.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  ASSERT_TRUE(response.get());
+  receiver.join();
+}
+
+}  // namespace hyped::testing
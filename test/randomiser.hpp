@@ -86,10 +86,11 @@ class Randomiser {
     for (size_t i = 0; i < 3; ++i) {
       imu_data.acc[i] = static_cast<data::nav_t>((rand() % 100 + 75) + randomDecimal());
     }
-    for (size_t i = 0; i < 3; ++i) {
-      imu_data.fifo.push_back(
-        static_cast<data::NavigationVector>((rand() % 100 + 75) + randomDecimal()));
+    imu_data.fifo_size = 3;
+    for (size_t i = 0; i < imu_data.fifo_size; ++i) {
+      imu_data.fifo[i] = static_cast<data::NavigationVector>((rand() % 100 + 75) + randomDecimal());
     }
+    imu_data.timestamp = static_cast<uint64_t>(rand() % 11);
   }
 
   // Randomises the entries in a hyped::data::StripeCounter struct.
@@ -0,0 +1,86 @@
+#include "test.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <sensors/bms.hpp>
+#include <utils/io/can.hpp>
+#include <utils/io/virtual_can_bus.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Tests which frames reach a HighPowerBms, with a node of a virtual bus standing in for the
+ * BMS unit. Nodes only accept the ids registered with their Can, so a registration that fails
+ * shows up as a frame that never arrives.
+ */
+class HighPowerBmsTest : public Test {
+ protected:
+  using Frame = utils::io::can::Frame;
+
+  // HighPowerBms ids are unique per process
+  static constexpr uint16_t kId = 1;
+
+  static Frame makeFrame(const uint32_t id, const bool extended)
+  {
+    Frame frame{};
+    frame.id       = id;
+    frame.extended = extended;
+    frame.len      = 8;
+    return frame;
+  }
+
+  template<typename Condition>
+  static bool waitFor(Condition condition)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!condition()) {
+      if (std::chrono::steady_clock::now() > deadline) { return false; }
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return true;
+  }
+
+  utils::io::can::VirtualBus bus_;
+};
+
+TEST_F(HighPowerBmsTest, receivesEveryRegisteredId)
+{
+  utils::io::Can can(bus_.attach());
+  auto unit = bus_.attach();
+  sensors::HighPowerBms bms(kId, can, log_);
+
+  const uint32_t can_id        = kId * 2 + sensors::bms::kHPBase;
+  const uint32_t thermistor_id = static_cast<uint32_t>(kId + sensors::bms::kThermistorBase);
+  std::vector<Frame> frames;
+  for (const uint32_t id : {can_id, can_id + 1, kId + sensors::bms::kCellBase + 0U, 0x7E4U, 0x6D0U,
+                            0x7ECU, 0x70U, 0x80U, 0x6B4U, 0x6B5U}) {
+    frames.push_back(makeFrame(id, false));
+  }
+  for (const uint32_t id : {0x1838F380U, 0x18EEFF80U, 0x1838F381U, 0x18EEFF81U}) {
+    frames.push_back(makeFrame(id, true));
+  }
+  Frame thermistor   = makeFrame(thermistor_id, true);
+  thermistor.data[1] = 21;
+  thermistor.data[2] = 35;
+  thermistor.data[3] = 28;
+  frames.push_back(thermistor);
+  // the same id as a standard frame is not the thermistor module
+  frames.push_back(makeFrame(thermistor_id & utils::io::can::IdRange::kMaxStandardId, false));
+  ASSERT_EQ(unit->send(frames.data(), frames.size()), frames.size());
+
+  // the thermistor frame is the last one that passes the filters of the node
+  ASSERT_TRUE(waitFor([&] { return bms.getData().average_temperature == 28; }));
+  ASSERT_EQ(can.getStatistics().num_frames_received, frames.size() - 1);
+  ASSERT_EQ(bus_.getNumDropped(), 0u);
+  const auto battery_data = bms.getData();
+  ASSERT_EQ(battery_data.low_temperature, 21);
+  ASSERT_EQ(battery_data.high_temperature, 35);
+  ASSERT_EQ(battery_data.average_temperature, 28);
+  ASSERT_TRUE(bms.isOnline());
+}
+
+}  // namespace hyped::testing
@@ -1,8 +1,14 @@
+#include "allocations.hpp"
 #include "test.hpp"
 
 #include <gtest/gtest.h>
 
+#include <data/data.hpp>
+#include <navigation/navigation.hpp>
+#include <sensors/fake_imu.hpp>
 #include <sensors/imu_manager.hpp>
+#include <utils/concurrent/thread.hpp>
+#include <utils/timer.hpp>
 
 namespace hyped::testing {
 
@@ -32,4 +38,98 @@ TEST_F(ImuManagerTest, fakeImusFromFile)
   }
 }
 
+TEST_F(ImuManagerTest, imuTickDoesNotAllocate)
+{
+  const auto fake_trajectory = std::make_shared<sensors::FakeTrajectory>(
+    *sensors::FakeTrajectory::fromFile(kDefaultConfigPath));
+  auto imu_manager = sensors::ImuManager::fromFile(kDefaultConfigPath, fake_trajectory);
+  ASSERT_TRUE(imu_manager);
+  auto &data = data::Data::getInstance();
+  // one tick of the IMU path: sample every IMU, publish, and read back as navigation does
+  const auto tick = [&]() {
+    const auto imu_data = imu_manager->sample();
+    data.setSensorsImuData(imu_data);
+    const auto read_imu_data = data.getSensorsImuData();
+    const auto sensors_data  = data.getSensorsData();
+    ASSERT_EQ(imu_data.timestamp, read_imu_data.timestamp);
+    ASSERT_EQ(imu_data.timestamp, sensors_data.imu.timestamp);
+    for (size_t i = 0; i < data::Sensors::kNumImus; ++i) {
+      ASSERT_EQ(imu_data.value[i].timestamp, read_imu_data.value[i].timestamp);
+    }
+  };
+  // the first tick may initialise function-local statics
+  tick();
+  const uint64_t num_allocations_before = getNumAllocations();
+  for (size_t i = 0; i < 100; ++i) {
+    tick();
+  }
+  ASSERT_EQ(num_allocations_before, getNumAllocations());
+}
+
+TEST_F(ImuManagerTest, navigationTickDoesNotAllocate)
+{
+  const auto fake_trajectory = std::make_shared<sensors::FakeTrajectory>(
+    *sensors::FakeTrajectory::fromFile(kDefaultConfigPath));
+  auto imu_manager = sensors::ImuManager::fromFile(kDefaultConfigPath, fake_trajectory);
+  ASSERT_TRUE(imu_manager);
+  auto &data = data::Data::getInstance();
+  navigation::Navigation navigation;
+  navigation.initialiseTimestamps();
+  navigation.setHasInit();
+  // one tick from sampling the IMUs to navigation publishing its estimates, as navigation::Main
+  // runs it while accelerating
+  const auto tick = [&]() {
+    data.setSensorsImuData(imu_manager->sample());
+    navigation.navigate();
+  };
+  // the first tick may initialise function-local statics and output buffers
+  tick();
+  const uint64_t num_allocations_before = getNumAllocations();
+  for (size_t i = 0; i < 100; ++i) {
+    tick();
+  }
+  ASSERT_EQ(num_allocations_before, getNumAllocations());
+}
+
+/**
+ * IMU whose reads take a fixed amount of time, standing in for the SPI transfer of a real IMU.
+ */
+class SlowImu : public sensors::IImu {
+ public:
+  explicit SlowImu(const uint64_t read_micros) : read_micros_(read_micros) {}
+  bool isOnline() override { return true; }
+  data::ImuData getData() override
+  {
+    utils::concurrent::Thread::sleep(static_cast<uint32_t>(read_micros_ / 1000));
+    data::ImuData imu_data;
+    imu_data.operational = true;
+    return imu_data;
+  }
+
+ private:
+  const uint64_t read_micros_;
+};
+
+TEST_F(ImuManagerTest, stampsEachImuIndividually)
+{
+  static constexpr uint64_t kReadMicros = 2000;
+  std::array<std::unique_ptr<sensors::IImu>, data::Sensors::kNumImus> imus;
+  for (auto &imu : imus) {
+    imu = std::make_unique<SlowImu>(kReadMicros);
+  }
+  sensors::ImuManager imu_manager(std::move(imus));
+  const uint64_t sample_start = utils::Timer::getTimeMicros();
+  const auto imu_data         = imu_manager.sample();
+  const uint64_t sample_end   = utils::Timer::getTimeMicros();
+  for (size_t i = 0; i < data::Sensors::kNumImus; ++i) {
+    const uint64_t timestamp = imu_data.value[i].timestamp;
+    // the midpoint of the i-th read lies after the i preceding reads and half of its own
+    ASSERT_GE(timestamp, sample_start + i * kReadMicros + kReadMicros / 2);
+    ASSERT_LE(timestamp, sample_end);
+    if (i > 0) { ASSERT_GE(timestamp, imu_data.value[i - 1].timestamp + kReadMicros); }
+  }
+  // the point itself is as recent as its most recent reading
+  ASSERT_EQ(imu_data.value[data::Sensors::kNumImus - 1].timestamp, imu_data.timestamp);
+}
+
 }  // namespace hyped::testing
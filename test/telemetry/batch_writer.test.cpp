@@ -0,0 +1,129 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <data/data.hpp>
+#include <telemetry/batch_decoder.hpp>
+#include <telemetry/batch_writer.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Tests that batches of the high rate channel carry every sample and how compact they are
+ */
+class BatchWriterTest : public ::testing::Test {
+ protected:
+  static constexpr std::size_t kBatchSize = 10;
+  static constexpr uint64_t kPeriodMicros = 2500;
+
+  // IMUs that vibrate around gravity, encoders that count up and cells that barely change
+  static telemetry::binary::Row makeRow(const std::size_t sample)
+  {
+    telemetry::binary::Row row;
+    for (std::size_t column = 0; column < row.size(); ++column) {
+      row[column] = 3700;
+    }
+    for (std::size_t i = 0; i < data::Sensors::kNumImus * 3; ++i) {
+      const int64_t vibration = static_cast<int64_t>((sample * 7 + i * 13) % 41) - 20;
+      row[telemetry::binary::kImuAcceleration + i] = (i % 3 == 2 ? 9810 : 0) + vibration;
+    }
+    for (std::size_t i = 0; i < data::Sensors::kNumEncoders; ++i) {
+      row[telemetry::binary::kEncoderCounts + i] = static_cast<int64_t>(sample / 4 + i);
+    }
+    row[telemetry::binary::kCellVoltages + 5] = sample < 5 ? 3700 : 3699;
+    return row;
+  }
+
+  static std::vector<uint8_t> copyFrame(const telemetry::BatchWriter &writer)
+  {
+    return std::vector<uint8_t>(writer.getData(), writer.getData() + writer.getSize());
+  }
+};
+
+TEST_F(BatchWriterTest, describesColumns)
+{
+  telemetry::BatchWriter writer(kBatchSize);
+  writer.packColumns();
+  telemetry::BatchDecoder decoder;
+  ASSERT_TRUE(decoder.decode(writer.getData(), writer.getSize()));
+  ASSERT_EQ(telemetry::binary::FrameType::kColumns, decoder.getFrameType());
+  ASSERT_EQ(static_cast<std::size_t>(telemetry::binary::kNumColumns), decoder.getColumns().size());
+  ASSERT_EQ(telemetry::binary::kImuAcceleration + 5, decoder.findColumn("/sensors/imu/1/acc/z"));
+  ASSERT_EQ(telemetry::binary::kEncoderCounts + 3, decoder.findColumn("/sensors/wheel_encoders/3"));
+  const auto cell = decoder.findColumn("/sensors/hp_batteries/0/cell_voltage/35");
+  ASSERT_TRUE(cell);
+  ASSERT_EQ("mV", decoder.getColumns()[*cell].unit);
+  ASSERT_FALSE(decoder.findColumn("/sensors/imu/4/acc/x"));
+}
+
+TEST_F(BatchWriterTest, carriesEverySample)
+{
+  telemetry::BatchWriter writer(kBatchSize);
+  telemetry::BatchDecoder decoder;
+  for (uint32_t id = 0; id < 3; ++id) {
+    for (std::size_t i = 0; i < kBatchSize; ++i) {
+      const std::size_t sample = id * kBatchSize + i;
+      ASSERT_EQ(i + 1 == kBatchSize, writer.addRow(sample * kPeriodMicros, makeRow(sample)));
+    }
+    writer.packBatch(id);
+    ASSERT_EQ(0u, writer.getNumRows());
+    ASSERT_TRUE(decoder.decode(writer.getData(), writer.getSize()));
+    ASSERT_EQ(telemetry::binary::FrameType::kBatch, decoder.getFrameType());
+    ASSERT_EQ(id, decoder.getId());
+    ASSERT_EQ(kBatchSize, decoder.getNumRows());
+    for (std::size_t i = 0; i < kBatchSize; ++i) {
+      const std::size_t sample = id * kBatchSize + i;
+      ASSERT_EQ(sample * kPeriodMicros, decoder.getTime(i));
+      const auto row = makeRow(sample);
+      for (std::size_t column = 0; column < row.size(); ++column) {
+        ASSERT_EQ(row[column], decoder.getValue(i, column)) << "sample " << sample;
+      }
+    }
+  }
+}
+
+TEST_F(BatchWriterTest, compressesSlowColumns)
+{
+  telemetry::BatchWriter writer(kBatchSize);
+  for (std::size_t i = 0; i < kBatchSize; ++i) {
+    writer.addRow(i * kPeriodMicros, makeRow(i));
+  }
+  writer.packBatch(0);
+  // vibrating IMUs need a byte per sample, but unchanged columns only take their encoding and
+  // value, so a batch takes less than half of the samples at two bytes per value
+  const std::size_t imu_bytes = data::Sensors::kNumImus * 3 * (1 + 2 + (kBatchSize - 1));
+  ASSERT_LT(writer.getSize(), imu_bytes + (telemetry::binary::kNumColumns * 4));
+  ASSERT_LT(writer.getSize() * 2, kBatchSize * telemetry::binary::kNumColumns * 2);
+}
+
+TEST_F(BatchWriterTest, handlesPartialBatches)
+{
+  telemetry::BatchWriter writer(kBatchSize);
+  telemetry::BatchDecoder decoder;
+  writer.addRow(1000, makeRow(0));
+  writer.addRow(500, makeRow(1));
+  writer.packBatch(1);
+  ASSERT_TRUE(decoder.decode(writer.getData(), writer.getSize()));
+  ASSERT_EQ(2u, decoder.getNumRows());
+  // timestamps that wrap around go backwards
+  ASSERT_EQ(500u, decoder.getTime(1));
+  const auto frame = copyFrame(writer);
+
+  writer.packBatch(2);
+  ASSERT_TRUE(decoder.decode(writer.getData(), writer.getSize()));
+  ASSERT_EQ(0u, decoder.getNumRows());
+
+  // cut short, or with more rows than the writer would ever send after the one byte id
+  ASSERT_FALSE(decoder.decode(frame.data(), frame.size() - 1));
+  auto corrupt   = frame;
+  corrupt.back() = 0x80;
+  ASSERT_FALSE(decoder.decode(corrupt.data(), corrupt.size()));
+  const std::size_t num_rows_offset = telemetry::binary::kHeaderSize + 1;
+  corrupt                           = frame;
+  corrupt[num_rows_offset]          = telemetry::binary::kMaxBatchSize + 1;
+  ASSERT_FALSE(decoder.decode(corrupt.data(), corrupt.size()));
+  ASSERT_EQ(2u, decoder.getId());
+}
+
+}  // namespace hyped::testing
@@ -0,0 +1,132 @@
+#include "telemetry_run.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <telemetry/binary_decoder.hpp>
+#include <telemetry/binary_writer.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Tests that delta frames reconstruct the full state and how much they save over full frames
+ */
+class BinaryDeltaTest : public ::testing::Test {
+ protected:
+  static constexpr uint32_t kRateHz           = 100;
+  static constexpr uint32_t kKeyframeInterval = 100;
+
+  static telemetry::binary::Values makeValues(const int64_t offset)
+  {
+    telemetry::binary::Values values;
+    for (std::size_t field = 0; field < values.size(); ++field) {
+      values[field] = static_cast<int64_t>(field) + offset;
+    }
+    return values;
+  }
+
+  static std::vector<uint8_t> copyFrame(const telemetry::BinaryWriter &writer)
+  {
+    return std::vector<uint8_t>(writer.getData(), writer.getData() + writer.getSize());
+  }
+};
+
+TEST_F(BinaryDeltaTest, sendsOnlyChangedFields)
+{
+  telemetry::BinaryWriter writer;
+  telemetry::BinaryDecoder decoder;
+  auto values = makeValues(0);
+  // without a previous frame there is nothing to refer to
+  writer.packDelta(7, 1000, values);
+  ASSERT_TRUE(decoder.decode(writer.getData(), writer.getSize()));
+  ASSERT_EQ(telemetry::binary::FrameType::kFull, decoder.getFrameType());
+
+  values[telemetry::binary::kVelocity]     = -3;
+  values[telemetry::binary::kCurrentState] = 1000;
+  writer.packDelta(8, 1010, values);
+  // header, one byte each for id and elapsed time, then the two fields, the second of which needs
+  // two bytes for its value
+  ASSERT_EQ(telemetry::binary::kHeaderSize + 2 + 2 + 3, writer.getSize());
+  ASSERT_TRUE(decoder.decode(writer.getData(), writer.getSize()));
+  ASSERT_EQ(telemetry::binary::FrameType::kDelta, decoder.getFrameType());
+  ASSERT_EQ(8u, decoder.getId());
+  ASSERT_EQ(1010u, decoder.getTime());
+  ASSERT_TRUE(std::equal(values.begin(), values.end(), decoder.getValues().begin()));
+
+  // nothing changed
+  writer.packDelta(9, 1020, values);
+  ASSERT_EQ(telemetry::binary::kHeaderSize + 2, writer.getSize());
+  ASSERT_TRUE(decoder.decode(writer.getData(), writer.getSize()));
+  ASSERT_TRUE(std::equal(values.begin(), values.end(), decoder.getValues().begin()));
+
+  // time going backwards cannot be expressed relative to the previous frame
+  writer.packDelta(10, 500, values);
+  ASSERT_TRUE(decoder.decode(writer.getData(), writer.getSize()));
+  ASSERT_EQ(telemetry::binary::FrameType::kFull, decoder.getFrameType());
+  ASSERT_EQ(500u, decoder.getTime());
+}
+
+TEST_F(BinaryDeltaTest, resynchronisesOnKeyframe)
+{
+  telemetry::BinaryWriter writer;
+  telemetry::BinaryDecoder decoder;
+  writer.packFull(0, 0, makeValues(0));
+  const auto keyframe = copyFrame(writer);
+  writer.packDelta(1, 10, makeValues(1));
+  const auto first_delta = copyFrame(writer);
+  writer.packDelta(2, 20, makeValues(2));
+  const auto second_delta = copyFrame(writer);
+  writer.packFull(3, 30, makeValues(3));
+  const auto next_keyframe = copyFrame(writer);
+
+  // a delta needs the state it refers to
+  ASSERT_FALSE(decoder.decode(first_delta.data(), first_delta.size()));
+  ASSERT_FALSE(decoder.hasState());
+  ASSERT_TRUE(decoder.decode(keyframe.data(), keyframe.size()));
+  ASSERT_TRUE(decoder.hasState());
+  // skipping a delta loses the state until the next keyframe
+  ASSERT_FALSE(decoder.decode(second_delta.data(), second_delta.size()));
+  ASSERT_FALSE(decoder.hasState());
+  ASSERT_EQ(0, decoder.getValue(telemetry::binary::kCalibrate));
+  ASSERT_FALSE(decoder.decode(first_delta.data(), first_delta.size()));
+  ASSERT_TRUE(decoder.decode(next_keyframe.data(), next_keyframe.size()));
+  ASSERT_EQ(3, decoder.getValue(telemetry::binary::kCalibrate));
+}
+
+TEST_F(BinaryDeltaTest, replaysRun)
+{
+  TelemetryRun run(kRateHz);
+  telemetry::BinaryWriter full_writer;
+  telemetry::BinaryWriter delta_writer;
+  telemetry::BinaryDecoder decoder;
+  std::size_t full_bytes  = 0;
+  std::size_t delta_bytes = 0;
+  uint32_t id             = 0;
+  for (; !run.isFinished(); run.step(), ++id) {
+    full_writer.packFull(id, run.getTimeMillis(), run.getValues());
+    full_bytes += full_writer.getSize();
+    if (id % kKeyframeInterval == 0) {
+      delta_writer.packFull(id, run.getTimeMillis(), run.getValues());
+    } else {
+      delta_writer.packDelta(id, run.getTimeMillis(), run.getValues());
+    }
+    delta_bytes += delta_writer.getSize();
+    ASSERT_TRUE(decoder.decode(delta_writer.getData(), delta_writer.getSize()));
+    ASSERT_EQ(id, decoder.getId());
+    ASSERT_EQ(run.getTimeMillis(), decoder.getTime());
+    ASSERT_TRUE(std::equal(run.getValues().begin(), run.getValues().end(),
+                           decoder.getValues().begin()))
+      << "state differs at packet " << id;
+  }
+  // the run goes through every state
+  ASSERT_EQ(static_cast<int64_t>(data::State::kFinished),
+            decoder.getValue(telemetry::binary::kCurrentState));
+  ASSERT_GT(id, 30 * kRateHz);
+  // at 100 Hz, deltas need less than a third of the bandwidth of full frames
+  ASSERT_LT(delta_bytes * 3, full_bytes);
+}
+
+}  // namespace hyped::testing
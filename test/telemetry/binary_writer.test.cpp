@@ -0,0 +1,225 @@
+#include "randomiser.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+#include <rapidjson/pointer.h>
+
+#include <data/data.hpp>
+#include <telemetry/binary_decoder.hpp>
+#include <telemetry/binary_writer.hpp>
+#include <telemetry/writer.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Tests that binary frames carry the same values as the JSON packets
+ */
+class BinaryWriterTest : public ::testing::Test {
+ protected:
+  static constexpr uint32_t kId = 300;
+
+  void SetUp()
+  {
+    data::Navigation nav_data = data_.getNavigationData();
+    Randomiser::randomiseNavigation(nav_data);
+    nav_data.displacement = -12.5;
+    data_.setNavigationData(nav_data);
+
+    data::Sensors sensors_data = data_.getSensorsData();
+    Randomiser::randomiseSensorsData(sensors_data);
+    sensors_data.temperature.temperature           = -5;
+    sensors_data.ambient_pressure.ambient_pressure = 1013;
+    data_.setSensorsData(sensors_data);
+
+    data::FullBatteryData batteries_data = data_.getBatteriesData();
+    Randomiser::randomiseBatteriesData(batteries_data);
+    data_.setBatteriesData(batteries_data);
+
+    data::Brakes brakes_data = data_.getBrakesData();
+    Randomiser::randomiseBrakes(brakes_data);
+    data_.setBrakesData(brakes_data);
+
+    data::Motors motors_data = data_.getMotorData();
+    Randomiser::randomiseMotors(motors_data);
+    motors_data.rpms[0] = 6000;
+    data_.setMotorData(motors_data);
+
+    data::Telemetry telemetry_data = data_.getTelemetryData();
+    Randomiser::randomiseTelemetry(telemetry_data);
+    data_.setTelemetryData(telemetry_data);
+
+    data::StateMachine state_machine_data = data_.getStateMachineData();
+    Randomiser::randomiseStateMachine(state_machine_data);
+    state_machine_data.current_state = data::State::kCruising;
+    data_.setStateMachineData(state_machine_data);
+  }
+
+  std::string packJson()
+  {
+    telemetry::Writer writer;
+    writer.start();
+    writer.packTime();
+    writer.packId(kId);
+    writer.packTelemetryData();
+    writer.packSensorsData();
+    writer.packMotorData();
+    writer.packStateMachineData();
+    writer.packNavigationData();
+    writer.end();
+    return writer.getString();
+  }
+
+  data::Data &data_ = data::Data::getInstance();
+};
+
+TEST_F(BinaryWriterTest, matchesJsonPacket)
+{
+  const std::string json = packJson();
+  telemetry::BinaryWriter writer;
+  writer.packFull(kId);
+  telemetry::BinaryDecoder decoder;
+  ASSERT_TRUE(decoder.decode(writer.getData(), writer.getSize()));
+  ASSERT_EQ(telemetry::binary::FrameType::kFull, decoder.getFrameType());
+  ASSERT_EQ(kId, decoder.getId());
+
+  rapidjson::Document document;
+  document.Parse(json.c_str());
+  ASSERT_FALSE(document.HasParseError());
+  ASSERT_NEAR(document["time"].GetUint64(), decoder.getTime(), 1000);
+  const auto &schema = decoder.getSchema();
+  ASSERT_EQ(telemetry::binary::kNumFields, schema.size());
+  for (std::size_t field = 0; field < schema.size(); ++field) {
+    const rapidjson::Value *value = rapidjson::Pointer(schema[field].name.c_str()).Get(document);
+    ASSERT_NE(nullptr, value) << schema[field].name << " is not in the JSON packet";
+    const int64_t decoded = decoder.getValue(field);
+    switch (schema[field].type) {
+      case telemetry::binary::FieldType::kBool:
+        ASSERT_EQ(value->GetBool(), decoded != 0) << schema[field].name;
+        break;
+      case telemetry::binary::FieldType::kInt:
+        ASSERT_EQ(value->GetInt64(), decoded) << schema[field].name;
+        break;
+      case telemetry::binary::FieldType::kModuleStatus:
+        ASSERT_EQ(value->GetString(), telemetry::Writer::convertModuleStatus(
+                                        static_cast<data::ModuleStatus>(decoded)))
+          << schema[field].name;
+        break;
+      case telemetry::binary::FieldType::kState:
+        ASSERT_EQ(value->GetString(),
+                  telemetry::Writer::convertStateMachineState(static_cast<data::State>(decoded)))
+          << schema[field].name;
+        break;
+    }
+  }
+  ASSERT_EQ(-12, *decoder.getValue("/navigation/displacement"));
+  ASSERT_EQ(1013, *decoder.getValue("/sensors/pressure"));
+  ASSERT_FALSE(decoder.getValue("/sensors/imu"));
+  // an order of magnitude smaller than the same packet as JSON
+  ASSERT_LT(writer.getSize() * 10, json.size());
+}
+
+TEST_F(BinaryWriterTest, describesSchema)
+{
+  telemetry::BinaryWriter writer;
+  writer.packSchema();
+  telemetry::BinaryDecoder decoder;
+  ASSERT_TRUE(decoder.decode(writer.getData(), writer.getSize()));
+  ASSERT_EQ(telemetry::binary::FrameType::kSchema, decoder.getFrameType());
+  const auto &expected = telemetry::binary::getSchema();
+  const auto &actual   = decoder.getSchema();
+  ASSERT_EQ(expected.size(), actual.size());
+  for (std::size_t field = 0; field < expected.size(); ++field) {
+    ASSERT_EQ(expected[field].name, actual[field].name);
+    ASSERT_EQ(expected[field].type, actual[field].type);
+  }
+}
+
+TEST_F(BinaryWriterTest, rejectsMalformedFrames)
+{
+  telemetry::BinaryWriter writer;
+  writer.packFull(kId);
+  std::vector<uint8_t> frame(writer.getData(), writer.getData() + writer.getSize());
+  telemetry::BinaryDecoder decoder;
+  ASSERT_TRUE(decoder.decode(frame.data(), frame.size()));
+  const auto values = decoder.getValues();
+
+  // too short for its header
+  ASSERT_FALSE(decoder.decode(frame.data(), frame.size() - 1));
+  ASSERT_FALSE(decoder.decode(frame.data(), 3));
+  auto corrupt = frame;
+  corrupt[0]   = 'X';
+  ASSERT_FALSE(decoder.decode(corrupt.data(), corrupt.size()));
+  corrupt    = frame;
+  corrupt[2] = telemetry::binary::kVersion + 1;
+  ASSERT_FALSE(decoder.decode(corrupt.data(), corrupt.size()));
+  // a varint cut off by the end of the frame
+  corrupt        = frame;
+  corrupt.back() = 0x80;
+  ASSERT_FALSE(decoder.decode(corrupt.data(), corrupt.size()));
+  ASSERT_EQ(values, decoder.getValues());
+}
+
+TEST_F(BinaryWriterTest, skipsUnknownFields)
+{
+  telemetry::binary::Values values;
+  for (std::size_t field = 0; field < values.size(); ++field) {
+    values[field] = static_cast<int64_t>(field) - 20;
+  }
+  // as sent by a pod with one more field in its schema
+  std::vector<uint8_t> frame(telemetry::binary::kMagic.begin(), telemetry::binary::kMagic.end());
+  frame.push_back(telemetry::binary::kVersion);
+  frame.push_back(static_cast<uint8_t>(telemetry::binary::FrameType::kFull));
+  frame.resize(telemetry::binary::kHeaderSize);
+  telemetry::binary::appendVarint(frame, kId);
+  telemetry::binary::appendVarint(frame, 1234);
+  telemetry::binary::appendVarint(frame, values.size() + 1);
+  for (const int64_t value : values) {
+    telemetry::binary::appendVarint(frame, telemetry::binary::zigzagEncode(value));
+  }
+  telemetry::binary::appendVarint(frame, telemetry::binary::zigzagEncode(-1));
+  frame[4] = static_cast<uint8_t>(frame.size());
+  frame[5] = static_cast<uint8_t>(frame.size() >> 8);
+
+  telemetry::BinaryDecoder decoder;
+  ASSERT_TRUE(decoder.decode(frame.data(), frame.size()));
+  ASSERT_EQ(1234u, decoder.getTime());
+  ASSERT_EQ(values.size(), decoder.getValues().size());
+  for (std::size_t field = 0; field < values.size(); ++field) {
+    ASSERT_EQ(values[field], decoder.getValue(field));
+  }
+
+  // the same values through the writer
+  telemetry::BinaryWriter writer;
+  writer.packFull(kId, 1234, values);
+  ASSERT_EQ(frame.size() - 1, writer.getSize());
+}
+
+TEST_F(BinaryWriterTest, encodesVarints)
+{
+  const std::vector<int64_t> small = {0, -1, 1, 63, -64};
+  const std::vector<int64_t> large = {64, INT32_MIN, INT64_MAX, INT64_MIN};
+  std::vector<uint8_t> buffer;
+  for (const int64_t value : small) {
+    telemetry::binary::appendVarint(buffer, telemetry::binary::zigzagEncode(value));
+  }
+  ASSERT_EQ(small.size(), buffer.size());
+  for (const int64_t value : large) {
+    telemetry::binary::appendVarint(buffer, telemetry::binary::zigzagEncode(value));
+  }
+  const uint8_t *position = buffer.data();
+  const uint8_t *end      = buffer.data() + buffer.size();
+  for (const auto &values : {small, large}) {
+    for (const int64_t value : values) {
+      uint64_t encoded;
+      ASSERT_TRUE(telemetry::binary::readVarint(position, end, encoded));
+      ASSERT_EQ(value, telemetry::binary::zigzagDecode(encoded));
+    }
+  }
+  ASSERT_EQ(end, position);
+}
+
+}  // namespace hyped::testing
@@ -0,0 +1,124 @@
+#include "allocations.hpp"
+#include "loopback_client.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <data/data.hpp>
+#include <telemetry/batch_decoder.hpp>
+#include <telemetry/binary_decoder.hpp>
+#include <telemetry/client.hpp>
+#include <telemetry/high_rate_sender.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Tests the batches the HighRateSender puts on the wire, with a loopback server as the ground
+ * station
+ */
+class HighRateSenderTest : public LoopbackClientTest {
+ protected:
+  static constexpr uint32_t kBatchSize    = 5;
+  static constexpr uint32_t kDecimation   = 2;
+  static constexpr uint32_t kPeriodMicros = 1000;
+  static constexpr uint64_t kStartMicros  = 1000000;
+  // after more than 71 minutes, timestamps no longer fit 32 bits
+  static constexpr uint64_t kLateStartMicros = (uint64_t{1} << 32) + 1000000;
+
+  // a client with the high rate channel enabled
+  telemetry::Client *connect()
+  {
+    telemetry::Client::Config config;
+    config.high_rate.enabled    = true;
+    config.high_rate.batch_size = kBatchSize;
+    config.high_rate.decimation = kDecimation;
+    return LoopbackClientTest::connect(config);
+  }
+
+  // a new sample of every IMU, as the ImuManager would set it
+  void setImuSample(const uint32_t sample, const uint64_t start_micros = kStartMicros)
+  {
+    auto imu_data      = data_.getSensorsImuData();
+    imu_data.timestamp = start_micros + sample * kPeriodMicros;
+    for (std::size_t i = 0; i < data::Sensors::kNumImus; ++i) {
+      imu_data.value[i].acc[0] = 0.001 * sample;
+      imu_data.value[i].acc[1] = -0.5;
+      imu_data.value[i].acc[2] = 9.81;
+    }
+    data_.setSensorsImuData(imu_data);
+  }
+
+  bool receiveFrame(telemetry::BatchDecoder &decoder)
+  {
+    std::vector<uint8_t> frame(telemetry::binary::kHeaderSize);
+    if (!server_.receive(frame.data(), frame.size())) { return false; }
+    const auto size = telemetry::BinaryDecoder::getFrameSize(frame.data(), frame.size());
+    if (!size) { return false; }
+    frame.resize(*size);
+    return server_.receive(frame.data() + telemetry::binary::kHeaderSize,
+                           *size - telemetry::binary::kHeaderSize)
+           && decoder.decode(frame.data(), frame.size());
+  }
+
+  data::Data &data_ = data::Data::getInstance();
+};
+
+TEST_F(HighRateSenderTest, sendsDecimatedBatches)
+{
+  auto client = connect();
+  ASSERT_TRUE(client);
+  telemetry::BatchDecoder decoder;
+  for (const uint64_t start_micros : {kStartMicros, kLateStartMicros}) {
+    setImuSample(0, start_micros);
+    telemetry::HighRateSender sender(data_, *client);
+    ASSERT_TRUE(sender.sendColumns());
+    ASSERT_TRUE(receiveFrame(decoder));
+    ASSERT_EQ(telemetry::binary::FrameType::kColumns, decoder.getFrameType());
+
+    // encoder updates alone do not make a sample
+    auto encoders     = data_.getSensorsWheelEncoderData();
+    encoders[2].value = 42;
+    data_.setSensorsWheelEncoderData(encoders);
+    ASSERT_TRUE(sender.sample());
+    for (uint32_t sample = 1; sample <= 2 * kBatchSize * kDecimation; ++sample) {
+      setImuSample(sample, start_micros);
+      ASSERT_TRUE(sender.sample());
+      ASSERT_TRUE(sender.sample());
+    }
+    for (uint32_t id = 0; id < 2; ++id) {
+      ASSERT_TRUE(receiveFrame(decoder));
+      ASSERT_EQ(telemetry::binary::FrameType::kBatch, decoder.getFrameType());
+      ASSERT_EQ(id, decoder.getId());
+      ASSERT_EQ(kBatchSize, decoder.getNumRows());
+      for (std::size_t row = 0; row < kBatchSize; ++row) {
+        // every other sample, starting with the first new one
+        const uint32_t sample = 1 + (id * kBatchSize + row) * kDecimation;
+        ASSERT_EQ(start_micros + sample * kPeriodMicros, decoder.getTime(row));
+        ASSERT_EQ(sample, decoder.getValue(row, telemetry::binary::kImuAcceleration));
+        ASSERT_EQ(-500, decoder.getValue(row, telemetry::binary::kImuAcceleration + 1));
+        ASSERT_EQ(9810, decoder.getValue(row, telemetry::binary::kImuAcceleration + 11));
+        ASSERT_EQ(42, decoder.getValue(row, telemetry::binary::kEncoderCounts + 2));
+      }
+    }
+  }
+}
+
+TEST_F(HighRateSenderTest, samplesWithoutAllocating)
+{
+  auto client = connect();
+  ASSERT_TRUE(client);
+  telemetry::HighRateSender sender(data_, *client);
+  ASSERT_TRUE(sender.sendColumns());
+  server_.drain();
+  const uint64_t num_allocations_before = getNumAllocations();
+  for (uint32_t sample = 1; sample <= 10 * kBatchSize * kDecimation; ++sample) {
+    setImuSample(sample);
+    ASSERT_TRUE(sender.sample());
+    server_.drain();
+  }
+  ASSERT_EQ(num_allocations_before, getNumAllocations());
+}
+
+}  // namespace hyped::testing
@@ -0,0 +1,118 @@
+#include "loopback_client.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <telemetry/client.hpp>
+#include <utils/concurrent/thread.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Tests reading and writing of the I/O thread against a loopback server standing in for the
+ * ground station
+ */
+class IoThreadTest : public LoopbackClientTest {
+ protected:
+  static constexpr uint32_t kQueueCapacity = 8;
+  static constexpr uint32_t kTimeoutMillis = 1000;
+  static constexpr std::size_t kFrameSize  = 4096;
+
+  bool sendFromServer(const std::string &data)
+  {
+    return server_.send(std::vector<uint8_t>(data.begin(), data.end()));
+  }
+
+  // a frame of the stall test, carrying its index in the first bytes
+  static std::vector<uint8_t> makeFrame(const uint32_t index)
+  {
+    std::vector<uint8_t> frame(kFrameSize, static_cast<uint8_t>(index));
+    std::memcpy(frame.data(), &index, sizeof(index));
+    return frame;
+  }
+};
+
+TEST_F(IoThreadTest, receivesFramedMessages)
+{
+  auto client = connect();
+  ASSERT_TRUE(client);
+  ASSERT_FALSE(client->receiveData(10));
+
+  // messages may arrive in pieces or several at once
+  ASSERT_TRUE(sendFromServer("000"));
+  utils::concurrent::Thread::sleep(20);
+  ASSERT_TRUE(sendFromServer("00003AC"));
+  utils::concurrent::Thread::sleep(20);
+  ASSERT_TRUE(sendFromServer("K       9CALIBRATE00000006LAUNCH"));
+  ASSERT_EQ("ACK", client->receiveData(kTimeoutMillis));
+  ASSERT_EQ("CALIBRATE", client->receiveData(kTimeoutMillis));
+  ASSERT_EQ("LAUNCH", client->receiveData(kTimeoutMillis));
+  ASSERT_EQ(3u, client->getStats().num_received);
+
+  // and go both ways
+  ASSERT_TRUE(client->sendData("{\"id\":1}"));
+  std::string received(9, '\0');
+  ASSERT_TRUE(server_.receive(reinterpret_cast<uint8_t *>(received.data()), received.size()));
+  ASSERT_EQ("{\"id\":1}\n", received);
+}
+
+TEST_F(IoThreadTest, disconnectsOnMalformedHeader)
+{
+  auto client = connect();
+  ASSERT_TRUE(client);
+  // longer than any message the pod accepts
+  ASSERT_TRUE(sendFromServer("00001025"));
+  ASSERT_FALSE(client->receiveData(kTimeoutMillis));
+  ASSERT_FALSE(client->isConnected());
+  ASSERT_FALSE(client->sendData("{}"));
+}
+
+TEST_F(IoThreadTest, disconnectsWhenServerCloses)
+{
+  auto client = connect();
+  ASSERT_TRUE(client);
+  server_.closeConnection();
+  ASSERT_FALSE(client->receiveData(kTimeoutMillis));
+  ASSERT_FALSE(client->isConnected());
+}
+
+TEST_F(IoThreadTest, dropsOldestWhenServerStalls)
+{
+  static constexpr uint32_t kNumFrames = 4096;
+  telemetry::Client::Config config;
+  config.queue_capacity = kQueueCapacity;
+  auto client           = connect(config);
+  ASSERT_TRUE(client);
+
+  // far more than the socket buffers hold, so the server not reading stalls the connection
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t index = 0; index < kNumFrames; ++index) {
+    const auto frame = makeFrame(index);
+    ASSERT_TRUE(client->sendFrame(frame.data(), frame.size()));
+  }
+  // queueing never waits for the network
+  ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  ASSERT_GT(client->getStats().outgoing.num_dropped, 0u);
+
+  // the frames that made it arrive whole and in order, ending with the last one sent
+  uint32_t previous_index = 0;
+  std::vector<uint8_t> frame(kFrameSize);
+  for (uint32_t num_received = 0; previous_index != kNumFrames - 1; ++num_received) {
+    ASSERT_TRUE(server_.receive(frame.data(), frame.size()));
+    uint32_t index;
+    std::memcpy(&index, frame.data(), sizeof(index));
+    ASSERT_EQ(makeFrame(index), frame);
+    if (num_received > 0) { ASSERT_GT(index, previous_index); }
+    previous_index = index;
+  }
+  const auto stats = client->getStats().outgoing;
+  ASSERT_EQ(kNumFrames, stats.num_sent + stats.num_dropped);
+  ASSERT_GT(stats.max_latency_micros, 0u);
+}
+
+}  // namespace hyped::testing
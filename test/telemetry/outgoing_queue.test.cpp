@@ -0,0 +1,139 @@
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <telemetry/outgoing_queue.hpp>
+#include <utils/concurrent/thread.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Tests the drop oldest policy and partial writes of the queue, writing to one end of a socket
+ * pair and reading from the other
+ */
+class OutgoingQueueTest : public ::testing::Test {
+ protected:
+  static constexpr std::size_t kCapacity     = 4;
+  static constexpr std::size_t kReservedSize = 64;
+
+  void SetUp() override { ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets_)); }
+
+  void TearDown() override
+  {
+    close(sockets_[0]);
+    close(sockets_[1]);
+  }
+
+  static void push(telemetry::OutgoingQueue &queue, const std::string &message,
+                   const bool is_droppable = true)
+  {
+    iovec part;
+    part.iov_base = const_cast<char *>(message.data());
+    part.iov_len  = message.size();
+    queue.push(&part, 1, is_droppable);
+  }
+
+  std::string receive()
+  {
+    std::string received;
+    char buffer[4096];
+    ssize_t size;
+    while ((size = recv(sockets_[1], buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+      received.append(buffer, size);
+    }
+    return received;
+  }
+
+  int sockets_[2];
+};
+
+TEST_F(OutgoingQueueTest, dropsOldestWhenFull)
+{
+  telemetry::OutgoingQueue queue(kCapacity, kReservedSize);
+  for (char message = 'a'; message < 'k'; ++message) {
+    push(queue, std::string(3, message));
+  }
+  ASSERT_EQ(6u, queue.getStats().num_dropped);
+  ASSERT_EQ(telemetry::OutgoingQueue::WriteResult::kDone, queue.writeTo(sockets_[0]));
+  ASSERT_TRUE(queue.isEmpty());
+  ASSERT_EQ("ggghhhiiijjj", receive());
+  const auto stats = queue.getStats();
+  ASSERT_EQ(kCapacity, stats.num_sent);
+  ASSERT_EQ(12u, stats.num_bytes_sent);
+}
+
+TEST_F(OutgoingQueueTest, keepsMessagesThatAreNotDroppable)
+{
+  telemetry::OutgoingQueue queue(kCapacity, kReservedSize);
+  push(queue, "schema", false);
+  for (char message = 'a'; message < 'k'; ++message) {
+    push(queue, std::string(1, message));
+  }
+  ASSERT_EQ(7u, queue.getStats().num_dropped);
+  ASSERT_EQ(telemetry::OutgoingQueue::WriteResult::kDone, queue.writeTo(sockets_[0]));
+  ASSERT_EQ("schemahij", receive());
+
+  // with nothing else to drop, the new message goes
+  for (char message = '1'; message < '5'; ++message) {
+    push(queue, std::string(1, message), false);
+  }
+  push(queue, "x");
+  push(queue, "5", false);
+  ASSERT_EQ(9u, queue.getStats().num_dropped);
+  ASSERT_EQ(telemetry::OutgoingQueue::WriteResult::kDone, queue.writeTo(sockets_[0]));
+  ASSERT_EQ("1234", receive());
+}
+
+TEST_F(OutgoingQueueTest, resumesPartialWrites)
+{
+  const int buffer_size = 4096;
+  ASSERT_EQ(0, setsockopt(sockets_[0], SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size)));
+  telemetry::OutgoingQueue queue(kCapacity, kReservedSize);
+  std::string large(1 << 20, 'x');
+  large.back() = 'y';
+  push(queue, large);
+  ASSERT_EQ(telemetry::OutgoingQueue::WriteResult::kWouldBlock, queue.writeTo(sockets_[0]));
+  ASSERT_FALSE(queue.isEmpty());
+
+  // the partly written message survives the queue overflowing
+  for (char message = 'a'; message < 'k'; ++message) {
+    push(queue, std::string(1, message));
+  }
+  ASSERT_EQ(7u, queue.getStats().num_dropped);
+  std::string received;
+  while (queue.writeTo(sockets_[0]) != telemetry::OutgoingQueue::WriteResult::kDone) {
+    received += receive();
+  }
+  received += receive();
+  ASSERT_EQ(large + "hij", received);
+}
+
+TEST_F(OutgoingQueueTest, measuresLatency)
+{
+  telemetry::OutgoingQueue queue(kCapacity, kReservedSize);
+  push(queue, "first");
+  push(queue, "second");
+  utils::concurrent::Thread::sleep(5);
+  ASSERT_EQ(telemetry::OutgoingQueue::WriteResult::kDone, queue.writeTo(sockets_[0]));
+  const auto stats = queue.getStats();
+  ASSERT_EQ(2u, stats.num_sent);
+  ASSERT_GE(stats.max_latency_micros, 5000u);
+  ASSERT_GE(stats.total_latency_micros, 2 * 5000u);
+  ASSERT_LE(stats.max_latency_micros, stats.total_latency_micros);
+}
+
+TEST_F(OutgoingQueueTest, failsOnClosedConnection)
+{
+  telemetry::OutgoingQueue queue(kCapacity, kReservedSize);
+  push(queue, "message");
+  close(sockets_[1]);
+  sockets_[1] = -1;
+  ASSERT_EQ(telemetry::OutgoingQueue::WriteResult::kError, queue.writeTo(sockets_[0]));
+}
+
+}  // namespace hyped::testing
@@ -0,0 +1,123 @@
+#include "allocations.hpp"
+#include "loopback_client.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <data/data.hpp>
+#include <telemetry/binary_decoder.hpp>
+#include <telemetry/client.hpp>
+#include <telemetry/sender.hpp>
+#include <utils/concurrent/thread.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Tests the packets the Sender puts on the wire, with a loopback server as the ground station
+ */
+class SenderTest : public LoopbackClientTest {
+ protected:
+  static constexpr uint32_t kNumPackets = 100;
+
+  // a client sending packets in `format`
+  telemetry::Client *connect(const telemetry::Client::Format format)
+  {
+    telemetry::Client::Config config;
+    config.format = format;
+    return LoopbackClientTest::connect(config);
+  }
+
+  data::Data &data_ = data::Data::getInstance();
+};
+
+TEST_F(SenderTest, sendsNewlineDelimitedJson)
+{
+  ASSERT_NE(0, server_.getPort());
+  auto client = connect(telemetry::Client::Format::kJson);
+  ASSERT_TRUE(client);
+  telemetry::Sender sender(data_, *client);
+  ASSERT_TRUE(sender.sendSchema());
+  ASSERT_TRUE(sender.sendPacket(4));
+  ASSERT_TRUE(sender.sendPacket(5));
+
+  std::string received;
+  while (std::count(received.begin(), received.end(), '\n') < 2) {
+    uint8_t byte;
+    ASSERT_TRUE(server_.receive(&byte, 1));
+    received.push_back(static_cast<char>(byte));
+  }
+  const std::size_t delimiter = received.find('\n');
+  ASSERT_EQ('{', received.front());
+  ASSERT_EQ('}', received[delimiter - 1]);
+  ASSERT_LT(received.find("\"id\":4"), delimiter);
+  ASSERT_NE(std::string::npos, received.find("\"id\":5", delimiter));
+  ASSERT_EQ(0u, server_.drain());
+}
+
+TEST_F(SenderTest, sendsDecodableFrames)
+{
+  auto client = connect(telemetry::Client::Format::kDelta);
+  ASSERT_TRUE(client);
+  telemetry::Sender sender(data_, *client);
+  ASSERT_TRUE(sender.sendSchema());
+  telemetry::BinaryDecoder decoder;
+  for (uint32_t id = 0; id < 3; ++id) {
+    ASSERT_TRUE(sender.sendPacket(id));
+  }
+  for (uint32_t i = 0; i < 4; ++i) {
+    std::vector<uint8_t> frame(telemetry::binary::kHeaderSize);
+    ASSERT_TRUE(server_.receive(frame.data(), frame.size()));
+    const auto size = telemetry::BinaryDecoder::getFrameSize(frame.data(), frame.size());
+    ASSERT_TRUE(size);
+    frame.resize(*size);
+    ASSERT_TRUE(server_.receive(frame.data() + telemetry::binary::kHeaderSize,
+                                *size - telemetry::binary::kHeaderSize));
+    ASSERT_TRUE(decoder.decode(frame.data(), frame.size()));
+  }
+  ASSERT_EQ(telemetry::binary::FrameType::kDelta, decoder.getFrameType());
+  ASSERT_EQ(2u, decoder.getId());
+  ASSERT_TRUE(decoder.hasState());
+}
+
+TEST_F(SenderTest, sendsWithoutAllocating)
+{
+  for (const auto format : {telemetry::Client::Format::kJson, telemetry::Client::Format::kBinary,
+                            telemetry::Client::Format::kDelta}) {
+    auto client = connect(format);
+    ASSERT_TRUE(client);
+    telemetry::Sender sender(data_, *client);
+    ASSERT_TRUE(sender.sendSchema());
+    // the first packet sizes the buffers
+    ASSERT_TRUE(sender.sendPacket(0));
+    server_.drain();
+    const uint64_t num_allocations_before = getNumAllocations();
+    for (uint32_t id = 1; id <= kNumPackets; ++id) {
+      ASSERT_TRUE(sender.sendPacket(id));
+      server_.drain();
+    }
+    ASSERT_EQ(num_allocations_before, getNumAllocations());
+    disconnect();
+  }
+}
+
+TEST_F(SenderTest, failsWhenServerDisconnects)
+{
+  auto client = connect(telemetry::Client::Format::kJson);
+  ASSERT_TRUE(client);
+  telemetry::Sender sender(data_, *client);
+  server_.closeConnection();
+  // packets are queued until the I/O thread notices that the connection is gone
+  bool sent = true;
+  for (uint32_t id = 0; id < kNumPackets && sent; ++id) {
+    sent = sender.sendPacket(id);
+    utils::concurrent::Thread::sleep(10);
+  }
+  ASSERT_FALSE(sent);
+  ASSERT_FALSE(client->isConnected());
+}
+
+}  // namespace hyped::testing
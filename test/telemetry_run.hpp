@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <data/data.hpp>
+#include <telemetry/binary_schema.hpp>
+
+namespace hyped::testing {
+
+/**
+ * @brief Telemetry state over a complete run, sampled at a fixed rate, standing in for a recorded
+ *        run when replaying telemetry. The pod calibrates and waits in ready, accelerates to its
+ *        maximum velocity, cruises and brakes to a stop, while the batteries discharge and heat up
+ *        and the motors follow the velocity. Deterministic, so results can be compared between
+ *        runs.
+ */
+class TelemetryRun {
+ public:
+  static constexpr double kLaunchAcceleration  = 5.0;   // m/s^2
+  static constexpr double kBrakingDeceleration = 10.0;  // m/s^2
+  static constexpr double kCruisingTime        = 2.0;   // s
+  static constexpr double kWaitTime            = 2.0;   // s in each of the states before launch
+
+  explicit TelemetryRun(const uint32_t rate_hz) : period_(1.0 / rate_hz)
+  {
+    values_.fill(0);
+    setAllStatuses(data::ModuleStatus::kStart);
+    for (std::size_t i = 0; i < kNumBatteries; ++i) {
+      charge_[i]      = 100.0;
+      temperature_[i] = 22.0 + i;
+    }
+    values_[telemetry::binary::kNominalBraking] = true;
+    values_[telemetry::binary::kTemperature]    = 21;
+    values_[telemetry::binary::kPressure]       = 1013;
+    values_[telemetry::binary::kCurrentState]   = static_cast<int64_t>(data::State::kIdle);
+    update(0.0);
+  }
+
+  bool isFinished() const { return state_ == data::State::kFinished && time_ > end_time_; }
+  uint64_t getTimeMillis() const { return static_cast<uint64_t>(time_ * 1000.0); }
+  const telemetry::binary::Values &getValues() const { return values_; }
+
+  /**
+   * @brief Advances the run by one sample.
+   */
+  void step()
+  {
+    time_ += period_;
+    double acceleration = 0.0;
+    switch (state_) {
+      case data::State::kIdle:
+        if (time_ >= kWaitTime) {
+          state_                                 = data::State::kCalibrating;
+          values_[telemetry::binary::kCalibrate] = true;
+          setAllStatuses(data::ModuleStatus::kInit);
+        }
+        break;
+      case data::State::kCalibrating:
+        if (time_ >= 2 * kWaitTime) {
+          state_                                      = data::State::kReady;
+          values_[telemetry::binary::kNominalBraking] = false;
+          setAllStatuses(data::ModuleStatus::kReady);
+          for (std::size_t i = 0; i < data::Brakes::kNumBrakes; ++i) {
+            values_[telemetry::binary::kBrakesRetracted + i] = true;
+          }
+        }
+        break;
+      case data::State::kReady:
+        if (time_ >= 3 * kWaitTime) {
+          state_                              = data::State::kAccelerating;
+          values_[telemetry::binary::kLaunch] = true;
+        }
+        break;
+      case data::State::kAccelerating:
+        acceleration = kLaunchAcceleration;
+        if (velocity_ >= data::Navigation::kMaximumVelocity) {
+          state_        = data::State::kCruising;
+          cruise_start_ = time_;
+        }
+        break;
+      case data::State::kCruising:
+        if (time_ >= cruise_start_ + kCruisingTime) {
+          state_                                      = data::State::kNominalBraking;
+          values_[telemetry::binary::kNominalBraking] = true;
+          for (std::size_t i = 0; i < data::Brakes::kNumBrakes; ++i) {
+            values_[telemetry::binary::kBrakesRetracted + i] = false;
+          }
+        }
+        break;
+      case data::State::kNominalBraking:
+        acceleration = -kBrakingDeceleration;
+        if (velocity_ <= 0.0) {
+          state_    = data::State::kFinished;
+          end_time_ = time_ + kWaitTime;
+        }
+        break;
+      default:
+        break;
+    }
+    velocity_ = std::clamp(velocity_ + acceleration * period_, 0.0,
+                           static_cast<double>(data::Navigation::kMaximumVelocity));
+    displacement_ += velocity_ * period_;
+    update(acceleration);
+  }
+
+ private:
+  static constexpr std::size_t kNumBatteries
+    = data::FullBatteryData::kNumLPBatteries + data::FullBatteryData::kNumHPBatteries;
+
+  void setAllStatuses(const data::ModuleStatus status)
+  {
+    for (const auto field :
+         {telemetry::binary::kTelemetryStatus, telemetry::binary::kNavigationStatus,
+          telemetry::binary::kBrakesStatus, telemetry::binary::kSensorsStatus,
+          telemetry::binary::kBatteriesStatus, telemetry::binary::kMotorsStatus}) {
+      values_[field] = static_cast<int64_t>(status);
+    }
+  }
+
+  void update(const double acceleration)
+  {
+    using namespace telemetry::binary;
+    const double braking_distance      = velocity_ * velocity_ / (2 * kBrakingDeceleration);
+    values_[kCurrentState]             = static_cast<int64_t>(state_);
+    values_[kAcceleration]             = static_cast<int64_t>(acceleration);
+    values_[kVelocity]                 = static_cast<int64_t>(velocity_);
+    values_[kDisplacement]             = static_cast<int64_t>(displacement_);
+    values_[kBrakingDistance]          = static_cast<int64_t>(braking_distance);
+    values_[kEmergencyBrakingDistance] = static_cast<int64_t>(braking_distance / 2);
+    const double rpm = velocity_ / data::Navigation::kWheelCircumfrence * 60.0;
+    for (std::size_t i = 0; i < data::Motors::kNumMotors; ++i) {
+      values_[kMotorRpms + i] = static_cast<int64_t>(rpm);
+    }
+
+    // only the high power batteries drive the motors
+    for (std::size_t i = 0; i < kNumBatteries; ++i) {
+      const bool is_hp     = i >= data::FullBatteryData::kNumLPBatteries;
+      const double current = is_hp ? 20.0 * std::abs(acceleration) + rpm / 100.0 : 2.0;  // A
+      charge_[i] -= current * period_ / 360.0;
+      temperature_[i] += current * current * period_ / 20000.0;
+      const std::size_t first = is_hp ? kHpBatteries : kLpBatteries;
+      const std::size_t index = is_hp ? i - data::FullBatteryData::kNumLPBatteries : i;
+      const double voltage    = (is_hp ? 1000.0 : 240.0) + charge_[i] - current / 10.0;  // dV
+      int64_t *battery        = &values_[getBatteryField(first, index, kAverageTemp)];
+      battery[kAverageTemp]   = static_cast<int64_t>(temperature_[i]);
+      battery[kLowTemp]       = static_cast<int64_t>(temperature_[i] - 1.0);
+      battery[kHighTemp]      = static_cast<int64_t>(temperature_[i] + 2.0);
+      battery[kVoltage]       = static_cast<int64_t>(voltage);
+      battery[kCurrent]       = static_cast<int64_t>(current * 10.0);  // dA
+      battery[kCharge]        = static_cast<int64_t>(charge_[i]);
+      if (is_hp) {
+        battery[kLowVoltageCell]  = static_cast<int64_t>(voltage * 100.0 / 36.0) - 20;  // mV
+        battery[kHighVoltageCell] = static_cast<int64_t>(voltage * 100.0 / 36.0) + 20;
+      }
+    }
+  }
+
+  const double period_;
+  double time_         = 0.0;
+  double cruise_start_ = 0.0;
+  double end_time_     = 0.0;
+  double velocity_     = 0.0;
+  double displacement_ = 0.0;
+  data::State state_   = data::State::kIdle;
+  double charge_[kNumBatteries];
+  double temperature_[kNumBatteries];
+  telemetry::binary::Values values_;
+};
+
+}  // namespace hyped::testing
@@ -0,0 +1,153 @@
+#include "fake_file_system.hpp"
+#include "test.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <utils/io/adc.hpp>
+
+namespace hyped::testing {
+
+class AdcTest : public Test {
+ protected:
+  inline static const std::string kSysfsDirectory = "sys/bus/iio/devices/iio:device0/";
+  inline static const std::string kDeviceNode     = "dev/iio:device0";
+
+  void SetUp() override
+  {
+    Test::SetUp();
+    ASSERT_FALSE(file_system_.getRoot().empty());
+  }
+
+  void addScanElement(const uint32_t channel, const uint32_t index, const std::string &type)
+  {
+    const std::string prefix
+      = kSysfsDirectory + "scan_elements/in_voltage" + std::to_string(channel);
+    ASSERT_TRUE(file_system_.write(prefix + "_en", "0\n"));
+    ASSERT_TRUE(file_system_.write(prefix + "_index", std::to_string(index) + "\n"));
+    ASSERT_TRUE(file_system_.write(prefix + "_type", type + "\n"));
+  }
+
+  void addBuffer()
+  {
+    ASSERT_TRUE(file_system_.write(kSysfsDirectory + "buffer/enable", "0\n"));
+    ASSERT_TRUE(file_system_.write(kSysfsDirectory + "buffer/length", "2\n"));
+  }
+
+  FakeFileSystem file_system_;
+};
+
+TEST_F(AdcTest, readsRawValue)
+{
+  ASSERT_TRUE(file_system_.write(kSysfsDirectory + "in_voltage3_raw", "4095\n"));
+  utils::io::Adc adc(3, file_system_.getRoot());
+  ASSERT_EQ(4095, adc.read());
+}
+
+TEST_F(AdcTest, keepsFileOpenAcrossReads)
+{
+  ASSERT_TRUE(file_system_.write(kSysfsDirectory + "in_voltage0_raw", "1234\n"));
+  utils::io::Adc adc(0, file_system_.getRoot());
+  ASSERT_EQ(1234, adc.read());
+  // sysfs replaces the contents of the same file, which the open descriptor must pick up
+  ASSERT_TRUE(file_system_.write(kSysfsDirectory + "in_voltage0_raw", "7\n"));
+  ASSERT_EQ(7, adc.read());
+  ASSERT_EQ(7, adc.read());
+}
+
+TEST_F(AdcTest, missingChannelReadsZeroUntilItAppears)
+{
+  utils::io::Adc adc(5, file_system_.getRoot());
+  ASSERT_EQ(0, adc.read());
+  ASSERT_TRUE(file_system_.write(kSysfsDirectory + "in_voltage5_raw", "300\n"));
+  ASSERT_EQ(300, adc.read());
+}
+
+TEST_F(AdcTest, bufferReadsMostRecentScan)
+{
+  addBuffer();
+  addScanElement(0, 0, "le:u12/16>>0");
+  addScanElement(3, 3, "le:u12/16>>0");
+  addScanElement(5, 5, "le:u12/16>>0");
+  // two scans of channels 0 and 5, little endian 16 bit each
+  const std::string scans("\x01\x00\x02\x00"
+                          "\xff\x0f\x34\x02",
+                          8);
+  ASSERT_TRUE(file_system_.write(kDeviceNode, scans));
+
+  utils::io::AdcBuffer buffer({5, 0}, file_system_.getRoot());
+  ASSERT_TRUE(buffer.isOpen());
+  ASSERT_EQ(4u, buffer.getScanSize());
+  ASSERT_EQ("1", file_system_.read(kSysfsDirectory + "scan_elements/in_voltage0_en"));
+  ASSERT_EQ("0", file_system_.read(kSysfsDirectory + "scan_elements/in_voltage3_en"));
+  ASSERT_EQ("1", file_system_.read(kSysfsDirectory + "scan_elements/in_voltage5_en"));
+  ASSERT_EQ(std::to_string(utils::io::AdcBuffer::kBufferLength),
+            file_system_.read(kSysfsDirectory + "buffer/length"));
+  ASSERT_EQ("1", file_system_.read(kSysfsDirectory + "buffer/enable"));
+
+  ASSERT_TRUE(buffer.read());
+  ASSERT_EQ(4095, buffer.getValue(0));
+  ASSERT_EQ(0x234, buffer.getValue(5));
+  ASSERT_EQ(0, buffer.getValue(3));
+  // nothing new has been buffered, so the previous values are kept
+  ASSERT_FALSE(buffer.read());
+  ASSERT_EQ(4095, buffer.getValue(0));
+}
+
+TEST_F(AdcTest, bufferHonoursIndexAlignmentAndType)
+{
+  addBuffer();
+  // channel 2 is scanned before channel 1 and the 32 bit element is aligned to four bytes
+  addScanElement(1, 4, "be:u12/32>>4");
+  addScanElement(2, 0, "le:u8/8>>0");
+  const std::string scan("\x2a\x00\x00\x00"
+                         "\x00\x00\xab\xc0",
+                         8);
+  ASSERT_TRUE(file_system_.write(kDeviceNode, scan));
+
+  utils::io::AdcBuffer buffer({1, 2}, file_system_.getRoot());
+  ASSERT_TRUE(buffer.isOpen());
+  ASSERT_EQ(8u, buffer.getScanSize());
+  ASSERT_TRUE(buffer.read());
+  ASSERT_EQ(0x2a, buffer.getValue(2));
+  ASSERT_EQ(0xabc, buffer.getValue(1));
+}
+
+TEST_F(AdcTest, bufferDisablesOnDestruction)
+{
+  addBuffer();
+  addScanElement(0, 0, "le:u12/16>>0");
+  ASSERT_TRUE(file_system_.write(kDeviceNode, ""));
+  {
+    utils::io::AdcBuffer buffer({0}, file_system_.getRoot());
+    ASSERT_TRUE(buffer.isOpen());
+    ASSERT_FALSE(buffer.read());
+  }
+  ASSERT_EQ("0", file_system_.read(kSysfsDirectory + "buffer/enable"));
+}
+
+TEST_F(AdcTest, bufferRejectsUnsupportedSetup)
+{
+  addBuffer();
+  addScanElement(0, 0, "le:s12/16X2>>0");
+  addScanElement(1, 1, "le:u12/16>>0");
+  ASSERT_TRUE(file_system_.write(kDeviceNode, ""));
+  {
+    // repeated elements are not supported
+    utils::io::AdcBuffer buffer({0}, file_system_.getRoot());
+    ASSERT_FALSE(buffer.isOpen());
+  }
+  {
+    // channel 2 has no scan element
+    utils::io::AdcBuffer buffer({1, 2}, file_system_.getRoot());
+    ASSERT_FALSE(buffer.isOpen());
+  }
+  {
+    utils::io::AdcBuffer buffer({utils::io::adc::kNumChannels}, file_system_.getRoot());
+    ASSERT_FALSE(buffer.isOpen());
+  }
+}
+
+}  // namespace hyped::testing
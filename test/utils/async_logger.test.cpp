@@ -0,0 +1,203 @@
+#include "allocations.hpp"
+
+#include <stdio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <utils/async_logger.hpp>
+#include <utils/logger.hpp>
+
+namespace hyped::testing {
+
+class AsyncLoggerTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kRingCapacity = utils::AsyncLogger::kRingCapacity;
+
+  void SetUp() override
+  {
+    output_       = tmpfile();
+    error_output_ = tmpfile();
+    ASSERT_NE(nullptr, output_);
+    ASSERT_NE(nullptr, error_output_);
+  }
+
+  void TearDown() override
+  {
+    utils::Logger::setAsyncLogger(nullptr);
+    fclose(output_);
+    fclose(error_output_);
+  }
+
+  static std::vector<std::string> readLines(FILE *file)
+  {
+    std::vector<std::string> lines;
+    rewind(file);
+    char buffer[512];
+    while (fgets(buffer, sizeof(buffer), file) != nullptr) {
+      lines.emplace_back(buffer);
+    }
+    return lines;
+  }
+
+  static bool endsWith(const std::string &line, const std::string &suffix)
+  {
+    return line.size() >= suffix.size()
+           && line.compare(line.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+
+  FILE *output_;
+  FILE *error_output_;
+};
+
+TEST_F(AsyncLoggerTest, writesMessagesWithHeader)
+{
+  utils::AsyncLogger async_logger(output_, error_output_);
+  utils::Logger::setAsyncLogger(&async_logger);
+  utils::Logger log("ASYNC-TEST", utils::Logger::Level::kDebug);
+  log.info("info %d", 1);
+  log.debug("debug %s", "two");
+  log.error("error %.1f", 3.0);
+  // nothing is written before the records are drained
+  ASSERT_TRUE(readLines(output_).empty());
+  async_logger.flush();
+
+  const auto lines = readLines(output_);
+  ASSERT_EQ(2u, lines.size());
+  ASSERT_TRUE(endsWith(lines.at(0), " INFO[ASYNC-TEST]: info 1\n")) << lines.at(0);
+  ASSERT_TRUE(endsWith(lines.at(1), " DEBUG[ASYNC-TEST]: debug two\n")) << lines.at(1);
+  const auto error_lines = readLines(error_output_);
+  ASSERT_EQ(1u, error_lines.size());
+  ASSERT_TRUE(endsWith(error_lines.at(0), " ERROR[ASYNC-TEST]: error 3.0\n")) << error_lines.at(0);
+}
+
+TEST_F(AsyncLoggerTest, formatsCapturedArgumentsLikeSnprintf)
+{
+  utils::AsyncLogger async_logger(output_, error_output_);
+  utils::Logger::setAsyncLogger(&async_logger);
+  utils::Logger log("ASYNC-TEST", utils::Logger::Level::kInfo);
+  std::string temporary = "temporary";
+  log.info("%d %i %u %ld %lld %jd %zu %td %hhx %lX %llo %c", -1, 2, 3u, -4L, 5LL, intmax_t{-6},
+           size_t{7}, ptrdiff_t{-8}, 0x1ff, 0xabcUL, 8ULL, 'z');
+  log.info("%05.2f|%-8.3e|%g|%+a|%% %s|%-6.2s|%p", 3.14159, 1e-3, 0.5, 1.0, temporary.c_str(),
+           "abc", static_cast<void *>(&temporary));
+  // strings are copied when the message is pushed, formatting happens when it is written
+  temporary.assign("overwritten");
+  // a width taken from the arguments cannot be captured, so the caller formats the message
+  log.info("%*d|%.*f", 5, 42, 2, 1.0);
+  async_logger.flush();
+
+  char expected[3][utils::AsyncLogger::kMaxMessageLength];
+  snprintf(expected[0], sizeof(expected[0]), "%d %i %u %ld %lld %jd %zu %td %hhx %lX %llo %c", -1,
+           2, 3u, -4L, 5LL, intmax_t{-6}, size_t{7}, ptrdiff_t{-8}, 0x1ff, 0xabcUL, 8ULL, 'z');
+  snprintf(expected[1], sizeof(expected[1]), "%05.2f|%-8.3e|%g|%+a|%% %s|%-6.2s|%p", 3.14159,
+           1e-3, 0.5, 1.0, "temporary", "abc", static_cast<void *>(&temporary));
+  snprintf(expected[2], sizeof(expected[2]), "%*d|%.*f", 5, 42, 2, 1.0);
+  const auto lines = readLines(output_);
+  ASSERT_EQ(3u, lines.size());
+  for (size_t i = 0; i < lines.size(); ++i) {
+    ASSERT_TRUE(endsWith(lines.at(i), std::string(": ") + expected[i] + "\n")) << lines.at(i);
+  }
+}
+
+TEST_F(AsyncLoggerTest, truncatesCapturedMessages)
+{
+  utils::AsyncLogger async_logger(output_, error_output_);
+  utils::Logger::setAsyncLogger(&async_logger);
+  utils::Logger log("ASYNC-TEST", utils::Logger::Level::kInfo);
+  // short enough to be captured, but longer than a message once formatted
+  log.info("%100d%100d", 1, 2);
+  async_logger.flush();
+  const auto lines = readLines(output_);
+  ASSERT_EQ(1u, lines.size());
+  char expected[utils::AsyncLogger::kMaxMessageLength];
+  snprintf(expected, sizeof(expected), "%100d%100d", 1, 2);
+  ASSERT_TRUE(endsWith(lines.at(0), std::string(": ") + expected + "\n")) << lines.at(0);
+}
+
+TEST_F(AsyncLoggerTest, truncatesLongMessages)
+{
+  utils::AsyncLogger async_logger(output_, error_output_);
+  utils::Logger::setAsyncLogger(&async_logger);
+  utils::Logger log("ASYNC-TEST", utils::Logger::Level::kInfo);
+  const std::string message(1000, 'x');
+  log.info("%s", message.c_str());
+  async_logger.flush();
+  const auto lines = readLines(output_);
+  ASSERT_EQ(1u, lines.size());
+  const std::string truncated(utils::AsyncLogger::kMaxMessageLength - 1, 'x');
+  ASSERT_TRUE(endsWith(lines.at(0), ": " + truncated + "\n"));
+}
+
+TEST_F(AsyncLoggerTest, countsAndReportsDrops)
+{
+  utils::AsyncLogger async_logger(output_, error_output_);
+  utils::Logger::setAsyncLogger(&async_logger);
+  utils::Logger log("ASYNC-TEST", utils::Logger::Level::kInfo);
+  // without the background thread nothing drains the ring
+  for (size_t i = 0; i < kRingCapacity + 10; ++i) {
+    log.info("message %zu", i);
+  }
+  ASSERT_EQ(10u, async_logger.getNumDropped());
+  async_logger.flush();
+  ASSERT_EQ(kRingCapacity, readLines(output_).size());
+  const auto error_lines = readLines(error_output_);
+  ASSERT_EQ(1u, error_lines.size());
+  ASSERT_TRUE(endsWith(error_lines.at(0),
+                       " ERROR[LOGGER]: dropped 10 messages because a thread logged too fast\n"));
+
+  // the ring is usable again after draining
+  log.info("after");
+  async_logger.flush();
+  ASSERT_EQ(kRingCapacity + 1, readLines(output_).size());
+  ASSERT_EQ(1u, readLines(error_output_).size());
+}
+
+TEST_F(AsyncLoggerTest, pushDoesNotAllocate)
+{
+  utils::AsyncLogger async_logger(output_, error_output_);
+  utils::Logger::setAsyncLogger(&async_logger);
+  utils::Logger log("ASYNC-TEST", utils::Logger::Level::kInfo);
+  // registers the ring of this thread
+  log.info("first");
+  const auto num_allocations_before = getNumAllocations();
+  for (size_t i = 1; i < kRingCapacity; ++i) {
+    log.info("message %zu of %s", i, "test");
+  }
+  ASSERT_EQ(num_allocations_before, getNumAllocations());
+  ASSERT_EQ(0u, async_logger.getNumDropped());
+}
+
+/**
+ * Every message of every thread is either written by the background thread or counted as dropped.
+ */
+TEST_F(AsyncLoggerTest, backgroundThreadWritesAllThreads)
+{
+  static constexpr size_t kNumThreads           = 4;
+  static constexpr size_t kNumMessagesPerThread = 2000;
+  utils::AsyncLogger async_logger(output_, error_output_);
+  utils::Logger::setAsyncLogger(&async_logger);
+  async_logger.start();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([i]() {
+      utils::Logger log("ASYNC-TEST", utils::Logger::Level::kInfo);
+      for (size_t j = 0; j < kNumMessagesPerThread; ++j) {
+        log.info("thread %zu message %zu", i, j);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  async_logger.stop();
+  ASSERT_EQ(kNumThreads * kNumMessagesPerThread,
+            readLines(output_).size() + async_logger.getNumDropped());
+}
+
+}  // namespace hyped::testing
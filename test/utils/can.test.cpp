@@ -0,0 +1,112 @@
+#include "test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <utils/io/can.hpp>
+
+namespace hyped::testing {
+
+class CanTest : public Test {
+ protected:
+  using Frame   = utils::io::can::Frame;
+  using IdRange = utils::io::can::IdRange;
+
+  class CountingProcessor : public utils::io::ICanProcessor {
+   public:
+    void processNewData(Frame &) override { ++num_frames; }
+    std::atomic<std::size_t> num_frames = 0;
+  };
+
+  static bool accepts(const std::vector<utils::io::can::Filter> &filters, const uint32_t id,
+                      const bool extended)
+  {
+    const uint32_t raw_id = id | (extended ? Frame::kExtendedMask : 0);
+    for (const auto &filter : filters) {
+      if ((raw_id & filter.mask) == (filter.id & filter.mask)) { return true; }
+    }
+    return false;
+  }
+
+  static Frame makeFrame(const uint32_t id)
+  {
+    Frame frame;
+    frame.id       = id;
+    frame.extended = false;
+    frame.len      = 2;
+    frame.data[0]  = 0x12;
+    frame.data[1]  = 0x34;
+    return frame;
+  }
+};
+
+TEST_F(CanTest, filtersExactIds)
+{
+  const auto filters = utils::io::can::toFilters(IdRange::exact(0x581, false));
+  ASSERT_EQ(filters.size(), 1u);
+  ASSERT_TRUE(accepts(filters, 0x581, false));
+  ASSERT_FALSE(accepts(filters, 0x580, false));
+  ASSERT_FALSE(accepts(filters, 0x581, true));
+  ASSERT_FALSE(accepts(filters, 0x581 | utils::io::can::Filter::kRemoteMask, false));
+}
+
+TEST_F(CanTest, filtersExactlyTheRange)
+{
+  const std::vector<IdRange> ranges = {{0x6B0, 0x6B5, false}, {300, 304, true},
+                                       {0, IdRange::kMaxStandardId, false},
+                                       {0x123, IdRange::kMaxExtendedId, true}};
+  for (const auto &ids : ranges) {
+    const auto filters = utils::io::can::toFilters(ids);
+    // aligned power of two blocks need at most two filters per bit of the range
+    ASSERT_LE(filters.size(), 2 * 29u);
+    const uint32_t max_id = ids.extended ? IdRange::kMaxExtendedId : IdRange::kMaxStandardId;
+    for (const uint32_t id : {0U, ids.first - 1, ids.first, ids.first + 1, ids.last - 1, ids.last,
+                              ids.last + 1, max_id}) {
+      if (id > max_id) { continue; }
+      const bool is_in_range = ids.first <= id && id <= ids.last;
+      ASSERT_EQ(accepts(filters, id, ids.extended), is_in_range) << id;
+      ASSERT_FALSE(accepts(filters, id, !ids.extended)) << id;
+    }
+  }
+  ASSERT_EQ(utils::io::can::toFilters({0, IdRange::kMaxStandardId, false}).size(), 1u);
+  ASSERT_EQ(utils::io::can::toFilters({300, 304, true}).size(), 2u);
+}
+
+/**
+ * Needs a virtual CAN interface, e.g.
+ *   ip link add dev vcan0 type vcan && ip link set up vcan0
+ */
+TEST_F(CanTest, sendsAndReceivesBatchesOnVirtualBus)
+{
+  utils::io::Can sender("vcan0");
+  utils::io::Can receiver("vcan0");
+  if (!sender.isOpen() || !receiver.isOpen()) { GTEST_SKIP() << "vcan0 is not available"; }
+
+  CountingProcessor processor;
+  receiver.registerProcessor(&processor, {0x580, 0x58F, false});
+  receiver.start();
+
+  constexpr std::size_t kNumFrames = 100;
+  std::vector<Frame> frames;
+  for (std::size_t i = 0; i < kNumFrames; ++i) {
+    frames.push_back(makeFrame(0x580 + i % 16));
+    // dropped by the kernel filter
+    frames.push_back(makeFrame(0x600 + i % 16));
+  }
+  ASSERT_EQ(sender.send(frames.data(), frames.size()), frames.size());
+  ASSERT_LE(sender.getStatistics().num_send_calls,
+            (frames.size() + utils::io::Can::kBatchSize - 1) / utils::io::Can::kBatchSize);
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (processor.num_frames < kNumFrames && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(processor.num_frames, kNumFrames);
+  ASSERT_EQ(receiver.getStatistics().num_frames_received, kNumFrames);
+}
+
+}  // namespace hyped::testing
@@ -0,0 +1,169 @@
+#include "test.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <utils/io/can.hpp>
+
+namespace hyped::testing {
+
+class CanDispatchTableTest : public Test {
+ protected:
+  using IdRange = utils::io::can::IdRange;
+
+  /**
+   * @brief Records the ids of the frames it receives and the order in which processors were
+   *        called across all instances.
+   */
+  class RecordingProcessor : public utils::io::ICanProcessor {
+   public:
+    RecordingProcessor(std::vector<const RecordingProcessor *> &calls) : calls_(calls) {}
+
+    void processNewData(utils::io::can::Frame &message) override
+    {
+      ids.push_back(message.id);
+      calls_.push_back(this);
+    }
+
+    std::vector<uint32_t> ids;
+
+   private:
+    std::vector<const RecordingProcessor *> &calls_;
+  };
+
+  static utils::io::can::Frame makeFrame(const uint32_t id, const bool extended)
+  {
+    utils::io::can::Frame frame;
+    frame.id       = id;
+    frame.extended = extended;
+    frame.len      = 0;
+    return frame;
+  }
+
+  std::size_t dispatch(const uint32_t id, const bool extended)
+  {
+    auto frame = makeFrame(id, extended);
+    return table_.dispatch(frame);
+  }
+
+  utils::io::can::DispatchTable table_;
+  std::vector<const RecordingProcessor *> calls_;
+};
+
+TEST_F(CanDispatchTableTest, dispatchesExactStandardIds)
+{
+  RecordingProcessor first(calls_);
+  RecordingProcessor second(calls_);
+  ASSERT_TRUE(table_.add(&first, IdRange::exact(0x581, false)));
+  ASSERT_TRUE(table_.add(&second, IdRange::exact(0x582, false)));
+  ASSERT_EQ(dispatch(0x581, false), 1u);
+  ASSERT_EQ(dispatch(0x582, false), 1u);
+  ASSERT_EQ(dispatch(0x583, false), 0u);
+  // the same id as an extended id belongs to nobody
+  ASSERT_EQ(dispatch(0x581, true), 0u);
+  ASSERT_EQ(first.ids, std::vector<uint32_t>{0x581});
+  ASSERT_EQ(second.ids, std::vector<uint32_t>{0x582});
+}
+
+TEST_F(CanDispatchTableTest, dispatchesStandardRanges)
+{
+  RecordingProcessor processor(calls_);
+  ASSERT_TRUE(table_.add(&processor, {0x6B0, 0x6B5, false}));
+  ASSERT_EQ(dispatch(0x6AF, false), 0u);
+  ASSERT_EQ(dispatch(0x6B0, false), 1u);
+  ASSERT_EQ(dispatch(0x6B5, false), 1u);
+  ASSERT_EQ(dispatch(0x6B6, false), 0u);
+  ASSERT_EQ(dispatch(IdRange::kMaxStandardId + 1, false), 0u);
+}
+
+TEST_F(CanDispatchTableTest, dispatchesExtendedRanges)
+{
+  RecordingProcessor first(calls_);
+  RecordingProcessor second(calls_);
+  ASSERT_TRUE(table_.add(&first, {300, 304, true}));
+  ASSERT_TRUE(table_.add(&second, {310, 314, true}));
+  ASSERT_TRUE(table_.add(&second, IdRange::exact(0x18EEFF80, true)));
+  for (uint32_t id = 295; id < 320; ++id) {
+    const bool is_first  = 300 <= id && id <= 304;
+    const bool is_second = 310 <= id && id <= 314;
+    ASSERT_EQ(dispatch(id, true), is_first || is_second ? 1u : 0u) << id;
+  }
+  ASSERT_EQ(dispatch(0x18EEFF80, true), 1u);
+  ASSERT_EQ(dispatch(0x18EEFF81, true), 0u);
+  ASSERT_EQ(dispatch(0, true), 0u);
+  ASSERT_EQ(dispatch(IdRange::kMaxExtendedId, true), 0u);
+  ASSERT_EQ(first.ids.size(), 5u);
+  ASSERT_EQ(second.ids.size(), 6u);
+}
+
+TEST_F(CanDispatchTableTest, dispatchesSharedIdsInRegistrationOrder)
+{
+  RecordingProcessor first(calls_);
+  RecordingProcessor second(calls_);
+  // overlapping ranges, as for the current message every low power BMS listens to
+  ASSERT_TRUE(table_.add(&second, {0x20, 0x30, true}));
+  ASSERT_TRUE(table_.add(&first, {0x28, 0x40, true}));
+  ASSERT_TRUE(table_.add(&first, IdRange::exact(0x28, false)));
+  ASSERT_TRUE(table_.add(&second, IdRange::exact(0x28, false)));
+  ASSERT_EQ(dispatch(0x25, true), 1u);
+  ASSERT_EQ(dispatch(0x35, true), 1u);
+  calls_.clear();
+  ASSERT_EQ(dispatch(0x28, true), 2u);
+  ASSERT_EQ(calls_, (std::vector<const RecordingProcessor *>{&second, &first}));
+  calls_.clear();
+  ASSERT_EQ(dispatch(0x28, false), 2u);
+  ASSERT_EQ(calls_, (std::vector<const RecordingProcessor *>{&first, &second}));
+}
+
+TEST_F(CanDispatchTableTest, removesRegistrations)
+{
+  RecordingProcessor first(calls_);
+  RecordingProcessor second(calls_);
+  ASSERT_TRUE(table_.add(&first, IdRange::exact(0x3F, false)));
+  ASSERT_TRUE(table_.add(&second, IdRange::exact(0x3F, false)));
+  ASSERT_TRUE(table_.add(&first, {1000, 2000, true}));
+  ASSERT_TRUE(table_.remove(&first, IdRange::exact(0x3F, false)));
+  ASSERT_FALSE(table_.remove(&first, IdRange::exact(0x3F, false)));
+  ASSERT_FALSE(table_.remove(&first, {1000, 1999, true}));
+  ASSERT_EQ(dispatch(0x3F, false), 1u);
+  ASSERT_TRUE(first.ids.empty());
+  ASSERT_EQ(dispatch(1500, true), 1u);
+  ASSERT_TRUE(table_.remove(&first, {1000, 2000, true}));
+  ASSERT_EQ(dispatch(1500, true), 0u);
+}
+
+TEST_F(CanDispatchTableTest, rejectsInvalidRanges)
+{
+  RecordingProcessor processor(calls_);
+  ASSERT_FALSE(table_.add(&processor, {0x10, 0x0F, false}));
+  ASSERT_FALSE(table_.add(&processor, IdRange::exact(IdRange::kMaxStandardId + 1, false)));
+  ASSERT_FALSE(table_.add(&processor, IdRange::exact(IdRange::kMaxExtendedId + 1, true)));
+  ASSERT_TRUE(table_.add(&processor, IdRange::exact(IdRange::kMaxExtendedId, true)));
+  ASSERT_EQ(dispatch(IdRange::kMaxExtendedId, true), 1u);
+  ASSERT_EQ(dispatch(0x10, false), 0u);
+}
+
+TEST_F(CanDispatchTableTest, coversRegisteredIdsWithRanges)
+{
+  RecordingProcessor first(calls_);
+  RecordingProcessor second(calls_);
+  ASSERT_TRUE(table_.add(&first, {0x581, 0x582, false}));
+  ASSERT_TRUE(table_.add(&second, IdRange::exact(0x583, false)));
+  ASSERT_TRUE(table_.add(&first, IdRange::exact(0x700, false)));
+  ASSERT_TRUE(table_.add(&second, {300, 304, true}));
+  ASSERT_TRUE(table_.add(&first, {305, 309, true}));
+  ASSERT_TRUE(table_.add(&first, {302, 303, true}));
+  ASSERT_TRUE(table_.add(&first, IdRange::exact(0x581, true)));
+  const auto ranges = table_.getRanges();
+  ASSERT_EQ(ranges.size(), 4u);
+  const std::vector<IdRange> expected
+    = {{0x581, 0x583, false}, {0x700, 0x700, false}, {300, 309, true}, {0x581, 0x581, true}};
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(ranges[i].first, expected[i].first) << i;
+    ASSERT_EQ(ranges[i].last, expected[i].last) << i;
+    ASSERT_EQ(ranges[i].extended, expected[i].extended) << i;
+  }
+}
+
+}  // namespace hyped::testing
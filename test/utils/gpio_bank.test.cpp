@@ -0,0 +1,109 @@
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <utils/io/gpio_bank.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Register map that behaves like the BBB's GPIO banks: writes to the set and clear registers
+ * change the levels of the pins, which read back through the data register.
+ */
+class FakeGpioRegisters : public utils::io::IGpioRegisters {
+ public:
+  struct Write {
+    uint8_t bank;
+    uint32_t offset;
+    uint32_t value;
+  };
+
+  bool isMapped(const uint8_t bank) const override { return bank < utils::io::Gpio::kBankNum; }
+
+  uint32_t read(const uint8_t bank, const uint32_t offset) const override
+  {
+    EXPECT_EQ(utils::io::Gpio::kData, offset);
+    return levels.at(bank);
+  }
+
+  void write(const uint8_t bank, const uint32_t offset, const uint32_t value) override
+  {
+    writes.push_back({bank, offset, value});
+    if (offset == utils::io::Gpio::kSet) {
+      levels.at(bank) |= value;
+    } else if (offset == utils::io::Gpio::kClear) {
+      levels.at(bank) &= ~value;
+    } else {
+      ADD_FAILURE() << "write to unexpected register " << offset;
+    }
+  }
+
+  std::array<uint32_t, utils::io::Gpio::kBankNum> levels = {};
+  std::vector<Write> writes;
+};
+
+class GpioBankTest : public ::testing::Test {
+ protected:
+  std::shared_ptr<FakeGpioRegisters> registers_ = std::make_shared<FakeGpioRegisters>();
+};
+
+TEST_F(GpioBankTest, pinsMapToBanksAndMasks)
+{
+  ASSERT_EQ(0, utils::io::GpioBank::getBank(31));
+  ASSERT_EQ(1, utils::io::GpioBank::getBank(32));
+  ASSERT_EQ(3, utils::io::GpioBank::getBank(117));
+  ASSERT_EQ(1u << 21, utils::io::GpioBank::getMask(117));
+
+  utils::io::GpioBank bank(1, registers_);
+  ASSERT_EQ((1u << 12) | (1u << 28) | 1u, bank.getMask({44, 60, 32}));
+  ASSERT_FALSE(bank.getMask({44, 66}));
+}
+
+TEST_F(GpioBankTest, setsAndClearsMasksWithOneWrite)
+{
+  utils::io::GpioBank bank(2, registers_);
+  ASSERT_TRUE(bank.isMapped());
+  bank.set(0xf0f0);
+  ASSERT_EQ(1u, registers_->writes.size());
+  ASSERT_EQ(0xf0f0u, bank.read());
+  bank.clear(0x00ff);
+  ASSERT_EQ(2u, registers_->writes.size());
+  ASSERT_EQ(2, registers_->writes[1].bank);
+  ASSERT_EQ(utils::io::Gpio::kClear, registers_->writes[1].offset);
+  ASSERT_EQ(0xf000u, bank.read());
+  // other banks are untouched
+  ASSERT_EQ(0u, registers_->levels[0]);
+  ASSERT_EQ(0u, registers_->levels[1]);
+  ASSERT_EQ(0u, registers_->levels[3]);
+}
+
+TEST_F(GpioBankTest, writesOnlyMaskedPins)
+{
+  utils::io::GpioBank bank(0, registers_);
+  bank.set(0xff00ff00);
+  bank.write(0x0000ffff, 0x000000f0);
+  ASSERT_EQ(0xff0000f0u, bank.read());
+  // one write for the pins going high and one for those going low
+  ASSERT_EQ(3u, registers_->writes.size());
+  ASSERT_EQ(utils::io::Gpio::kSet, registers_->writes[1].offset);
+  ASSERT_EQ(0x000000f0u, registers_->writes[1].value);
+  ASSERT_EQ(utils::io::Gpio::kClear, registers_->writes[2].offset);
+  ASSERT_EQ(0x0000ff0fu, registers_->writes[2].value);
+  // nothing to drive low means no clear write
+  bank.write(0x3, 0x3);
+  ASSERT_EQ(4u, registers_->writes.size());
+}
+
+TEST_F(GpioBankTest, unmappedBankIsIgnored)
+{
+  utils::io::GpioBank bank(utils::io::Gpio::kBankNum, registers_);
+  ASSERT_FALSE(bank.isMapped());
+  bank.set(1);
+  bank.clear(1);
+  ASSERT_EQ(0u, bank.read());
+  ASSERT_TRUE(registers_->writes.empty());
+}
+
+}  // namespace hyped::testing
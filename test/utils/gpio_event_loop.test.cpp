@@ -0,0 +1,182 @@
+#include "fake_file_system.hpp"
+#include "test.hpp"
+
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <utils/io/gpio_event_loop.hpp>
+
+namespace hyped::testing {
+
+class GpioEventLoopTest : public Test {
+ protected:
+  void SetUp() override
+  {
+    Test::SetUp();
+    ASSERT_FALSE(file_system_.getRoot().empty());
+  }
+
+  void TearDown() override
+  {
+    for (const int fd : writers_) {
+      close(fd);
+    }
+  }
+
+  /**
+   * @brief Exports a fake sysfs pin. Its value file is a FIFO, as unlike a regular file that can
+   *        join an epoll set, but it never signals an edge.
+   */
+  void exportPin(const uint32_t pin)
+  {
+    const std::string directory = "sys/class/gpio/gpio" + std::to_string(pin) + "/";
+    EXPECT_TRUE(file_system_.write(directory + "edge", "none\n"));
+    EXPECT_EQ(0, mkfifo(file_system_.getPath(directory + "value").c_str(), 0600));
+  }
+
+  /**
+   * @brief Creates a pipe carrying one value per edge, returning its read end.
+   */
+  int makeValueStream(int &writer)
+  {
+    int fds[2];
+    EXPECT_EQ(0, pipe(fds));
+    writers_.push_back(fds[1]);
+    writer = fds[1];
+    return fds[0];
+  }
+
+  static void writeLineEvent(const int fd, const uint64_t timestamp, const uint32_t id)
+  {
+    gpioevent_data event = {};
+    event.timestamp      = timestamp;
+    event.id             = id;
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(event)), write(fd, &event, sizeof(event)));
+  }
+
+  FakeFileSystem file_system_;
+  std::vector<int> writers_;
+};
+
+TEST_F(GpioEventLoopTest, enablesBothEdgesOfSysfsPins)
+{
+  utils::io::GpioEventLoop loop(file_system_.getRoot());
+  ASSERT_TRUE(loop.isOpen());
+  const std::vector<uint32_t> pins = {26, 44, 68, 115};
+  const auto ignore                = [](const utils::io::GpioEventLoop::Event &) {};
+  for (const uint32_t pin : pins) {
+    exportPin(pin);
+    ASSERT_TRUE(loop.addPin(pin, ignore));
+    ASSERT_EQ("both", file_system_.read("sys/class/gpio/gpio" + std::to_string(pin) + "/edge"));
+  }
+  ASSERT_EQ(pins.size(), loop.getNumSources());
+  ASSERT_EQ(0, loop.poll(0));
+}
+
+TEST_F(GpioEventLoopTest, rejectsUnexportedAndDuplicatePins)
+{
+  utils::io::GpioEventLoop loop(file_system_.getRoot());
+  const auto ignore = [](const utils::io::GpioEventLoop::Event &) {};
+  ASSERT_FALSE(loop.addPin(10, ignore));
+  exportPin(10);
+  ASSERT_TRUE(loop.addPin(10, ignore));
+  ASSERT_FALSE(loop.addPin(10, ignore));
+  int writer;
+  ASSERT_FALSE(loop.addValueStreamFd(makeValueStream(writer), 10, ignore));
+  ASSERT_EQ(1u, loop.getNumSources());
+}
+
+TEST_F(GpioEventLoopTest, dispatchesValueStreamEdgesOfManyPins)
+{
+  utils::io::GpioEventLoop loop(file_system_.getRoot());
+  const std::vector<uint32_t> pins = {26, 44, 68, 115};
+  std::vector<int> writers(pins.size());
+  std::vector<utils::io::GpioEventLoop::Event> events;
+  for (std::size_t i = 0; i < pins.size(); ++i) {
+    ASSERT_TRUE(loop.addValueStreamFd(
+      makeValueStream(writers[i]), pins[i],
+      [&events](const utils::io::GpioEventLoop::Event &event) { events.push_back(event); }));
+  }
+  ASSERT_EQ(0, loop.poll(0));
+
+  ASSERT_EQ(1, write(writers[1], "1", 1));
+  ASSERT_EQ(2, write(writers[3], "01", 2));
+  // unlike sysfs, successive edges do not collapse
+  ASSERT_EQ(3, loop.poll(100));
+  ASSERT_EQ(3u, events.size());
+  std::vector<uint8_t> values_of_last_pin;
+  for (const auto &event : events) {
+    if (event.pin == pins[1]) {
+      ASSERT_EQ(1, event.value);
+    } else {
+      ASSERT_EQ(pins[3], event.pin);
+      values_of_last_pin.push_back(event.value);
+    }
+    ASSERT_GT(event.timestamp_nanos, 0u);
+  }
+  ASSERT_EQ(std::vector<uint8_t>({0, 1}), values_of_last_pin);
+  ASSERT_EQ(0, loop.poll(0));
+}
+
+TEST_F(GpioEventLoopTest, dispatchesBatchedLineEventsWithKernelTimestamps)
+{
+  utils::io::GpioEventLoop loop(file_system_.getRoot());
+  int line_fds[2];
+  ASSERT_EQ(0, pipe(line_fds));
+  writers_.push_back(line_fds[1]);
+  std::vector<utils::io::GpioEventLoop::Event> events;
+  ASSERT_TRUE(loop.addLineEventFd(
+    line_fds[0], 1, 12,
+    [&events](const utils::io::GpioEventLoop::Event &event) { events.push_back(event); }));
+
+  writeLineEvent(line_fds[1], 1000, GPIOEVENT_EVENT_RISING_EDGE);
+  writeLineEvent(line_fds[1], 2000, GPIOEVENT_EVENT_FALLING_EDGE);
+  writeLineEvent(line_fds[1], 3000, GPIOEVENT_EVENT_RISING_EDGE);
+  // all three edges queued by the kernel arrive with one read
+  ASSERT_EQ(3, loop.poll(100));
+  ASSERT_EQ(3u, events.size());
+  const std::vector<uint8_t> expected_values = {1, 0, 1};
+  for (size_t i = 0; i < events.size(); ++i) {
+    ASSERT_EQ(44u, events[i].pin);
+    ASSERT_EQ(expected_values[i], events[i].value);
+    ASSERT_EQ(1000 * (i + 1), events[i].timestamp_nanos);
+  }
+}
+
+TEST_F(GpioEventLoopTest, removedPinsAreNoLongerDispatched)
+{
+  utils::io::GpioEventLoop loop(file_system_.getRoot());
+  int line_fds[2];
+  ASSERT_EQ(0, pipe(line_fds));
+  writers_.push_back(line_fds[1]);
+  size_t num_events = 0;
+  ASSERT_TRUE(loop.addLineEventFd(line_fds[0], 0, 3,
+                                  [&](const utils::io::GpioEventLoop::Event &) { ++num_events; }));
+  ASSERT_TRUE(loop.remove(3));
+  ASSERT_FALSE(loop.remove(3));
+  ASSERT_EQ(0u, loop.getNumSources());
+  // the read end has been closed with the source
+  ASSERT_EQ(-1, fcntl(line_fds[0], F_GETFD));
+  ASSERT_EQ(0, loop.poll(0));
+  ASSERT_EQ(0u, num_events);
+}
+
+TEST_F(GpioEventLoopTest, lineOfMissingChipIsRejected)
+{
+  utils::io::GpioEventLoop loop(file_system_.getRoot());
+  const auto ignore = [](const utils::io::GpioEventLoop::Event &) {};
+  ASSERT_FALSE(loop.addLine(0, 5, ignore));
+  // a regular file does not answer the line event request
+  ASSERT_TRUE(file_system_.write("dev/gpiochip0", ""));
+  ASSERT_FALSE(loop.addLine(0, 5, ignore));
+  ASSERT_EQ(0u, loop.getNumSources());
+}
+
+}  // namespace hyped::testing
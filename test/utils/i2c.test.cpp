@@ -0,0 +1,184 @@
+#include "test.hpp"
+
+#include <array>
+#include <map>
+#include <memory>
+#include <numeric>
+
+#include <gtest/gtest.h>
+
+#include <utils/io/i2c.hpp>
+
+namespace hyped::testing {
+
+/**
+ * Userspace stand-in for an i2c-dev bus with register-based devices attached. As on typical
+ * sensors, the first byte written to a device sets its register pointer, and every byte read or
+ * written after that advances it. Counts the operations, each of which would be one system call.
+ */
+class FakeI2cBus : public utils::io::i2c::IBus {
+ public:
+  struct Device {
+    std::array<uint8_t, 256> registers = {};
+    uint8_t pointer                    = 0;
+  };
+
+  bool isOpen() const override { return true; }
+
+  bool setAddress(const uint16_t address) override
+  {
+    ++num_set_address;
+    if (reject_addresses) { return false; }
+    selected_ = address;
+    return true;
+  }
+
+  int read(uint8_t *data, const std::size_t len) override
+  {
+    ++num_reads;
+    return readFrom(selected_, data, len) ? static_cast<int>(len) : -1;
+  }
+
+  int write(const uint8_t *data, const std::size_t len) override
+  {
+    ++num_writes;
+    return writeTo(selected_, data, len) ? static_cast<int>(len) : -1;
+  }
+
+  bool transfer(utils::io::i2c::Message *messages, const std::size_t num_messages) override
+  {
+    ++num_transfers;
+    for (std::size_t i = 0; i < num_messages; ++i) {
+      const auto &message = messages[i];
+      const bool success  = message.is_read ? readFrom(message.address, message.data, message.len)
+                                            : writeTo(message.address, message.data, message.len);
+      if (!success) { return false; }
+    }
+    return true;
+  }
+
+  std::map<uint16_t, Device> devices;
+  bool reject_addresses  = false;
+  size_t num_set_address = 0;
+  size_t num_reads       = 0;
+  size_t num_writes      = 0;
+  size_t num_transfers   = 0;
+
+ private:
+  bool readFrom(const uint16_t address, uint8_t *data, const std::size_t len)
+  {
+    const auto device = devices.find(address);
+    if (device == devices.end()) { return false; }
+    for (std::size_t i = 0; i < len; ++i) {
+      data[i] = device->second.registers[device->second.pointer++];
+    }
+    return true;
+  }
+
+  bool writeTo(const uint16_t address, const uint8_t *data, const std::size_t len)
+  {
+    const auto device = devices.find(address);
+    if (device == devices.end() || len == 0) { return false; }
+    device->second.pointer = data[0];
+    for (std::size_t i = 1; i < len; ++i) {
+      device->second.registers[device->second.pointer++] = data[i];
+    }
+    return true;
+  }
+
+  uint16_t selected_ = 0;
+};
+
+class I2cTest : public Test {
+ protected:
+  static constexpr uint16_t kFirstAddress  = 0x76;
+  static constexpr uint16_t kSecondAddress = 0x77;
+
+  void SetUp() override
+  {
+    Test::SetUp();
+    auto bus = std::make_unique<FakeI2cBus>();
+    bus_     = bus.get();
+    bus_->devices[kFirstAddress];
+    bus_->devices[kSecondAddress];
+    std::iota(bus_->devices[kFirstAddress].registers.begin(),
+              bus_->devices[kFirstAddress].registers.end(), 0);
+    i2c_ = std::make_unique<utils::io::I2c>(std::move(bus));
+  }
+
+  FakeI2cBus *bus_;
+  std::unique_ptr<utils::io::I2c> i2c_;
+};
+
+TEST_F(I2cTest, readsRegisterBurstInOneTransaction)
+{
+  std::array<uint8_t, 24> data;
+  ASSERT_TRUE(i2c_->readRegisters(kFirstAddress, 0x88, data.data(), data.size()));
+  for (size_t i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(0x88 + i, data[i]);
+  }
+  ASSERT_EQ(1u, bus_->num_transfers);
+  // combined messages carry their address, so no device is selected
+  ASSERT_EQ(0u, bus_->num_set_address);
+  ASSERT_EQ(0u, bus_->num_reads + bus_->num_writes);
+}
+
+TEST_F(I2cTest, writesRegisterBurstInOneMessage)
+{
+  const std::array<uint8_t, 3> values = {0xaa, 0xbb, 0xcc};
+  ASSERT_TRUE(i2c_->writeRegisters(kSecondAddress, 0xf4, values.data(), values.size()));
+  ASSERT_EQ(1u, bus_->num_transfers);
+  const auto &registers = bus_->devices[kSecondAddress].registers;
+  ASSERT_EQ(0xaa, registers[0xf4]);
+  ASSERT_EQ(0xbb, registers[0xf5]);
+  ASSERT_EQ(0xcc, registers[0xf6]);
+  std::array<uint8_t, 3> read_back;
+  ASSERT_TRUE(i2c_->readRegisters(kSecondAddress, 0xf4, read_back.data(), read_back.size()));
+  ASSERT_EQ(values, read_back);
+}
+
+TEST_F(I2cTest, cachesSelectedAddress)
+{
+  uint8_t reg = 0x10;
+  uint8_t value;
+  for (size_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(1, i2c_->writeData(kFirstAddress, &reg, 1));
+    ASSERT_EQ(1, i2c_->readData(kFirstAddress, &value, 1));
+    ASSERT_EQ(0x10, value);
+  }
+  ASSERT_EQ(1u, bus_->num_set_address);
+  ASSERT_EQ(1, i2c_->readData(kSecondAddress, &value, 1));
+  ASSERT_EQ(1, i2c_->readData(kFirstAddress, &value, 1));
+  ASSERT_EQ(3u, bus_->num_set_address);
+  // register bursts do not disturb the selection
+  ASSERT_TRUE(i2c_->readRegisters(kSecondAddress, 0, &value, 1));
+  ASSERT_EQ(1, i2c_->readData(kFirstAddress, &value, 1));
+  ASSERT_EQ(3u, bus_->num_set_address);
+}
+
+TEST_F(I2cTest, failedSelectionIsNotCached)
+{
+  uint8_t value;
+  bus_->reject_addresses = true;
+  ASSERT_EQ(-1, i2c_->readData(kFirstAddress, &value, 1));
+  ASSERT_EQ(0u, bus_->num_reads);
+  bus_->reject_addresses = false;
+  ASSERT_EQ(1, i2c_->readData(kFirstAddress, &value, 1));
+  ASSERT_EQ(2u, bus_->num_set_address);
+}
+
+TEST_F(I2cTest, rejectsInvalidTransactions)
+{
+  uint8_t value;
+  // no device answers at this address
+  ASSERT_FALSE(i2c_->readRegisters(0x10, 0, &value, 1));
+  ASSERT_FALSE(i2c_->readRegisters(kFirstAddress, 0, &value, 0));
+  std::array<uint8_t, utils::io::I2c::kMaxWriteLength + 1> values = {};
+  ASSERT_FALSE(i2c_->writeRegisters(kFirstAddress, 0, values.data(), values.size()));
+  std::array<utils::io::i2c::Message, utils::io::I2c::kMaxMessages + 1> messages;
+  messages.fill({kFirstAddress, true, &value, 1});
+  ASSERT_FALSE(i2c_->transfer(messages.data(), messages.size()));
+  ASSERT_TRUE(i2c_->transfer(messages.data(), utils::io::I2c::kMaxMessages));
+}
+
+}  // namespace hyped::testing
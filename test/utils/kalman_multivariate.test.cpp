@@ -8,7 +8,7 @@
 #include <utils/math/kalman_multivariate.hpp>
 #include <utils/system.hpp>
 
-using hyped::utils::math::KalmanMultivariate;
+using KalmanMultivariate = hyped::utils::math::KalmanMultivariate<>;
 
 // -------------------------------------------------------------------------------------------------
 // Functionality
@@ -462,3 +462,87 @@ TEST_F(KalmanExceptions, handlesDimensionalityIssues)
   B = Eigen::MatrixXf::Random(k, m);
   EXPECT_THROW(kalman.setModels(A, B, Q, H, R), std::invalid_argument) << exception_err;
 }
+
+// -------------------------------------------------------------------------------------------------
+// Fixed Dimensions
+// -------------------------------------------------------------------------------------------------
+
+/**
+ * Class used for comparing filters with fixed dimensions against the runtime-sized filter on the
+ * same random models and measurements.
+ */
+class KalmanFixedDimensions : public ::testing::Test {
+ protected:
+  static constexpr size_t kNumTestData = 50;
+  std::string scalar_err               = "Scalar filter should reproduce the matrix filter exactly";
+  std::string fixed_err                = "Fixed-size filter should match the runtime-sized filter";
+
+  template<int N, int M>
+  static void setRandomModels(KalmanMultivariate &dynamic_kalman,
+                              hyped::utils::math::KalmanMultivariate<N, M> &fixed_kalman)
+  {
+    using Fixed       = hyped::utils::math::KalmanMultivariate<N, M>;
+    Eigen::MatrixXf A = Eigen::MatrixXf::Random(N, N);
+    Eigen::MatrixXf Q = Eigen::MatrixXf::Random(N, N).cwiseAbs();
+    Eigen::MatrixXf H = Eigen::MatrixXf::Random(M, N);
+    Eigen::MatrixXf R = Eigen::MatrixXf::Identity(M, M) + Eigen::MatrixXf::Random(M, M).cwiseAbs();
+    Eigen::VectorXf x = Eigen::VectorXf::Random(N);
+    Eigen::MatrixXf P = Eigen::MatrixXf::Random(N, N).cwiseAbs();
+    dynamic_kalman.setModels(A, Q, H, R);
+    dynamic_kalman.setInitial(x, P);
+    fixed_kalman.setModels(typename Fixed::StateMatrix(A), typename Fixed::StateMatrix(Q),
+                           typename Fixed::MeasurementMatrix(H),
+                           typename Fixed::MeasurementCovarianceMatrix(R));
+    fixed_kalman.setInitial(typename Fixed::StateVector(x), typename Fixed::StateMatrix(P));
+  }
+};
+
+/**
+ * The n = m = 1 filter works on scalars rather than matrices but has to give bit-for-bit the same
+ * results so that navigation output does not change.
+ */
+TEST_F(KalmanFixedDimensions, scalarMatchesDynamicExactly)
+{
+  for (size_t i = 0; i < kNumTestData; ++i) {
+    KalmanMultivariate dynamic_kalman = KalmanMultivariate(1, 1);
+    hyped::utils::math::KalmanMultivariate<1, 1> scalar_kalman;
+    setRandomModels(dynamic_kalman, scalar_kalman);
+    for (size_t j = 0; j < kNumTestData; ++j) {
+      Eigen::VectorXf z = Eigen::VectorXf::Random(1);
+      dynamic_kalman.filter(z);
+      scalar_kalman.filter(Eigen::Matrix<float, 1, 1>(z));
+      ASSERT_EQ(dynamic_kalman.getStateEstimate()(0), scalar_kalman.getStateEstimate()(0))
+        << scalar_err;
+      ASSERT_EQ(dynamic_kalman.getStateCovariance()(0), scalar_kalman.getStateCovariance()(0))
+        << scalar_err;
+    }
+  }
+}
+
+TEST_F(KalmanFixedDimensions, fixedMatchesDynamic)
+{
+  for (size_t i = 0; i < kNumTestData; ++i) {
+    KalmanMultivariate dynamic_kalman = KalmanMultivariate(3, 2);
+    hyped::utils::math::KalmanMultivariate<3, 2> fixed_kalman;
+    setRandomModels(dynamic_kalman, fixed_kalman);
+    for (size_t j = 0; j < 5; ++j) {
+      Eigen::VectorXf z = Eigen::VectorXf::Random(2);
+      dynamic_kalman.filter(z);
+      fixed_kalman.filter(Eigen::Vector2f(z));
+      ASSERT_TRUE(dynamic_kalman.getStateEstimate().isApprox(fixed_kalman.getStateEstimate(), 1e-3))
+        << fixed_err;
+      ASSERT_TRUE(
+        dynamic_kalman.getStateCovariance().isApprox(fixed_kalman.getStateCovariance(), 1e-3))
+        << fixed_err;
+    }
+  }
+}
+
+TEST_F(KalmanFixedDimensions, handlesWrongRuntimeDimensions)
+{
+  using Fixed = hyped::utils::math::KalmanMultivariate<3, 1>;
+  EXPECT_NO_THROW(Fixed(3, 1));
+  EXPECT_THROW(Fixed(2, 1), std::invalid_argument);
+  EXPECT_THROW(Fixed(3, 2), std::invalid_argument);
+  EXPECT_THROW(Fixed(3, 1, 1), std::invalid_argument);
+}
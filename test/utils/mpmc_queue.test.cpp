@@ -0,0 +1,110 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <utils/concurrent/mpmc_queue.hpp>
+
+namespace hyped::testing {
+
+class MpmcQueueTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kCapacity          = 8;
+  static constexpr uint64_t kNumThreads      = 4;
+  static constexpr uint64_t kValuesPerThread = 250000;
+  using Queue                                = utils::concurrent::MpmcQueue<uint64_t, kCapacity>;
+};
+
+TEST_F(MpmcQueueTest, firstInFirstOut)
+{
+  Queue queue;
+  uint64_t value;
+  ASSERT_FALSE(queue.tryPop(value));
+  for (uint64_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(queue.tryPush(i));
+  }
+  ASSERT_EQ(3u, queue.size());
+  for (uint64_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(queue.tryPop(value));
+    ASSERT_EQ(i, value);
+  }
+  ASSERT_FALSE(queue.tryPop(value));
+  ASSERT_EQ(0u, queue.size());
+}
+
+TEST_F(MpmcQueueTest, rejectsWhenFull)
+{
+  Queue queue;
+  uint64_t value;
+  // wrap around a few times
+  for (uint64_t round = 0; round < 3; ++round) {
+    for (uint64_t i = 0; i < kCapacity; ++i) {
+      ASSERT_TRUE(queue.tryPush(round * kCapacity + i));
+    }
+    ASSERT_FALSE(queue.tryPush(0));
+    for (uint64_t i = 0; i < kCapacity; ++i) {
+      ASSERT_TRUE(queue.tryPop(value));
+      ASSERT_EQ(round * kCapacity + i, value);
+    }
+  }
+}
+
+/**
+ * With several producers and consumers every value has to be popped exactly once, and the values
+ * of each producer have to be seen in order by each consumer.
+ */
+TEST_F(MpmcQueueTest, concurrentProducersAndConsumers)
+{
+  Queue queue;
+  std::vector<std::thread> producers;
+  for (uint64_t producer = 0; producer < kNumThreads; ++producer) {
+    producers.emplace_back([&queue, producer]() {
+      for (uint64_t i = 0; i < kValuesPerThread; ++i) {
+        while (!queue.tryPush(producer * kValuesPerThread + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  std::vector<std::vector<uint8_t>> seen(kNumThreads, std::vector<uint8_t>(kValuesPerThread, 0));
+  std::atomic<uint64_t> num_popped = 0;
+  std::atomic<bool> is_ordered     = true;
+  std::vector<std::thread> consumers;
+  for (uint64_t consumer = 0; consumer < kNumThreads; ++consumer) {
+    consumers.emplace_back([&]() {
+      std::vector<int64_t> last(kNumThreads, -1);
+      uint64_t value;
+      while (num_popped < kNumThreads * kValuesPerThread) {
+        if (!queue.tryPop(value)) {
+          std::this_thread::yield();
+          continue;
+        }
+        const uint64_t producer = value / kValuesPerThread;
+        const uint64_t index    = value % kValuesPerThread;
+        if (static_cast<int64_t>(index) <= last[producer]) { is_ordered = false; }
+        last[producer] = static_cast<int64_t>(index);
+        // every value is popped at most once, so each element is written by one thread only
+        ++seen[producer][index];
+        ++num_popped;
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  for (auto &consumer : consumers) {
+    consumer.join();
+  }
+  ASSERT_TRUE(is_ordered);
+  for (const auto &values : seen) {
+    for (const uint8_t count : values) {
+      ASSERT_EQ(1u, count);
+    }
+  }
+  uint64_t value;
+  ASSERT_FALSE(queue.tryPop(value));
+}
+
+}  // namespace hyped::testing
@@ -1,8 +1,10 @@
+#include "allocations.hpp"
 #include "randomiser.hpp"
 
 #include <cmath>
 #include <math.h>
 
+#include <deque>
 #include <iostream>
 #include <numeric>
 #include <string>
@@ -295,6 +297,106 @@ TEST_F(RollingStatisticsTestFloat, testWindowsFloatRolling)
   EXPECT_LT(std_dev_prev, test_stats_float.getStdDev());
 }
 
+// -------------------------------------------------------------------------------------------------
+// Comparison against a Brute-Force Reference
+// -------------------------------------------------------------------------------------------------
+
+/**
+ * @brief class used to compare the rolling stats against recomputing them over the whole window
+ */
+class RollingStatisticsTestReference : public ::testing::Test {
+ protected:
+  static constexpr size_t kWindowSize = 100;
+  static constexpr size_t kNumValues  = 20 * kWindowSize;
+
+  /**
+   * @brief Feeds `kNumValues` values into `stats` and checks sum, mean and variance after each one
+   * against two-pass computations over the values currently in the window.
+   */
+  template<typename Stats, typename Generator>
+  static void compareWithReference(Stats &stats, Generator generate)
+  {
+    std::deque<double> window;
+    for (size_t i = 0; i < kNumValues; ++i) {
+      const auto value = generate();
+      stats.update(value);
+      window.push_back(value);
+      if (window.size() > kWindowSize) { window.pop_front(); }
+
+      const double sum  = std::accumulate(window.begin(), window.end(), 0.0);
+      const double mean = sum / window.size();
+      double squared_sum = 0;
+      for (const auto window_value : window) {
+        squared_sum += (window_value - mean) * (window_value - mean);
+      }
+      const double variance = window.size() > 1 ? squared_sum / (window.size() - 1) : 0;
+      const double tolerance = 1e-9 * (1 + std::abs(sum));
+      ASSERT_NEAR(sum, stats.getSum(), tolerance);
+      ASSERT_NEAR(mean, stats.getMean(), tolerance);
+      ASSERT_NEAR(variance, stats.getVariance(), 1e-9 * (1 + variance));
+    }
+  }
+};
+
+TEST_F(RollingStatisticsTestReference, matchesReferenceRuntimeWindow)
+{
+  RollingStatistics<double> stats(kWindowSize);
+  compareWithReference(stats, []() { return testing::Randomiser::randomInRange(-1000, 1000); });
+}
+
+TEST_F(RollingStatisticsTestReference, matchesReferenceFixedWindow)
+{
+  FixedRollingStatistics<double, kWindowSize> stats;
+  compareWithReference(stats, []() { return testing::Randomiser::randomInRange(-1000, 1000); });
+}
+
+/**
+ * @brief a large offset relative to the spread is where naive sum of squares approaches break down
+ */
+TEST_F(RollingStatisticsTestReference, matchesReferenceWithLargeOffset)
+{
+  RollingStatistics<double> stats(kWindowSize);
+  compareWithReference(stats, []() { return 1e6 + testing::Randomiser::randomInRange(-1, 1); });
+}
+
+/**
+ * @brief negative integers must not be converted to unsigned when dividing by the window size
+ */
+TEST_F(RollingStatisticsTestReference, handlesNegativeIntegers)
+{
+  FixedRollingStatistics<int, 4> stats;
+  for (const int value : {-10, -20, -30, -40, -50, -60}) {
+    stats.update(value);
+  }
+  ASSERT_EQ(-180, stats.getSum());
+  ASSERT_EQ(-45, stats.getMean());
+  ASSERT_EQ(166, stats.getVariance());
+}
+
+/**
+ * @brief an empty window would leave update nowhere to write, so it holds the latest value instead
+ */
+TEST_F(RollingStatisticsTestReference, widensEmptyWindow)
+{
+  RollingStatistics<int> stats(0);
+  ASSERT_EQ(1u, stats.getWindowSize());
+  for (const int value : {3, 5, 7}) {
+    stats.update(value);
+    ASSERT_EQ(value, stats.getSum());
+    ASSERT_EQ(value, stats.getMean());
+  }
+}
+
+TEST_F(RollingStatisticsTestReference, updateDoesNotAllocate)
+{
+  RollingStatistics<float> stats(kWindowSize);
+  const uint64_t num_allocations_before = testing::getNumAllocations();
+  for (size_t i = 0; i < kNumValues; ++i) {
+    stats.update(static_cast<float>(i % 17));
+  }
+  ASSERT_EQ(num_allocations_before, testing::getNumAllocations());
+}
+
 }  // namespace math
 }  // namespace utils
 }  // namespace hyped
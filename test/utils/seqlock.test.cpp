@@ -0,0 +1,83 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <utils/concurrent/seqlock.hpp>
+
+namespace hyped::testing {
+
+/**
+ * @brief Every field always holds the same value, so a reader observing two different values has
+ *        seen a torn write.
+ */
+struct Uniform {
+  static constexpr size_t kNumFields = 64;
+  uint64_t fields[kNumFields];
+};
+
+class SeqLockTest : public ::testing::Test {
+ protected:
+  static constexpr uint64_t kNumWrites = 100000;
+  static constexpr size_t kNumReaders  = 3;
+};
+
+TEST_F(SeqLockTest, storesAndLoads)
+{
+  utils::concurrent::SeqLock<Uniform> seqlock;
+  Uniform value;
+  for (auto &field : value.fields) {
+    field = 42;
+  }
+  seqlock.store(value);
+  const auto loaded = seqlock.load();
+  for (const auto field : loaded.fields) {
+    ASSERT_EQ(42u, field);
+  }
+}
+
+TEST_F(SeqLockTest, partialReadsAndWrites)
+{
+  utils::concurrent::SeqLock<Uniform> seqlock;
+  seqlock.write([](Uniform &uniform) { uniform.fields[3] = 7; });
+  ASSERT_EQ(7u, seqlock.read([](const Uniform &uniform) { return uniform.fields[3]; }));
+}
+
+TEST_F(SeqLockTest, readsAreNeverTorn)
+{
+  static_assert(utils::concurrent::SeqLock<Uniform>::kHasOptimisticReads);
+  utils::concurrent::SeqLock<Uniform> seqlock;
+  seqlock.store(Uniform{});
+  std::atomic<bool> writing  = true;
+  std::atomic<uint64_t> torn = 0;
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < kNumReaders; ++i) {
+    readers.emplace_back([&]() {
+      while (writing) {
+        const auto uniform = seqlock.load();
+        for (const auto field : uniform.fields) {
+          if (field != uniform.fields[0]) {
+            ++torn;
+            break;
+          }
+        }
+      }
+    });
+  }
+  for (uint64_t i = 1; i <= kNumWrites; ++i) {
+    seqlock.write([i](Uniform &uniform) {
+      for (auto &field : uniform.fields) {
+        field = i;
+      }
+    });
+  }
+  writing = false;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(0u, torn);
+  ASSERT_EQ(kNumWrites, seqlock.load().fields[Uniform::kNumFields - 1]);
+}
+
+}  // namespace hyped::testing
@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+#include <utils/math/sorting_network.hpp>
+
+namespace hyped::testing {
+
+// the network is usable in constant expressions
+static_assert(utils::math::sorted(std::array<int, 4>{3, 1, 4, 2})
+              == std::array<int, 4>{1, 2, 3, 4});
+static_assert(utils::math::sorted(std::array<int, 5>{5, 3, 1, 4, 2})
+              == std::array<int, 5>{1, 2, 3, 4, 5});
+
+/**
+ * Sorting every permutation of N elements with duplicates covers all paths through a network.
+ */
+template<std::size_t N>
+void checkAllPermutations(std::array<int, N> values)
+{
+  std::sort(values.begin(), values.end());
+  const std::array<int, N> expected = values;
+  do {
+    ASSERT_EQ(expected, utils::math::sorted(values));
+  } while (std::next_permutation(values.begin(), values.end()));
+}
+
+TEST(SortingNetworkTest, sortsAllPermutations)
+{
+  checkAllPermutations(std::array<int, 1>{1});
+  checkAllPermutations(std::array<int, 2>{2, 1});
+  checkAllPermutations(std::array<int, 3>{3, 1, 2});
+  checkAllPermutations(std::array<int, 4>{4, 1, 3, 2});
+  checkAllPermutations(std::array<int, 4>{2, 1, 2, 1});
+  checkAllPermutations(std::array<int, 5>{5, 4, 1, 3, 2});
+  checkAllPermutations(std::array<int, 6>{6, 1, 5, 2, 4, 3});
+  checkAllPermutations(std::array<int, 7>{1, 7, 2, 6, 3, 5, 4});
+}
+
+TEST(SortingNetworkTest, matchesSortOnRandomFloats)
+{
+  for (std::size_t i = 0; i < 1000; ++i) {
+    std::array<float, 4> values;
+    for (auto &value : values) {
+      value = static_cast<float>(rand() % 2000) / 100 - 10;
+    }
+    std::array<float, 4> expected = values;
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, utils::math::sorted(values));
+  }
+}
+
+}  // namespace hyped::testing
@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <utils/concurrent/spsc_ring.hpp>
+
+namespace hyped::testing {
+
+class SpscRingTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kCapacity    = 8;
+  static constexpr uint64_t kNumValues = 1000000;
+  using Ring                           = utils::concurrent::SpscRing<uint64_t, kCapacity>;
+};
+
+TEST_F(SpscRingTest, firstInFirstOut)
+{
+  Ring ring;
+  ASSERT_EQ(nullptr, ring.front());
+  for (uint64_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(ring.tryPush(i));
+  }
+  ASSERT_EQ(3u, ring.size());
+  for (uint64_t i = 0; i < 3; ++i) {
+    ASSERT_NE(nullptr, ring.front());
+    ASSERT_EQ(i, *ring.front());
+    ring.pop();
+  }
+  ASSERT_EQ(nullptr, ring.front());
+}
+
+TEST_F(SpscRingTest, rejectsWhenFull)
+{
+  Ring ring;
+  // wrap around a few times
+  for (uint64_t round = 0; round < 3; ++round) {
+    for (uint64_t i = 0; i < kCapacity; ++i) {
+      ASSERT_TRUE(ring.tryPush(round * kCapacity + i));
+    }
+    ASSERT_FALSE(ring.tryPush(0));
+    ASSERT_EQ(nullptr, ring.tryReserve());
+    for (uint64_t i = 0; i < kCapacity; ++i) {
+      ASSERT_EQ(round * kCapacity + i, *ring.front());
+      ring.pop();
+    }
+  }
+}
+
+/**
+ * A consumer on another thread has to see every value exactly once and in order.
+ */
+TEST_F(SpscRingTest, concurrentProducerAndConsumer)
+{
+  Ring ring;
+  std::thread producer([&ring]() {
+    for (uint64_t i = 0; i < kNumValues; ++i) {
+      while (!ring.tryPush(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  uint64_t expected = 0;
+  while (expected < kNumValues) {
+    const uint64_t *value = ring.front();
+    if (value == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(expected, *value);
+    ring.pop();
+    ++expected;
+  }
+  producer.join();
+  ASSERT_EQ(nullptr, ring.front());
+}
+
+}  // namespace hyped::testing
@@ -0,0 +1,209 @@
+#include "test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <utils/io/can.hpp>
+#include <utils/io/virtual_can_bus.hpp>
+
+namespace hyped::testing {
+
+class VirtualCanBusTest : public Test {
+ protected:
+  using Frame = utils::io::can::Frame;
+
+  /**
+   * @brief Answers every frame it receives with a frame of the id 0x80 below, like a CANopen
+   *        server answering an SDO request.
+   */
+  class Responder : public utils::io::ICanProcessor {
+   public:
+    explicit Responder(utils::io::Can &can) : can_(can) {}
+
+    void processNewData(Frame &message) override
+    {
+      Frame response = message;
+      response.id -= 0x80;
+      can_.send(response);
+    }
+
+   private:
+    utils::io::Can &can_;
+  };
+
+  class CountingProcessor : public utils::io::ICanProcessor {
+   public:
+    void processNewData(Frame &) override { ++num_frames; }
+    std::atomic<std::size_t> num_frames = 0;
+  };
+
+  static Frame makeFrame(const uint32_t id, const uint8_t value = 0)
+  {
+    Frame frame;
+    frame.id       = id;
+    frame.extended = false;
+    frame.len      = 1;
+    frame.data[0]  = value;
+    return frame;
+  }
+
+  template<typename Condition>
+  static bool waitFor(Condition condition)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!condition()) {
+      if (std::chrono::steady_clock::now() > deadline) { return false; }
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return true;
+  }
+
+  utils::io::can::VirtualBus bus_;
+};
+
+TEST_F(VirtualCanBusTest, broadcastsToOtherNodes)
+{
+  auto first  = bus_.attach();
+  auto second = bus_.attach();
+  auto third  = bus_.attach();
+  ASSERT_EQ(bus_.getNumNodes(), 3u);
+  const Frame frames[2] = {makeFrame(0x601, 1), makeFrame(0x602, 2)};
+  ASSERT_EQ(first->send(frames, 2), 2u);
+  for (auto *node : {second.get(), third.get()}) {
+    Frame received[4];
+    ASSERT_EQ(node->receive(received, 4, 0), 2u);
+    ASSERT_EQ(received[0].id, 0x601u);
+    ASSERT_EQ(received[0].data[0], 1);
+    ASSERT_EQ(received[1].id, 0x602u);
+    ASSERT_EQ(node->receive(received, 4, 0), 0u);
+  }
+  Frame received;
+  // a node does not receive its own frames
+  ASSERT_EQ(first->receive(&received, 1, 1000), 0u);
+  third.reset();
+  ASSERT_EQ(bus_.getNumNodes(), 2u);
+}
+
+TEST_F(VirtualCanBusTest, filtersFrames)
+{
+  auto sender   = bus_.attach();
+  auto receiver = bus_.attach();
+  receiver->setFilters({{0x580, 0x58F, false}, {300, 304, true}});
+  Frame frames[4] = {makeFrame(0x581), makeFrame(0x601), makeFrame(300), makeFrame(0x582)};
+  frames[2].extended = true;
+  sender->send(frames, 4);
+  Frame received[4];
+  ASSERT_EQ(receiver->receive(received, 4, 0), 3u);
+  ASSERT_EQ(received[0].id, 0x581u);
+  ASSERT_EQ(received[1].id, 300u);
+  ASSERT_EQ(received[2].id, 0x582u);
+  // no filters at all receive nothing
+  receiver->setFilters({});
+  sender->send(frames, 4);
+  ASSERT_EQ(receiver->receive(received, 4, 0), 0u);
+  ASSERT_EQ(bus_.getNumDropped(), 0u);
+}
+
+TEST_F(VirtualCanBusTest, dropsFramesOfSlowNodes)
+{
+  auto sender   = bus_.attach();
+  auto receiver = bus_.attach();
+  constexpr std::size_t kNumExtraFrames = 10;
+  for (std::size_t i = 0; i < bus_.kQueueCapacity + kNumExtraFrames; ++i) {
+    const Frame frame = makeFrame(0x123, static_cast<uint8_t>(i));
+    sender->send(&frame, 1);
+  }
+  ASSERT_EQ(bus_.getNumDropped(), kNumExtraFrames);
+  std::vector<Frame> received(bus_.kQueueCapacity);
+  std::size_t num_received = 0;
+  while (num_received < bus_.kQueueCapacity) {
+    const std::size_t num_batch
+      = receiver->receive(&received[num_received], bus_.kQueueCapacity - num_received, 0);
+    ASSERT_GT(num_batch, 0u);
+    num_received += num_batch;
+  }
+  // the oldest frames are kept
+  for (std::size_t i = 0; i < num_received; ++i) {
+    ASSERT_EQ(received[i].data[0], static_cast<uint8_t>(i));
+  }
+}
+
+/**
+ * Every frame of several concurrent senders has to arrive, in the order in which each sender sent
+ * them, unless it was counted as dropped.
+ */
+TEST_F(VirtualCanBusTest, concurrentSenders)
+{
+  constexpr std::size_t kNumSenders      = 4;
+  constexpr std::size_t kFramesPerSender = 20000;
+  auto receiver                          = bus_.attach();
+  std::vector<std::unique_ptr<utils::io::can::IBus>> senders;
+  for (std::size_t i = 0; i < kNumSenders; ++i) {
+    senders.push_back(bus_.attach());
+  }
+  std::vector<std::thread> threads;
+  std::atomic<std::size_t> num_finished = 0;
+  for (std::size_t i = 0; i < kNumSenders; ++i) {
+    threads.emplace_back([&senders, &num_finished, i]() {
+      for (std::size_t j = 0; j < kFramesPerSender; ++j) {
+        Frame frame = makeFrame(i);
+        frame.len   = 4;
+        std::memcpy(frame.data, &j, 4);
+        senders[i]->send(&frame, 1);
+      }
+      ++num_finished;
+    });
+  }
+  std::vector<int64_t> last(kNumSenders, -1);
+  std::size_t num_received = 0;
+  Frame frames[16];
+  while (true) {
+    const bool is_finished      = num_finished == kNumSenders;
+    const std::size_t num_batch = receiver->receive(frames, 16, 1000);
+    for (std::size_t i = 0; i < num_batch; ++i) {
+      uint32_t index;
+      std::memcpy(&index, frames[i].data, 4);
+      ASSERT_GT(static_cast<int64_t>(index), last[frames[i].id]);
+      last[frames[i].id] = index;
+    }
+    num_received += num_batch;
+    if (is_finished && num_batch == 0) { break; }
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  // the senders are nodes too, nobody drains them so they keep only the first frames of the others
+  const std::size_t num_dropped_by_senders
+    = kNumSenders * ((kNumSenders - 1) * kFramesPerSender - bus_.kQueueCapacity);
+  ASSERT_EQ(num_received + bus_.getNumDropped() - num_dropped_by_senders,
+            kNumSenders * kFramesPerSender);
+}
+
+TEST_F(VirtualCanBusTest, connectsCanInstances)
+{
+  utils::io::Can pod(bus_.attach());
+  utils::io::Can controller(bus_.attach());
+  Responder responder(controller);
+  CountingProcessor responses;
+  controller.registerProcessor(&responder, {0x601, 0x604, false});
+  pod.registerProcessor(&responses, {0x581, 0x584, false});
+  controller.start();
+  pod.start();
+
+  constexpr std::size_t kNumRequests = 1000;
+  std::vector<Frame> requests;
+  for (std::size_t i = 0; i < kNumRequests; ++i) {
+    requests.push_back(makeFrame(0x601 + i % 4));
+  }
+  ASSERT_EQ(pod.send(requests.data(), requests.size()), kNumRequests);
+  ASSERT_TRUE(waitFor([&]() { return responses.num_frames == kNumRequests; }));
+  ASSERT_EQ(pod.getStatistics().num_frames_received, kNumRequests);
+  ASSERT_EQ(controller.getStatistics().num_frames_sent, kNumRequests);
+}
+
+}  // namespace hyped::testing